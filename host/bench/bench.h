@@ -0,0 +1,50 @@
+/* host/bench/bench.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+
+/**
+ * @brief benchmark scene, every scene runs in a fresh process with a fresh sgl heap
+ * @name: scene name, used to select the scene from the command line
+ * @frames: number of frames to run
+ * @setup: create objects of the scene, called once after sgl_init()
+ * @step: script of the scene, called before each frame with the frame index
+ */
+typedef struct bench_scene {
+    const char *name;
+    uint32_t   frames;
+    void       (*setup)(void);
+    void       (*step)(uint32_t frame);
+} bench_scene_t;
+
+
+extern const bench_scene_t bench_scenes[];
+extern const uint32_t bench_scene_count;
+
+
+#endif // !__BENCH_H__
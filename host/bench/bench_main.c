@@ -0,0 +1,202 @@
+/* host/bench/bench_main.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_bench [-v] [-m] [-r bytes_per_sec] [-a] [scene ...]
+ *
+ * Every scene runs in its own child process, because the sgl heap and the
+ * object tree can not be initialized twice. Each frame advances the fake tick
+ * by SGL_SYSTEM_TICK_MS and then runs sgl_task_handle_sync() once.
+ *
+ * -v prints one line per frame: frame, us, slices, flushed pixels, touched pixels.
+ * "saved" is the number of pixels the dirty area planner did not flush.
+ * "passes" is the number of walks of the object tree to draw, one for every slice, a batch of
+ * small dirty areas takes one pass when CONFIG_SGL_DRAW_BATCH is more than 1, and so does a
+ * dirty area of many slices when CONFIG_SGL_DRAW_LIST_SIZE is set.
+ * The checksum of the final panel content is printed for every scene, so that a
+ * rendering change can be detected by comparing two runs.
+ *
+ * -m prints the heap trace of every scene after its last frame, when CONFIG_SGL_HEAP_TRACE is
+ * enabled, pipe it to sgl_mm_decode to read it.
+ *
+ * -r sets the byte rate of the panel transport, e.g. 4500000 for SPI at 36MHz, the default
+ * is 0 and the flush costs no time. -a makes the transport asynchronous with double buffer,
+ * like the DMA flush of the board. The frame time includes the wait for the last flush.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../port/host_port.h"
+#include "bench.h"
+
+
+static int bench_verbose = 0;
+static uint32_t bench_byte_rate = 0;
+static bool bench_async = false;
+static bool bench_heap = false;
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+static void bench_heap_print(const char *str)
+{
+    fputs(str, stdout);
+}
+#endif
+
+
+static int bench_run_scene(const bench_scene_t *scene)
+{
+    uint64_t total_us = 0, min_us = UINT64_MAX, max_us = 0;
+    int64_t saved = 0;
+
+    host_port_set_transport(bench_byte_rate, bench_async);
+    if (host_port_init() || sgl_init()) {
+        fprintf(stderr, "%s: sgl init failed\n", scene->name);
+        return -1;
+    }
+
+    sgl_set_system_font(&song23);
+    scene->setup();
+
+    /* first frame draws the whole screen, keep it out of the statistics */
+    sgl_task_handle_sync();
+    host_port_sync();
+    host_port_stats_reset();
+    uint32_t passes = sgl_draw_get_passes();
+
+    for (uint32_t i = 0; i < scene->frames; i++) {
+        host_port_stats_t before = host_port_stats_get();
+
+        host_port_tick_inc(SGL_SYSTEM_TICK_MS);
+        scene->step(i);
+
+        uint64_t t0 = host_port_time_us();
+        sgl_task_handle_sync();
+        host_port_sync();
+        uint64_t dt = host_port_time_us() - t0;
+        saved += sgl_dirty_area_get_saved();
+
+        total_us += dt;
+        min_us = dt < min_us ? dt : min_us;
+        max_us = dt > max_us ? dt : max_us;
+
+        if (bench_verbose) {
+            host_port_stats_t now = host_port_stats_get();
+            printf("  %-10s %4u %6llu us %4u slices %7llu px %7llu touched\n", scene->name, i,
+                   (unsigned long long)dt,
+                   now.flush_count - before.flush_count,
+                   (unsigned long long)(now.flush_pixels - before.flush_pixels),
+                   (unsigned long long)(now.touch_pixels - before.touch_pixels));
+        }
+    }
+
+    host_port_stats_t stats = host_port_stats_get();
+    printf("%-10s frames %4u  avg %6.1f us  min %5llu us  max %6llu us  slices %6u  passes %6u  "
+           "flushed %8llu px %9llu B  touched %8llu px  saved %7lld px  crc %08x\n",
+           scene->name, scene->frames, (double)total_us / scene->frames,
+           (unsigned long long)min_us, (unsigned long long)max_us,
+           stats.flush_count, sgl_draw_get_passes() - passes,
+           (unsigned long long)stats.flush_pixels, (unsigned long long)stats.flush_bytes,
+           (unsigned long long)stats.touch_pixels, (long long)saved,
+           host_port_panel_checksum());
+
+#if (CONFIG_SGL_HEAP_TRACE)
+    if (bench_heap) {
+        sgl_mm_trace_dump(bench_heap_print);
+    }
+#endif
+
+    return 0;
+}
+
+
+static int bench_fork_scene(const bench_scene_t *scene)
+{
+    int status;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+
+    if (pid == 0) {
+        int ret = bench_run_scene(scene);
+        fflush(stdout);
+        _exit(ret ? EXIT_FAILURE : EXIT_SUCCESS);
+    }
+
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        fprintf(stderr, "%s: scene failed\n", scene->name);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int ret = 0, selected = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            bench_verbose = 1;
+        }
+        else if (strcmp(argv[i], "-a") == 0) {
+            bench_async = true;
+        }
+        else if (strcmp(argv[i], "-m") == 0) {
+            bench_heap = true;
+        }
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            bench_byte_rate = strtoul(argv[++i], NULL, 0);
+        }
+        else {
+            selected ++;
+        }
+    }
+
+    for (uint32_t i = 0; i < bench_scene_count; i++) {
+        int run = !selected;
+
+        for (int j = 1; j < argc && !run; j++) {
+            if (strcmp(argv[j], "-r") == 0) {
+                j++;
+                continue;
+            }
+            run = strcmp(argv[j], bench_scenes[i].name) == 0;
+        }
+
+        if (run && bench_fork_scene(&bench_scenes[i])) {
+            ret = 1;
+        }
+    }
+
+    return ret;
+}
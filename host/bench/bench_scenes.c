@@ -0,0 +1,501 @@
+/* host/bench/bench_scenes.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl.h>
+#include "bench.h"
+
+
+/* the same pixmap as user/src/main.c */
+extern const unsigned char gImage_test[7080];
+static const sgl_pixmap_t test_pixmap = {
+    .width = 60,
+    .height = 59,
+    .bitmap = { .array = gImage_test },
+};
+
+
+/* demo: the falling rectangle of user/src/main.c, a new one every 20 frames */
+static void demo_anim_path(struct sgl_anim *anim, int32_t value)
+{
+    sgl_obj_set_pos_y(anim->data, value);
+}
+
+
+static void demo_anim_finish(struct sgl_anim *anim)
+{
+    sgl_obj_delete(anim->data);
+}
+
+
+static void demo_setup(void)
+{
+}
+
+
+static void demo_step(uint32_t frame)
+{
+    if (frame % 20) {
+        return;
+    }
+
+    sgl_obj_t *rect = sgl_rect_create(NULL);
+    sgl_obj_set_pos(rect, sgl_rand() % 240, 0);
+    sgl_obj_set_size(rect, 59, 59);
+    sgl_rect_set_radius(rect, 10);
+    sgl_rect_set_pixmap(rect, &test_pixmap);
+
+    sgl_anim_t *anim = sgl_anim_create();
+    sgl_anim_set_data(anim, rect);
+    sgl_anim_set_act_duration(anim, 1000);
+    sgl_anim_set_start_value(anim, 0);
+    sgl_anim_set_end_value(anim, 240);
+    sgl_anim_set_path(anim, demo_anim_path, SGL_ANIM_PATH_LINEAR);
+    sgl_anim_set_finish_cb(anim, demo_anim_finish);
+    sgl_anim_set_auto_free(anim);
+    sgl_anim_start(anim, 1);
+}
+
+
+/* keyboard: tap keys along the rows, one press and one release every 4 frames */
+static char keyboard_text[64];
+
+static void keyboard_setup(void)
+{
+    sgl_obj_t *kbd = sgl_keyboard_create(NULL);
+    sgl_obj_set_pos(kbd, 0, 100);
+    sgl_obj_set_size(kbd, 240, 140);
+    sgl_keyboard_set_textarea(kbd, keyboard_text, sizeof(keyboard_text));
+}
+
+
+static void keyboard_step(uint32_t frame)
+{
+    uint32_t key = frame / 4;
+    int16_t x = 12 + (key * 24) % 216;
+    int16_t y = 112 + ((key / 9) % 4) * 32;
+
+    switch (frame % 4) {
+    case 0: sgl_event_pos_input(x, y, true); break;
+    case 1: sgl_event_pos_input(x, y, false); break;
+    default: break;
+    }
+}
+
+
+/* scope: append one sample every frame, like a live waveform */
+static int16_t scope_data[240];
+static sgl_obj_t *scope;
+
+static void scope_setup(void)
+{
+    scope = sgl_scope_create(NULL);
+    sgl_obj_set_pos(scope, 0, 0);
+    sgl_obj_set_size(scope, 240, 160);
+    sgl_scope_set_data_buffer(scope, scope_data, SGL_ARRAY_SIZE(scope_data));
+    sgl_scope_set_range(scope, 0, 1000);
+}
+
+
+static void scope_step(uint32_t frame)
+{
+    int32_t v = 500 + sgl_sin((frame * 8) % 360) * 400 / SGL_SIN_FIXED_ONE;
+    sgl_scope_append_data(scope, (int16_t)v);
+}
+
+
+/* sweep: 1kHz ADC stream into a sweep mode scope, SGL_SYSTEM_TICK_MS samples per frame */
+static int16_t sweep_data[240];
+static sgl_obj_t *sweep;
+static uint32_t sweep_phase;
+
+static void sweep_setup(void)
+{
+    sweep = sgl_scope_create(NULL);
+    sgl_obj_set_pos(sweep, 0, 0);
+    sgl_obj_set_size(sweep, 240, 160);
+    sgl_scope_set_data_buffer(sweep, sweep_data, SGL_ARRAY_SIZE(sweep_data));
+    sgl_scope_set_range(sweep, 0, 1000);
+    sgl_scope_set_sweep_mode(sweep, true);
+}
+
+
+static void sweep_step(uint32_t frame)
+{
+    (void)frame;
+
+    for (int i = 0; i < SGL_SYSTEM_TICK_MS; i++, sweep_phase++) {
+        int32_t v = 500 + sgl_sin((sweep_phase * 5) % 360) * 400 / SGL_SIN_FIXED_ONE;
+        sgl_scope_append_data(sweep, (int16_t)v);
+    }
+}
+
+
+/* textbox: drag the text up and down */
+static const char textbox_text[] =
+    "SGL is a lightweight and fast graphics library for embedded systems. "
+    "It provides widgets, animation, fonts and a small memory manager, and "
+    "it only needs a tiny draw buffer to render a full screen. "
+    "This text is long enough to scroll several times inside the textbox, "
+    "so that every frame of the benchmark redraws wrapped lines of glyphs.";
+
+static void textbox_setup(void)
+{
+    sgl_obj_t *textbox = sgl_textbox_create(NULL);
+    sgl_obj_set_pos(textbox, 10, 10);
+    sgl_obj_set_size(textbox, 220, 220);
+    sgl_textbox_set_text(textbox, textbox_text);
+}
+
+
+static void textbox_step(uint32_t frame)
+{
+    uint32_t phase = frame % 40;
+
+    if (phase < 18) {
+        sgl_event_pos_input(120, 200 - phase * 8, true);
+    }
+    else if (phase == 18) {
+        sgl_event_pos_input(120, 60, false);
+    }
+    else if (phase >= 20 && phase < 38) {
+        sgl_event_pos_input(120, 40 + (phase - 20) * 8, true);
+    }
+    else if (phase == 38) {
+        sgl_event_pos_input(120, 180, false);
+    }
+}
+
+
+/* stack: a keyboard page covered by an opaque full screen layer, a small rect moves on the top */
+static char stack_text[16];
+static sgl_obj_t *stack_rect;
+
+static void stack_setup(void)
+{
+    sgl_obj_t *kbd = sgl_keyboard_create(NULL);
+    sgl_obj_set_pos(kbd, 0, 0);
+    sgl_obj_set_size(kbd, 240, 240);
+    sgl_keyboard_set_textarea(kbd, stack_text, sizeof(stack_text));
+
+    sgl_obj_t *cover = sgl_rect_create(NULL);
+    sgl_obj_set_pos(cover, 0, 0);
+    sgl_obj_set_size(cover, 240, 240);
+    sgl_rect_set_radius(cover, 0);
+    sgl_rect_set_alpha(cover, SGL_ALPHA_MAX);
+    sgl_rect_set_border_width(cover, 0);
+
+    stack_rect = sgl_rect_create(cover);
+    sgl_obj_set_size(stack_rect, 40, 40);
+    sgl_rect_set_color(stack_rect, sgl_rgb(255, 0, 0));
+}
+
+
+static void stack_step(uint32_t frame)
+{
+    sgl_obj_set_pos(stack_rect, (frame * 3) % 200, (frame * 7) % 200);
+}
+
+
+/* anim: short-lived delayed animations, a new one from the pool every other frame, 8 small rects
+ * slide back and forth, the values change slower than the tick so many ticks repeat the last value
+ */
+static sgl_obj_t *anim_rect[8];
+
+static void anim_slide_path(struct sgl_anim *anim, int32_t value)
+{
+    sgl_obj_set_pos_x(anim->data, value);
+}
+
+
+static void anim_setup(void)
+{
+    for (int i = 0; i < 8; i++) {
+        anim_rect[i] = sgl_rect_create(NULL);
+        sgl_obj_set_pos(anim_rect[i], 0, 10 + i * 28);
+        sgl_obj_set_size(anim_rect[i], 20, 20);
+        sgl_rect_set_radius(anim_rect[i], 4);
+    }
+}
+
+
+static void anim_step(uint32_t frame)
+{
+    if (frame % 2) {
+        return;
+    }
+
+    sgl_anim_t *anim = sgl_anim_create();
+    if (anim == NULL) {
+        return;
+    }
+
+    sgl_anim_set_data(anim, anim_rect[(frame / 2) % 8]);
+    sgl_anim_set_act_delay(anim, (frame * 37) % 300);
+    sgl_anim_set_act_duration(anim, 100 + (frame * 53) % 200);
+    sgl_anim_set_start_value(anim, (frame / 16) % 2 ? 200 : 20);
+    sgl_anim_set_end_value(anim, (frame / 16) % 2 ? 20 : 200);
+    sgl_anim_set_path(anim, anim_slide_path, SGL_ANIM_PATH_EASE_IN_OUT);
+    sgl_anim_set_auto_free(anim);
+    sgl_anim_start(anim, 1);
+}
+
+
+/* menu: the pages of a menu are built and deleted on navigation, a new page every 25 frames,
+ * the page has its own memory region when CONFIG_SGL_PAGE_REGION is enabled
+ */
+static const char *menu_items[] = { "Display", "Sound", "Network", "Storage", "About" };
+static sgl_obj_t *menu_page;
+
+static void menu_build(uint32_t index)
+{
+    sgl_obj_t *page, *obj;
+
+#if (CONFIG_SGL_PAGE_REGION)
+    /* the page takes about 1.7K on the host, two pages must fit next to the glyph cache */
+    page = sgl_page_create_with_region(1664);
+    if (page == NULL) {
+        return;
+    }
+    sgl_page_region_enter(page);
+#else
+    page = sgl_obj_create(NULL);
+    if (page == NULL) {
+        return;
+    }
+#endif
+
+    obj = sgl_label_create(page);
+    sgl_obj_set_pos(obj, 10, 4);
+    sgl_obj_set_size(obj, 220, 26);
+    sgl_label_set_text(obj, menu_items[index % SGL_ARRAY_SIZE(menu_items)]);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        obj = sgl_button_create(page);
+        sgl_obj_set_pos(obj, 10, 34 + i * 36);
+        sgl_obj_set_size(obj, 150, 30);
+        sgl_button_set_text(obj, menu_items[(index + i + 1) % SGL_ARRAY_SIZE(menu_items)]);
+
+        obj = sgl_switch_create(page);
+        sgl_obj_set_pos(obj, 170, 38 + i * 36);
+        sgl_obj_set_size(obj, 56, 22);
+        sgl_switch_set_status(obj, (index + i) % 2);
+    }
+
+    obj = sgl_dropdown_create(page);
+    sgl_obj_set_pos(obj, 10, 184);
+    sgl_obj_set_size(obj, 220, 30);
+    for (uint32_t i = 0; i < SGL_ARRAY_SIZE(menu_items); i++) {
+        sgl_dropdown_add_option(obj, menu_items[i]);
+    }
+
+#if (CONFIG_SGL_PAGE_REGION)
+    sgl_page_region_leave();
+#endif
+
+    sgl_screen_load(page);
+    if (menu_page != NULL) {
+        sgl_obj_delete(menu_page);
+    }
+    menu_page = page;
+}
+
+
+static void menu_setup(void)
+{
+    menu_page = NULL;
+    menu_build(0);
+}
+
+
+static void menu_step(uint32_t frame)
+{
+    if (frame % 25 == 24) {
+        menu_build(frame / 25 + 1);
+    }
+}
+
+
+/* leds: a status panel, 16 small leds spread over the screen blink in a pattern and two counters
+ * count up, every frame has many small dirty areas that are far from each other
+ */
+static sgl_obj_t *leds[16];
+static sgl_obj_t *leds_counter[2];
+static char leds_text[2][12];
+
+static void leds_setup(void)
+{
+    for (int i = 0; i < 16; i++) {
+        leds[i] = sgl_rect_create(NULL);
+        sgl_obj_set_pos(leds[i], 14 + (i % 4) * 60, 10 + (i / 4) * 48);
+        sgl_obj_set_size(leds[i], 12, 12);
+        sgl_rect_set_radius(leds[i], 6);
+        sgl_rect_set_color(leds[i], sgl_rgb(0, 64, 0));
+    }
+
+    for (int i = 0; i < 2; i++) {
+        leds_counter[i] = sgl_label_create(NULL);
+        sgl_obj_set_pos(leds_counter[i], 10 + i * 130, 200);
+        sgl_obj_set_size(leds_counter[i], 80, 30);
+        sgl_label_set_text(leds_counter[i], leds_text[i]);
+    }
+}
+
+
+static void leds_step(uint32_t frame)
+{
+    for (int i = 0; i < 16; i++) {
+        if ((frame + i * 7) % 5 == 0) {
+            bool on = ((frame + i * 7) / 5) % 2;
+            sgl_rect_set_color(leds[i], on ? sgl_rgb(0, 255, 0) : sgl_rgb(0, 64, 0));
+        }
+    }
+
+    sgl_snprintf(leds_text[0], sizeof(leds_text[0]), "%u", frame);
+    sgl_label_set_text(leds_counter[0], leds_text[0]);
+
+    if (frame % 4 == 0) {
+        sgl_snprintf(leds_text[1], sizeof(leds_text[1]), "%u", frame / 4);
+        sgl_label_set_text(leds_counter[1], leds_text[1]);
+    }
+}
+
+
+/* buttons: a themed panel of 12 rounded buttons with radius 8 to 20, most of them with a border
+ * and some of them translucent, every frame three of them change their color
+ */
+static sgl_obj_t *buttons[12];
+
+static void buttons_setup(void)
+{
+    for (int i = 0; i < 12; i++) {
+        buttons[i] = sgl_rect_create(NULL);
+        sgl_obj_set_pos(buttons[i], 6 + (i % 3) * 78, 8 + (i / 3) * 58);
+        sgl_obj_set_size(buttons[i], 72, 50);
+        sgl_rect_set_radius(buttons[i], 8 + (i % 4) * 4);
+        sgl_rect_set_color(buttons[i], sgl_rgb(40, 90, 200));
+        sgl_rect_set_border_width(buttons[i], i % 3);
+        sgl_rect_set_border_color(buttons[i], sgl_rgb(230, 230, 230));
+        sgl_rect_set_alpha(buttons[i], i % 4 == 3 ? 160 : SGL_ALPHA_MAX);
+    }
+}
+
+
+static void buttons_step(uint32_t frame)
+{
+    for (int i = 0; i < 3; i++) {
+        uint32_t index = (frame * 3 + i * 5) % 12;
+        sgl_rect_set_color(buttons[index], (frame / 4 + index) % 2 ? sgl_rgb(40, 90, 200) : sgl_rgb(200, 80, 40));
+    }
+}
+
+
+/* gauge: a 220 px gauge, a gray track ring with a smooth value arc over it, the value sweeps up
+ * and down, so the whole gauge is drawn again every frame
+ */
+static sgl_obj_t *gauge_arc;
+
+static void gauge_setup(void)
+{
+    sgl_obj_t *track = sgl_ring_create(NULL);
+    sgl_obj_set_pos(track, 10, 10);
+    sgl_obj_set_size(track, 220, 220);
+    sgl_ring_set_radius(track, 94, 108);
+    sgl_ring_set_color(track, sgl_rgb(60, 60, 60));
+
+    gauge_arc = sgl_arc_create(NULL);
+    sgl_obj_set_pos(gauge_arc, 10, 10);
+    sgl_obj_set_size(gauge_arc, 220, 220);
+    sgl_arc_set_radius(gauge_arc, 96, 106);
+    sgl_arc_set_mode(gauge_arc, SGL_ARC_MODE_NORMAL_SMOOTH);
+    sgl_arc_set_color(gauge_arc, sgl_rgb(0, 200, 120));
+    sgl_arc_set_start_angle(gauge_arc, 45);
+    sgl_arc_set_end_angle(gauge_arc, 46);
+}
+
+
+static void gauge_step(uint32_t frame)
+{
+    uint32_t phase = (frame * 6) % 540;
+
+    sgl_arc_set_end_angle(gauge_arc, 46 + (phase < 270 ? phase : 540 - phase));
+}
+
+
+/* chart: a radar polygon with a 3 px border whose six vertices move every frame, and two
+ * thick slanted lines that swing over it, so the line engine draws long edges every frame
+ */
+static sgl_obj_t *chart_polygon;
+static sgl_obj_t *chart_line[2];
+
+static void chart_setup(void)
+{
+    chart_polygon = sgl_polygon_create(NULL);
+    sgl_obj_set_pos(chart_polygon, 0, 0);
+    sgl_obj_set_size(chart_polygon, 240, 240);
+    sgl_polygon_set_fill_color(chart_polygon, sgl_rgb(20, 60, 110));
+    sgl_polygon_set_border_color(chart_polygon, sgl_rgb(80, 180, 255));
+    sgl_polygon_set_border_width(chart_polygon, 3);
+
+    for (int i = 0; i < 2; i++) {
+        chart_line[i] = sgl_line_create(NULL);
+        sgl_line_set_color(chart_line[i], i ? sgl_rgb(255, 160, 0) : sgl_rgb(0, 220, 120));
+        sgl_line_set_width(chart_line[i], 2);
+    }
+}
+
+
+static void chart_step(uint32_t frame)
+{
+    sgl_pos_t vertex[6];
+    int16_t swing = (int16_t)((frame * 3) % 160);
+
+    for (int i = 0; i < 6; i++) {
+        int32_t r = 50 + (int32_t)((frame * (3 + i) + i * 41) % 60);
+        vertex[i].x = (int16_t)(120 + r * sgl_cos(i * 60) / SGL_COS_FIXED_ONE);
+        vertex[i].y = (int16_t)(120 + r * sgl_sin(i * 60) / SGL_SIN_FIXED_ONE);
+    }
+
+    sgl_polygon_set_vertices(chart_polygon, vertex, SGL_ARRAY_SIZE(vertex));
+    sgl_line_set_pos(chart_line[0], 10, 40 + swing, 230, 200 - swing);
+    sgl_line_set_pos(chart_line[1], 40 + swing, 10, 200 - swing, 230);
+}
+
+
+/* listview is not part of the build (see sgl/widgets/build.cmake), so it has no scene */
+const bench_scene_t bench_scenes[] = {
+    { "demo",     300, demo_setup,     demo_step     },
+    { "keyboard", 200, keyboard_setup, keyboard_step },
+    { "scope",    300, scope_setup,    scope_step    },
+    { "sweep",    300, sweep_setup,    sweep_step    },
+    { "textbox",  200, textbox_setup,  textbox_step  },
+    { "stack",    200, stack_setup,    stack_step    },
+    { "anim",     300, anim_setup,     anim_step     },
+    { "menu",     300, menu_setup,     menu_step     },
+    { "leds",     300, leds_setup,     leds_step     },
+    { "buttons",  300, buttons_setup,  buttons_step  },
+    { "gauge",    300, gauge_setup,    gauge_step    },
+    { "chart",    300, chart_setup,    chart_step    },
+};
+
+const uint32_t bench_scene_count = SGL_ARRAY_SIZE(bench_scenes);
@@ -0,0 +1,332 @@
+/* host/bench/churn_bench.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_churn_bench_<algo> [rounds]
+ *
+ * Widget churn on the sgl heap, the same program is built once for every heap algorithm
+ * (sgl_churn_bench_lwmem, sgl_churn_bench_tlsf and sgl_churn_bench_slab) with a heap of
+ * CONFIG_SGL_HEAP_MEMORY_SIZE bytes, so the rows can be compared.
+ *
+ * Every round opens a page: it creates a random set of widgets, some of them with a text
+ * buffer of random length, and a message box that is closed in the middle of the page.
+ * Sometimes a widget of the page is kept, it lives for the next pages until it is pushed
+ * out of a small ring, so short and long lived objects are mixed like in a real UI. Then
+ * the page is closed and its objects are freed in random order.
+ *
+ * alloc/free   average and max time of one call, the cost of the clock is removed
+ * failed       allocations that returned NULL
+ * free         free bytes of the heap after the churn, from sgl_mm_get_monitor()
+ * largest      the biggest block that can be allocated after the churn
+ * fill         how many more buttons can be allocated after the churn
+ */
+
+#define _POSIX_C_SOURCE 200809L
+/* the heap algorithms are measured, not the heap trace */
+#define SGL_MM_BACKEND
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sgl.h>
+
+
+#ifndef CHURN_HEAP_ALGO
+#define CHURN_HEAP_ALGO                    "unknown"
+#endif
+
+#define  CHURN_PAGE_OBJS                   (48)
+#define  CHURN_KEEP_NUM                    (12)
+#define  CHURN_TEXT_MAX                    (96)
+
+
+typedef struct churn_block {
+    uint8_t   *p;
+    size_t    size;
+    uint8_t   tag;
+} churn_block_t;
+
+
+static const size_t churn_widget_size[] = {
+    sizeof(sgl_obj_t),
+    sizeof(sgl_page_t),
+    sizeof(sgl_button_t),
+    sizeof(sgl_label_t),
+    sizeof(sgl_switch_t),
+    sizeof(sgl_slider_t),
+    sizeof(sgl_checkbox_t),
+    sizeof(sgl_icon_t),
+    sizeof(sgl_progress_t),
+    sizeof(sgl_textbox_t),
+};
+
+static uint8_t churn_pool[CONFIG_SGL_HEAP_MEMORY_SIZE];
+static uint32_t churn_seed = 1;
+static uint64_t churn_clock_ns;
+
+static struct {
+    uint64_t  alloc_ns;
+    uint64_t  alloc_max;
+    uint32_t  alloc_num;
+    uint64_t  free_ns;
+    uint64_t  free_max;
+    uint32_t  free_num;
+    uint32_t  failed;
+    uint32_t  corrupt;
+} churn;
+
+
+static uint32_t churn_rand(void)
+{
+    churn_seed = churn_seed * 1103515245u + 12345u;
+    return churn_seed >> 8;
+}
+
+
+static uint64_t churn_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+
+/**
+ * @brief get the cost of reading the clock twice, it is removed from every sample
+ * @param none
+ * @return nanoseconds
+ */
+static uint64_t churn_clock_cost(void)
+{
+    uint64_t best = UINT64_MAX, t;
+
+    for (int i = 0; i < 10000; i++) {
+        t = churn_time_ns();
+        t = churn_time_ns() - t;
+        best = sgl_min(best, t);
+    }
+
+    return best;
+}
+
+
+static uint64_t churn_elapsed(uint64_t start)
+{
+    uint64_t ns = churn_time_ns() - start;
+    return ns > churn_clock_ns ? ns - churn_clock_ns : 0;
+}
+
+
+/**
+ * @brief allocate a block, time it and fill it with a tag
+ * @param block block to allocate
+ * @param size size of block
+ * @return true if success
+ */
+static bool churn_alloc(churn_block_t *block, size_t size)
+{
+    uint64_t start = churn_time_ns();
+    void *p = sgl_malloc(size);
+    uint64_t ns = churn_elapsed(start);
+
+    churn.alloc_ns += ns;
+    churn.alloc_max = sgl_max(churn.alloc_max, ns);
+    churn.alloc_num ++;
+
+    block->p = p;
+    block->size = size;
+    block->tag = (uint8_t)churn_rand();
+
+    if (p == NULL) {
+        churn.failed ++;
+        return false;
+    }
+
+    memset(p, block->tag, size);
+    return true;
+}
+
+
+/**
+ * @brief check the tag of a block, free it and time it
+ * @param block block to free, it can be a failed one
+ * @return none
+ */
+static void churn_free(churn_block_t *block)
+{
+    uint64_t start;
+
+    if (block->p == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < block->size; i++) {
+        if (block->p[i] != block->tag) {
+            churn.corrupt ++;
+            break;
+        }
+    }
+
+    start = churn_time_ns();
+    sgl_free(block->p);
+    start = churn_elapsed(start);
+
+    churn.free_ns += start;
+    churn.free_max = sgl_max(churn.free_max, start);
+    churn.free_num ++;
+    block->p = NULL;
+}
+
+
+/**
+ * @brief get the biggest block that the heap can give
+ * @param none
+ * @return size in bytes
+ */
+static size_t churn_largest(void)
+{
+    size_t lo = 0, hi = sizeof(churn_pool);
+    void *p;
+
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) / 2;
+        p = sgl_malloc(mid);
+        if (p != NULL) {
+            sgl_free(p);
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+
+    return lo;
+}
+
+
+/**
+ * @brief count how many buttons the heap can still give
+ * @param none
+ * @return number of buttons
+ */
+static int churn_fill(void)
+{
+    static void *fill[CONFIG_SGL_HEAP_MEMORY_SIZE / sizeof(sgl_button_t) + 1];
+    int num = 0;
+
+    while (num < (int)SGL_ARRAY_SIZE(fill) && (fill[num] = sgl_malloc(sizeof(sgl_button_t))) != NULL) {
+        num ++;
+    }
+
+    for (int i = 0; i < num; i++) {
+        sgl_free(fill[i]);
+    }
+
+    return num;
+}
+
+
+/**
+ * @brief open a page, play it and close it
+ * @param keep ring of the long lived widgets
+ * @return none
+ */
+static void churn_page(churn_block_t keep[CHURN_KEEP_NUM])
+{
+    churn_block_t page[CHURN_PAGE_OBJS], msgbox = { NULL, 0, 0 };
+    int num = 0, widgets = 8 + churn_rand() % 16;
+
+    for (int i = 0; i < widgets && num < CHURN_PAGE_OBJS; i++) {
+        churn_alloc(&page[num++], churn_widget_size[churn_rand() % SGL_ARRAY_SIZE(churn_widget_size)]);
+
+        if (churn_rand() % 3 == 0 && num < CHURN_PAGE_OBJS) {
+            churn_alloc(&page[num++], 8 + churn_rand() % (CHURN_TEXT_MAX - 8));
+        }
+
+        if (i == widgets / 2) {
+            churn_alloc(&msgbox, sizeof(sgl_msgbox_t));
+        }
+    }
+
+    churn_free(&msgbox);
+
+    /* a widget of the page lives on and takes the place of a kept one */
+    if (churn_rand() % 4 == 0) {
+        int from = churn_rand() % num, to = churn_rand() % CHURN_KEEP_NUM;
+
+        churn_free(&keep[to]);
+        keep[to] = page[from];
+        page[from] = page[--num];
+    }
+
+    /* close the page in random order */
+    for (int i = num - 1; i > 0; i--) {
+        int j = churn_rand() % (i + 1);
+        churn_block_t tmp = page[i];
+        page[i] = page[j];
+        page[j] = tmp;
+    }
+
+    for (int i = 0; i < num; i++) {
+        churn_free(&page[i]);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+    churn_block_t keep[CHURN_KEEP_NUM];
+    sgl_mm_monitor_t monitor;
+
+    memset(keep, 0, sizeof(keep));
+    sgl_mm_init(churn_pool, sizeof(churn_pool));
+    churn_clock_ns = churn_clock_cost();
+
+    for (int i = 0; i < rounds; i++) {
+        churn_page(keep);
+    }
+
+    monitor = sgl_mm_get_monitor();
+
+    printf("%-6s alloc %6.1f ns (max %6llu)  free %6.1f ns (max %6llu)  failed %6u  free %5zu  largest %5zu  fill %3d",
+           CHURN_HEAP_ALGO,
+           churn.alloc_num ? (double)churn.alloc_ns / churn.alloc_num : 0,
+           (unsigned long long)churn.alloc_max,
+           churn.free_num ? (double)churn.free_ns / churn.free_num : 0,
+           (unsigned long long)churn.free_max,
+           churn.failed, monitor.free_size, churn_largest(), churn_fill());
+
+    if (monitor.slab_size) {
+        printf("  slab %zu/%zu fallback %zu", monitor.slab_used, monitor.slab_size, monitor.slab_fallback);
+    }
+
+    printf("%s\n", churn.corrupt ? "  CORRUPT" : "");
+
+    for (int i = 0; i < CHURN_KEEP_NUM; i++) {
+        churn_free(&keep[i]);
+    }
+
+    return churn.corrupt ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,260 @@
+/* host/bench/lookup_bench.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_lookup_bench [passes]
+ *
+ * Compares the cost of finding the font table index of a unicode character:
+ *
+ *   ascii   song23, one dense range of 96 characters
+ *   sparse  an ascii range and a list of 500 scattered CJK characters, the way a
+ *           small subset of Chinese is emitted by the font tool
+ *   cjk     an ascii range and 3500 CJK characters emitted as many short ranges,
+ *           like a GB2312 level 1 font
+ *
+ * For every font, "search" walks the unicode parts, "cache" is the same font through
+ * sgl_search_unicode_ch_index() and the lookup cache, and "index" is a copy of the font
+ * with a font index. The index of song23 is the one that sgl_font_index_song23 generates,
+ * the other fonts are made at run time and get theirs from the same builder. The query text is
+ * made of the characters of one screen, LOOKUP_SCREEN_CHARS distinct characters that are
+ * picked with a skew to the frequent ones, and the three results are compared.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../port/host_port.h"
+#include "../tools/font_index.h"
+
+
+#define  LOOKUP_TEXT_LEN                   (4096)
+#define  LOOKUP_SCREEN_CHARS               (48)
+#define  LOOKUP_CJK_FIRST                  (0x4E00)
+#define  LOOKUP_CJK_LAST                   (0x9FA5)
+
+
+/* generated by sgl_font_index_song23 */
+extern const sgl_font_index_t song23_index;
+
+
+static uint32_t lookup_seed = 1;
+
+static uint32_t lookup_rand(void)
+{
+    lookup_seed = lookup_seed * 1103515245u + 12345u;
+    return lookup_seed >> 8;
+}
+
+
+/**
+ * @brief make a text of the characters of one screen
+ * @param chars all characters of the font
+ * @param num number of characters
+ * @param text [out] text of LOOKUP_TEXT_LEN characters
+ */
+static void lookup_text_make(const uint32_t *chars, uint32_t num, uint32_t *text)
+{
+    uint32_t screen[LOOKUP_SCREEN_CHARS];
+
+    /* a few characters of the font are much more frequent */
+    for (int i = 0; i < LOOKUP_SCREEN_CHARS; i++) {
+        uint64_t u = lookup_rand() & 0xFFFF;
+        screen[i] = chars[(u * u * num) >> 32];
+    }
+
+    for (int i = 0; i < LOOKUP_TEXT_LEN; i++) {
+        text[i] = screen[lookup_rand() % LOOKUP_SCREEN_CHARS];
+    }
+}
+
+
+static double lookup_time(int32_t (*fn)(const sgl_font_t*, uint32_t), const sgl_font_t *font,
+                          const uint32_t *text, int passes, uint32_t *sum)
+{
+    uint64_t t0 = host_port_time_us();
+
+    *sum = 0;
+    for (int p = 0; p < passes; p++) {
+        for (int i = 0; i < LOOKUP_TEXT_LEN; i++) {
+            *sum += fn(font, text[i]);
+        }
+    }
+
+    return (host_port_time_us() - t0) * 1000.0 / ((double)passes * LOOKUP_TEXT_LEN);
+}
+
+
+static int32_t lookup_search(const sgl_font_t *font, uint32_t unicode)
+{
+    return sgl_font_search_unicode(font, unicode);
+}
+
+
+static int32_t lookup_ch_index(const sgl_font_t *font, uint32_t unicode)
+{
+    return sgl_search_unicode_ch_index(font, unicode);
+}
+
+
+/**
+ * @brief run three lookup paths of a font
+ * @param name name of font
+ * @param font font without index
+ * @param index font index of the font
+ * @param chars all characters of the font
+ * @param num number of characters
+ * @param passes passes over the text
+ * @return 0 if the three paths agree
+ */
+static int lookup_run(const char *name, const sgl_font_t *font, const sgl_font_index_t *index,
+                      const uint32_t *chars, uint32_t num, int passes)
+{
+    static uint32_t text[LOOKUP_TEXT_LEN];
+    uint32_t sum[3], glyph_num;
+    double ns[3];
+    int bad = 0;
+
+    printf("%s: %u characters, %u unicode parts\n", name, num, font->unicode_num);
+
+    if (index == NULL) {
+        fprintf(stderr, "%s: out of memory\n", name);
+        return -1;
+    }
+
+    glyph_num = font_index_glyph_num(index);
+    printf("  index: %d blocks, %u glyph blocks, %d bytes\n", index->block_num, glyph_num,
+           (int)((index->block_num + glyph_num * SGL_FONT_INDEX_BLOCK_SIZE) * sizeof(uint16_t)));
+
+    const sgl_font_t indexed = {
+        .bitmap = font->bitmap,
+        .table = font->table,
+        .font_table_size = font->font_table_size,
+        .font_height = font->font_height,
+        .unicode = font->unicode,
+        .unicode_num = font->unicode_num,
+        .base_line = font->base_line,
+        .bpp = font->bpp,
+        .compress = font->compress,
+        .index = index,
+    };
+
+    for (uint32_t i = 0; i < num; i++) {
+        int32_t expect = sgl_font_search_unicode(font, chars[i]);
+        if (expect < 0 || (uint32_t)expect != sgl_search_unicode_ch_index(font, chars[i])
+                       || (uint32_t)expect != sgl_search_unicode_ch_index(&indexed, chars[i])) {
+            bad ++;
+        }
+    }
+
+    lookup_text_make(chars, num, text);
+    ns[0] = lookup_time(lookup_search, font, text, passes, &sum[0]);
+    ns[1] = lookup_time(lookup_ch_index, font, text, passes, &sum[1]);
+    ns[2] = lookup_time(lookup_ch_index, &indexed, text, passes, &sum[2]);
+    bad += (sum[0] != sum[1]) + (sum[0] != sum[2]);
+
+    printf("  search %7.2f ns  cache %7.2f ns  index %7.2f ns  %s\n",
+           ns[0], ns[1], ns[2], bad ? "MISMATCH" : "ok");
+
+    return bad ? -1 : 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    int passes = argc > 1 ? atoi(argv[1]) : 200;
+    sgl_font_index_t *index;
+    static uint32_t chars[4096];
+    static uint32_t list[500];
+    static sgl_font_unicode_t parts[1024];
+    uint32_t num = 0, part_num = 0, unicode;
+    int ret = 0;
+
+    /* ascii */
+    for (unicode = 32; unicode < 128; unicode++) {
+        chars[num++] = unicode;
+    }
+    ret |= lookup_run("ascii", &song23, &song23_index, chars, num, passes);
+
+    /* sparse: ascii range and a list of scattered CJK characters */
+    memcpy(&parts[part_num++], song23.unicode, sizeof(sgl_font_unicode_t));
+    unicode = LOOKUP_CJK_FIRST;
+    for (uint32_t i = 0; i < SGL_ARRAY_SIZE(list); i++) {
+        unicode += 1 + lookup_rand() % 80;
+        list[i] = unicode - LOOKUP_CJK_FIRST;
+        chars[num++] = unicode;
+    }
+
+    sgl_font_unicode_t sparse_list = {
+        .offset = LOOKUP_CJK_FIRST,
+        .len = SGL_ARRAY_SIZE(list),
+        .list = list,
+        .tab_offset = 96,
+    };
+    memcpy(&parts[part_num++], &sparse_list, sizeof(sgl_font_unicode_t));
+
+    const sgl_font_t sparse = {
+        .table = song23.table,
+        .font_height = song23.font_height,
+        .unicode = parts,
+        .unicode_num = part_num,
+        .bpp = 4,
+    };
+    index = font_index_build(&sparse);
+    ret |= lookup_run("sparse", &sparse, index, chars, num, passes);
+    font_index_free(index);
+
+    /* cjk: ascii range and 3500 characters in short runs */
+    num = 96;
+    part_num = 1;
+    unicode = LOOKUP_CJK_FIRST;
+    while (num < 96 + 3500 && part_num < SGL_ARRAY_SIZE(parts)) {
+        uint32_t len = sgl_min(1 + lookup_rand() % 12, 96 + 3500 - num);
+        sgl_font_unicode_t run = {
+            .offset = unicode,
+            .len = len,
+            .list = NULL,
+            .tab_offset = num,
+        };
+
+        SGL_ASSERT(unicode + len <= LOOKUP_CJK_LAST);
+        memcpy(&parts[part_num++], &run, sizeof(sgl_font_unicode_t));
+        for (uint32_t i = 0; i < len; i++) {
+            chars[num++] = unicode++;
+        }
+        unicode += lookup_rand() % 7;
+    }
+
+    const sgl_font_t cjk = {
+        .table = song23.table,
+        .font_height = song23.font_height,
+        .unicode = parts,
+        .unicode_num = part_num,
+        .bpp = 4,
+    };
+    index = font_index_build(&cjk);
+    ret |= lookup_run("cjk", &cjk, index, chars, num, passes);
+    font_index_free(index);
+
+    return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
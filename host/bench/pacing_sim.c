@@ -0,0 +1,189 @@
+/* host/bench/pacing_sim.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_pacing_sim
+ *
+ * Plays two animations, a big rect that moves across the lower half of the screen and a small
+ * one that moves up and down, on the virtual panel of host_port_set_te() with a refresh of
+ * SIM_TE_PERIOD_US, in virtual time of SIM_TIME_MS. The main loop wakes up every SIM_STEP_US
+ * and calls sgl_task_handle(). Every mode is run with a fast and a slow transport:
+ *
+ *   tick      the TE pulses are not sent to sgl, the frames follow SGL_SYSTEM_TICK_MS and start
+ *             at any place of the scan
+ *   te        the TE pulses are sent to sgl_fbdev_te_signal(), a frame starts after a pulse
+ *             and the frames of the slow transport take more than one period
+ *
+ * The slow transport needs more than a refresh period for the big rect, the scan passes its
+ * rows while they are sent in any mode, so only the frame rate and the even spacing of the
+ * frames can be seen there.
+ *
+ * frames       frames that the panel received
+ * torn         frames that the panel showed part old and part new
+ * te           frames that were started by a TE pulse
+ * coalesced    frame periods of the animations that were merged into the next frame
+ * time         average and max frame time in ms, from the start of a frame to its last flush
+ * interval     TE periods between two frames at the end
+ *
+ * The animations end before SIM_TIME_MS, so every mode must show the same screen at the end.
+ * Every mode runs in its own child process, because sgl can not be initialized twice.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../port/host_port.h"
+
+
+#define  SIM_TIME_MS                       (4000)
+#define  SIM_STEP_US                       (100)
+#define  SIM_TE_PERIOD_US                  (16667)
+
+
+static void sim_anim_x(struct sgl_anim *anim, int32_t value)
+{
+    sgl_obj_set_pos_x(anim->data, value);
+}
+
+
+static void sim_anim_y(struct sgl_anim *anim, int32_t value)
+{
+    sgl_obj_set_pos_y(anim->data, value);
+}
+
+
+/**
+ * @brief start an animation that moves an object
+ * @param obj object to move
+ * @param path_cb moves it on x or on y
+ * @param start start position
+ * @param end end position
+ * @param duration duration of a pass in ms
+ * @param repeat number of passes
+ * @return none
+ */
+static void sim_anim_start(sgl_obj_t *obj, sgl_anim_path_cb_t path_cb, int32_t start, int32_t end,
+                           uint32_t duration, uint32_t repeat)
+{
+    sgl_anim_t *anim = sgl_anim_create();
+    if (anim == NULL) {
+        return;
+    }
+
+    sgl_anim_set_data(anim, obj);
+    sgl_anim_set_act_duration(anim, duration);
+    sgl_anim_set_start_value(anim, start);
+    sgl_anim_set_end_value(anim, end);
+    sgl_anim_set_path(anim, path_cb, SGL_ANIM_PATH_EASE_IN_OUT);
+    sgl_anim_set_auto_free(anim);
+    sgl_anim_start(anim, repeat);
+}
+
+
+static void sim_setup(sgl_obj_t **big, sgl_obj_t **small)
+{
+    *big = sgl_rect_create(NULL);
+    sgl_obj_set_pos(*big, 10, 120);
+    sgl_obj_set_size(*big, 100, 100);
+
+    *small = sgl_rect_create(NULL);
+    sgl_obj_set_pos(*small, 180, 10);
+    sgl_obj_set_size(*small, 30, 30);
+}
+
+
+static int sim_run(const char *name, bool te, uint32_t byte_rate)
+{
+    sgl_obj_t *big, *small;
+    host_port_stats_t port;
+    sgl_frame_stats_t frame;
+
+    host_port_set_transport(byte_rate, false);
+    host_port_set_te(SIM_TE_PERIOD_US, te);
+
+    if (host_port_init() || sgl_init()) {
+        fprintf(stderr, "%s: sgl init failed\n", name);
+        return -1;
+    }
+
+    sgl_set_system_font(&song23);
+    sim_setup(&big, &small);
+
+    /* the first frame draws the whole screen, it is not counted */
+    sgl_task_handle_now();
+    host_port_stats_reset();
+    sgl_frame_stats_reset();
+
+    sim_anim_start(big, sim_anim_x, 10, 130, 600, 5);
+    sim_anim_start(small, sim_anim_y, 10, 150, 450, 6);
+
+    while (sgl_tick_get() < SIM_TIME_MS) {
+        host_port_advance_us(SIM_STEP_US);
+        sgl_task_handle();
+    }
+
+    port = host_port_stats_get();
+    frame = sgl_frame_get_stats();
+
+    printf("%-10s frames %4u  torn %4u (%5.1f%%)  te %4u  coalesced %4u  time avg %2u max %2u ms  interval %u  crc %08x\n",
+           name, port.frames, port.torn_frames, port.frames ? 100.0 * port.torn_frames / port.frames : 0.0,
+           frame.te_frames, frame.coalesced, frame.avg_ms, frame.max_ms, frame.interval,
+           host_port_panel_checksum());
+
+    return 0;
+}
+
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        bool        te;
+        uint32_t    byte_rate;
+    } modes[] = {
+        { "tick fast", false, 4500000 },
+        { "te fast",   true,  4500000 },
+        { "tick slow", false, 1125000 },
+        { "te slow",   true,  1125000 },
+    };
+    int failed = 0;
+
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(modes); i++) {
+        pid_t pid;
+        int status;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            exit(sim_run(modes[i].name, modes[i].te, modes[i].byte_rate) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            failed ++;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
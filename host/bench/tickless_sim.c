@@ -0,0 +1,286 @@
+/* host/bench/tickless_sim.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_tickless_sim
+ *
+ * Plays the same scripted touch trace on a page with a button, a slider and a rect that a
+ * click of the button moves by a delayed animation, in virtual time of SIM_TIME_MS:
+ *
+ *   polled    the board today, the TIM2 interrupt wakes the main loop every 1 ms and the
+ *             main loop calls sgl_task_handle(), an input waits for the next tick period
+ *   tickless  the main loop sleeps for sgl_task_get_wait() or until an input comes, then it
+ *             calls sgl_task_handle(), or sgl_task_handle_now() for an input
+ *
+ * wakeups      times the main loop woke up
+ * runs         times sgl task ran, drawn is the number of frames that had dirty areas
+ * latency      virtual ms from an input to the run of sgl task that handles it
+ *
+ * The checksum of the panel is printed at the end, both modes must show the same screen.
+ * Every mode runs in its own child process, because sgl can not be initialized twice.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../port/host_port.h"
+
+
+#define  SIM_TIME_MS                       (5000)
+
+
+typedef struct sim_input {
+    uint32_t  time;
+    int16_t   x;
+    int16_t   y;
+    bool      down;
+} sim_input_t;
+
+
+/* a tap of the button, a drag of the slider reported every 16 ms, a tap that starts the animation */
+static sim_input_t sim_trace[64];
+static int sim_trace_num;
+
+static sgl_obj_t *sim_rect;
+
+static struct {
+    uint32_t  wakeups;
+    uint32_t  runs;
+    uint32_t  served;
+    uint32_t  latency;
+    uint32_t  latency_max;
+} sim;
+
+
+static void sim_trace_add(uint32_t time, int16_t x, int16_t y, bool down)
+{
+    sim_trace[sim_trace_num++] = (sim_input_t) { .time = time, .x = x, .y = y, .down = down };
+}
+
+
+static void sim_trace_build(void)
+{
+    sim_trace_add(300, 60, 40, true);
+    sim_trace_add(360, 60, 40, false);
+
+    for (uint32_t t = 1000; t < 1300; t += 16) {
+        sim_trace_add(t, 30 + (int16_t)((t - 1000) / 2), 120, true);
+    }
+    sim_trace_add(1300, 180, 120, false);
+
+    sim_trace_add(2500, 60, 40, true);
+    sim_trace_add(2580, 60, 40, false);
+}
+
+
+static void sim_anim_path(struct sgl_anim *anim, int32_t value)
+{
+    sgl_obj_set_pos_x(anim->data, value);
+}
+
+
+static void sim_button_event(sgl_event_t *e)
+{
+    if (e->type != SGL_EVENT_RELEASED) {
+        return;
+    }
+
+    sgl_anim_t *anim = sgl_anim_create();
+    if (anim == NULL) {
+        return;
+    }
+
+    sgl_anim_set_data(anim, sim_rect);
+    sgl_anim_set_act_delay(anim, 200);
+    sgl_anim_set_act_duration(anim, 400);
+    sgl_anim_set_start_value(anim, sgl_obj_get_pos_x(sim_rect));
+    sgl_anim_set_end_value(anim, sgl_obj_get_pos_x(sim_rect) < 100 ? 180 : 20);
+    sgl_anim_set_path(anim, sim_anim_path, SGL_ANIM_PATH_EASE_IN_OUT);
+    sgl_anim_set_auto_free(anim);
+    sgl_anim_start(anim, 1);
+}
+
+
+static void sim_setup(void)
+{
+    sgl_obj_t *button = sgl_button_create(NULL);
+    sgl_obj_set_pos(button, 20, 20);
+    sgl_obj_set_size(button, 80, 40);
+    sgl_obj_set_event_cb(button, sim_button_event, NULL);
+
+    sgl_obj_t *slider = sgl_slider_create(NULL);
+    sgl_obj_set_pos(slider, 20, 110);
+    sgl_obj_set_size(slider, 200, 20);
+
+    sim_rect = sgl_rect_create(NULL);
+    sgl_obj_set_pos(sim_rect, 20, 180);
+    sgl_obj_set_size(sim_rect, 40, 40);
+}
+
+
+/**
+ * @brief run sgl task and count the inputs that it handles
+ * @param now virtual time
+ * @param next index of the first input that is not sent yet
+ * @param input true if an input has just come
+ * @return none
+ */
+static void sim_task(uint32_t now, int next, bool input)
+{
+    uint32_t last = sgl_last_tick_get();
+
+    if (input) {
+        sgl_task_handle_now();
+    }
+    else {
+        sgl_task_handle();
+        if (sgl_last_tick_get() == last) {
+            return;
+        }
+    }
+
+    sim.runs ++;
+    for (; (int)sim.served < next; sim.served ++) {
+        uint32_t latency = now - sim_trace[sim.served].time;
+        sim.latency += latency;
+        sim.latency_max = sgl_max(sim.latency_max, latency);
+    }
+}
+
+
+/**
+ * @brief send the inputs of the trace that are due
+ * @param now virtual time
+ * @param next index of the first input that is not sent yet
+ * @return index of the first input that is not sent after this call
+ */
+static int sim_send(uint32_t now, int next)
+{
+    while (next < sim_trace_num && sim_trace[next].time <= now) {
+        sgl_event_pos_input(sim_trace[next].x, sim_trace[next].y, sim_trace[next].down);
+        next ++;
+    }
+
+    return next;
+}
+
+
+static void sim_polled(void)
+{
+    int next = 0;
+
+    for (uint32_t now = 1; now <= SIM_TIME_MS; now++) {
+        host_port_tick_inc(1);
+        sim.wakeups ++;
+        next = sim_send(now, next);
+        sim_task(now, next, false);
+    }
+}
+
+
+static void sim_tickless(void)
+{
+    uint32_t now = 0, wake, wait;
+    int next = 0;
+
+    while (now < SIM_TIME_MS) {
+        wait = sgl_task_get_wait();
+        wake = next < sim_trace_num ? sim_trace[next].time : SIM_TIME_MS;
+        if (wait != SGL_WAIT_FOREVER) {
+            wake = sgl_min(wake, now + wait);
+        }
+        wake = sgl_min(wake, (uint32_t)SIM_TIME_MS);
+
+        /* the main loop sleeps here, the wakeup timer or the touch interrupt ends it */
+        host_port_tick_inc(wake - now);
+        now = wake;
+        sim.wakeups ++;
+
+        if (next < sim_trace_num && sim_trace[next].time <= now) {
+            next = sim_send(now, next);
+            sim_task(now, next, true);
+        }
+        else {
+            sim_task(now, next, false);
+        }
+    }
+}
+
+
+static int sim_run(const char *name, void (*loop)(void))
+{
+    if (host_port_init() || sgl_init()) {
+        fprintf(stderr, "%s: sgl init failed\n", name);
+        return -1;
+    }
+
+    sgl_set_system_font(&song23);
+    sim_setup();
+    sim_trace_build();
+
+    /* the first frame draws the whole screen */
+    sgl_task_handle_now();
+    uint32_t frame = sgl_fbdev_get_frame();
+
+    loop();
+    host_port_sync();
+
+    printf("%-9s wakeups %5u  runs %4u  drawn %4u  latency avg %5.2f ms max %2u ms  crc %08x\n",
+           name, sim.wakeups, sim.runs, sgl_fbdev_get_frame() - frame,
+           sim.served ? (double)sim.latency / sim.served : 0.0, sim.latency_max,
+           host_port_panel_checksum());
+
+    return sim.served == (uint32_t)sim_trace_num ? 0 : -1;
+}
+
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        void (*loop)(void);
+    } modes[] = {
+        { "polled", sim_polled },
+        { "tickless", sim_tickless },
+    };
+    int failed = 0;
+
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(modes); i++) {
+        pid_t pid;
+        int status;
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) {
+            exit(sim_run(modes[i].name, modes[i].loop) ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            failed ++;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,410 @@
+/* host/port/host_port.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include "host_port.h"
+
+
+/* draw buffers, each one has the same lines as the single buffer of the board, the second
+ * one is only used by the async transport, so the slices are the same in both modes
+ */
+static sgl_color_t host_draw_buffer[2][HOST_PANEL_WIDTH * HOST_PANEL_BUFFER_LINES];
+
+/* panel memory, it plays the role of the ST7789 GRAM */
+static sgl_color_t host_panel[HOST_PANEL_WIDTH * HOST_PANEL_HEIGHT];
+
+static host_port_stats_t host_stats;
+
+/* transport, see host_port_set_transport() */
+static uint32_t host_byte_rate = 0;
+static bool host_async = false;
+
+/* virtual panel, see host_port_set_te() */
+static struct {
+    uint32_t  period_us;
+    bool      signal;
+    uint64_t  clock_us;
+    uint64_t  next_tick_us;
+    uint64_t  next_te_us;
+    uint32_t  frame;
+    uint64_t  frame_refresh;
+    bool      frame_torn;
+} host_te;
+
+/* the drain timer takes one job at a time, sgl never has two flushes in flight */
+static struct {
+    timer_t         timer;
+    sgl_area_t      area;
+    sgl_color_t     *src;
+} host_drain;
+
+
+static void host_log_puts(const char *str)
+{
+    fputs(str, stderr);
+}
+
+
+static uint64_t host_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+
+/**
+ * @brief get the time that the transport needs to send the area
+ * @param area area of flush
+ * @return nanoseconds
+ */
+static uint64_t host_transport_ns(sgl_area_t *area)
+{
+    uint64_t bytes = (uint64_t)(area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1) * sizeof(sgl_color_t);
+
+    return host_byte_rate ? bytes * 1000000000u / host_byte_rate : 0;
+}
+
+
+/**
+ * @brief copy area into panel memory and count it
+ * @param area area of flush
+ * @param src source color
+ * @return none
+ */
+static void host_panel_write(sgl_area_t *area, sgl_color_t *src)
+{
+    int16_t w = area->x2 - area->x1 + 1;
+    int16_t h = area->y2 - area->y1 + 1;
+
+    SGL_ASSERT(area->x1 >= 0 && area->y1 >= 0 && area->x2 < HOST_PANEL_WIDTH && area->y2 < HOST_PANEL_HEIGHT);
+
+    for (int16_t y = 0; y < h; y++) {
+        sgl_color_t *dst = &host_panel[(area->y1 + y) * HOST_PANEL_WIDTH + area->x1];
+
+        for (int16_t x = 0; x < w; x++) {
+            if (dst[x].full != src[x].full) {
+                host_stats.touch_pixels ++;
+            }
+        }
+
+        memcpy(dst, src, w * sizeof(sgl_color_t));
+        src += w;
+    }
+
+    host_stats.flush_count ++;
+    host_stats.flush_pixels += (uint32_t)w * h;
+    host_stats.flush_bytes += (uint32_t)w * h * sizeof(sgl_color_t);
+}
+
+
+/**
+ * @brief get the refresh of the virtual panel that shows a row
+ * @param row row of the panel
+ * @param us time when the row is written
+ * @return index of the refresh, it is the current one if the scan has not reached the row yet
+ */
+static uint64_t host_te_refresh(int16_t row, uint64_t us)
+{
+    uint64_t refresh = us / host_te.period_us;
+    uint64_t scan = (us % host_te.period_us) * HOST_PANEL_HEIGHT / host_te.period_us;
+
+    return (uint64_t)row >= scan ? refresh : refresh + 1;
+}
+
+
+/**
+ * @brief flush area into the virtual panel, the transfer takes virtual time
+ * @param area area of flush
+ * @param src source color
+ * @return none
+ */
+static void host_te_flush_area(sgl_area_t *area, sgl_color_t *src)
+{
+    uint64_t start = host_te.clock_us, top, bottom;
+
+    host_port_advance_us((uint32_t)(host_transport_ns(area) / 1000));
+
+    /* the rows are sent from top to bottom, the scan may pass them while they are sent */
+    top = host_te_refresh(area->y1, start);
+    bottom = host_te_refresh(area->y2, host_te.clock_us);
+
+    if (sgl_fbdev_get_frame() != host_te.frame) {
+        host_te.frame = sgl_fbdev_get_frame();
+        host_te.frame_refresh = top;
+        host_te.frame_torn = false;
+        host_stats.frames ++;
+    }
+
+    if (!host_te.frame_torn && (top != host_te.frame_refresh || bottom != host_te.frame_refresh)) {
+        host_te.frame_torn = true;
+        host_stats.torn_frames ++;
+    }
+
+    host_panel_write(area, src);
+    sgl_fbdev_flush_ready();
+}
+
+
+/**
+ * @brief flush area into panel memory
+ * @param area area of flush
+ * @param src source color
+ * @return none
+ * @note it is the host version of demo_panel_flush_area
+ */
+static void host_panel_flush_area(sgl_area_t *area, sgl_color_t *src)
+{
+    uint64_t ns;
+
+    if (host_te.period_us) {
+        host_te_flush_area(area, src);
+        return;
+    }
+
+    ns = host_transport_ns(area);
+
+    if (host_async) {
+        /* start the "DMA", a zero it_value disarms the timer, so it is at least 1ns */
+        struct itimerspec its = {
+            .it_value.tv_sec = ns / 1000000000u,
+            .it_value.tv_nsec = sgl_max(ns % 1000000000u, 1),
+        };
+
+        host_drain.area = *area;
+        host_drain.src = src;
+        timer_settime(host_drain.timer, 0, &its, NULL);
+        return;
+    }
+
+    /* SPI busy wait, it spins because a slice takes only hundreds of microseconds */
+    for (uint64_t end = host_time_ns() + ns; host_time_ns() < end; );
+
+    host_panel_write(area, src);
+    sgl_fbdev_flush_ready();
+}
+
+
+/**
+ * @brief drain timer handler, it plays the DMA transfer complete interrupt
+ * @param sig unused
+ * @return none
+ */
+static void host_drain_handler(int sig)
+{
+    (void)sig;
+
+    host_panel_write(&host_drain.area, host_drain.src);
+    sgl_fbdev_flush_ready();
+}
+
+
+/**
+ * @brief set the transport between sgl and the panel, call it before host_port_init()
+ * @param byte_rate bytes per second of the transport, 0 means the flush costs no time
+ * @param async false: flush_area waits for the transfer, like SPI1_WriteMultByte on the board
+ *              true: a one-shot timer plays the DMA and its signal handler plays the transfer
+ *              complete interrupt, a second draw buffer is used
+ *              and flush_area returns at once, like the DMA path of user/src/tft.c
+ * @return none
+ */
+void host_port_set_transport(uint32_t byte_rate, bool async)
+{
+    host_byte_rate = byte_rate;
+    host_async = async;
+}
+
+
+/**
+ * @brief make the panel a virtual one with a TE signal, call it before host_port_init()
+ * @param period_us refresh period of the panel, 0 turns the virtual panel off
+ * @param signal true: every TE pulse calls sgl_fbdev_te_signal(), like the TE interrupt of the board
+ *               false: the panel scans without telling sgl, the tearing is still counted
+ * @return none
+ */
+void host_port_set_te(uint32_t period_us, bool signal)
+{
+    memset(&host_te, 0, sizeof(host_te));
+    host_te.period_us = period_us;
+    host_te.signal = signal;
+    host_te.next_tick_us = 1000;
+    host_te.next_te_us = period_us;
+}
+
+
+/**
+ * @brief advance the clock of the virtual panel
+ * @param us microseconds
+ * @return none
+ * @note the sgl tick comes before a TE pulse of the same time, so the pulse sees the new tick
+ */
+void host_port_advance_us(uint32_t us)
+{
+    uint64_t end = host_te.clock_us + us;
+
+    while (host_te.period_us && sgl_min(host_te.next_tick_us, host_te.next_te_us) <= end) {
+        if (host_te.next_tick_us <= host_te.next_te_us) {
+            host_te.clock_us = host_te.next_tick_us;
+            host_te.next_tick_us += 1000;
+            sgl_tick_inc(1);
+        }
+        else {
+            host_te.clock_us = host_te.next_te_us;
+            host_te.next_te_us += host_te.period_us;
+            host_stats.te_pulses ++;
+#if (CONFIG_SGL_FRAME_PACING)
+            if (host_te.signal) {
+                sgl_fbdev_te_signal();
+            }
+#endif
+        }
+    }
+
+    host_te.clock_us = end;
+}
+
+
+/**
+ * @brief wait all flushes are finished, the panel memory and statistics are stable after it
+ * @param none
+ * @return none
+ */
+void host_port_sync(void)
+{
+    sgl_fbdev_flush_sync();
+}
+
+
+/**
+ * @brief register the in-memory panel as sgl framebuffer device
+ * @param none
+ * @return int, 0 if success, -1 if failed
+ * @note call it before sgl_init(), just like the board does with demo_panel_flush_area
+ */
+int host_port_init(void)
+{
+    sgl_fbinfo_t fbinfo = {
+        .xres = HOST_PANEL_WIDTH,
+        .yres = HOST_PANEL_HEIGHT,
+        .flush_area = host_panel_flush_area,
+        .buffer[0] = host_draw_buffer[0],
+        .buffer_size = SGL_ARRAY_SIZE(host_draw_buffer[0]),
+    };
+
+    memset(host_panel, 0, sizeof(host_panel));
+    host_port_stats_reset();
+
+    if (host_async && !host_te.period_us) {
+        struct sigevent sev = {
+            .sigev_notify = SIGEV_SIGNAL,
+            .sigev_signo = SIGRTMIN,
+        };
+        struct sigaction sa = {
+            .sa_handler = host_drain_handler,
+            .sa_flags = SA_RESTART,
+        };
+
+        fbinfo.buffer[1] = host_draw_buffer[1];
+
+        /* the default timer slack is 50us, that is longer than a fast transfer */
+        prctl(PR_SET_TIMERSLACK, 1);
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(SIGRTMIN, &sa, NULL) || timer_create(CLOCK_MONOTONIC, &sev, &host_drain.timer)) {
+            return -1;
+        }
+    }
+
+    sgl_logdev_register(host_log_puts);
+    return sgl_fbdev_register(&fbinfo);
+}
+
+
+/**
+ * @brief get the panel memory, it is what the screen shows after the last flush
+ * @param none
+ * @return pointer to HOST_PANEL_WIDTH * HOST_PANEL_HEIGHT pixels
+ */
+const sgl_color_t* host_port_panel(void)
+{
+    return host_panel;
+}
+
+
+/**
+ * @brief get the checksum of the panel memory
+ * @param none
+ * @return FNV-1a hash of the panel memory
+ * @note it is used to check that an optimization did not change the rendering result
+ */
+uint32_t host_port_panel_checksum(void)
+{
+    const uint8_t *p = (const uint8_t*)host_panel;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < sizeof(host_panel); i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+
+/**
+ * @brief get host port statistics
+ * @param none
+ * @return current statistics
+ */
+host_port_stats_t host_port_stats_get(void)
+{
+    return host_stats;
+}
+
+
+/**
+ * @brief reset host port statistics
+ * @param none
+ * @return none
+ */
+void host_port_stats_reset(void)
+{
+    memset(&host_stats, 0, sizeof(host_stats));
+}
+
+
+/**
+ * @brief get monotonic time in microseconds
+ * @param none
+ * @return microseconds
+ */
+uint64_t host_port_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
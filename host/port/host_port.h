@@ -0,0 +1,170 @@
+/* host/port/host_port.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __HOST_PORT_H__
+#define __HOST_PORT_H__
+
+#include <sgl.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* same panel and draw buffer geometry as user/src/main.c */
+#define  HOST_PANEL_WIDTH                  (240)
+#define  HOST_PANEL_HEIGHT                 (240)
+#define  HOST_PANEL_BUFFER_LINES           (10)
+
+
+/**
+ * @brief host port statistics, all counters are accumulated until host_port_stats_reset()
+ * @flush_count: number of flush_area calls, each draw_obj_slice pass flushes exactly once
+ * @flush_pixels: pixels sent to the panel
+ * @flush_bytes: bytes sent to the panel
+ * @touch_pixels: pixels whose value really changed in the panel memory
+ * @te_pulses: TE pulses of the virtual panel, see host_port_set_te()
+ * @frames: frames that the virtual panel received
+ * @torn_frames: frames that the virtual panel showed in two refreshes, part old and part new
+ */
+typedef struct host_port_stats {
+    uint32_t  flush_count;
+    uint64_t  flush_pixels;
+    uint64_t  flush_bytes;
+    uint64_t  touch_pixels;
+    uint32_t  te_pulses;
+    uint32_t  frames;
+    uint32_t  torn_frames;
+} host_port_stats_t;
+
+
+/**
+ * @brief set the transport between sgl and the panel, call it before host_port_init()
+ * @param byte_rate bytes per second of the transport, 0 means the flush costs no time
+ * @param async false: flush_area waits for the transfer, like SPI1_WriteMultByte on the board
+ *              true: a one-shot timer plays the DMA and its signal handler plays the transfer
+ *              complete interrupt, a second draw buffer is used
+ *              and flush_area returns at once, like the DMA path of user/src/tft.c
+ * @return none
+ */
+void host_port_set_transport(uint32_t byte_rate, bool async);
+
+
+/**
+ * @brief make the panel a virtual one with a TE signal, call it before host_port_init()
+ * @param period_us refresh period of the panel, 0 turns the virtual panel off
+ * @param signal true: every TE pulse calls sgl_fbdev_te_signal(), like the TE interrupt of the board
+ *               false: the panel scans without telling sgl, the tearing is still counted
+ * @return none
+ * @note the virtual panel has its own clock, host_port_advance_us() moves it and every flush adds
+ *       its transfer time to it, the sgl tick and the TE pulses come from this clock, so they come
+ *       in the middle of a frame like interrupts. The panel scans one row after the other in a
+ *       period, a frame is torn if some of its rows are shown in a refresh and others in the next
+ */
+void host_port_set_te(uint32_t period_us, bool signal);
+
+
+/**
+ * @brief advance the clock of the virtual panel
+ * @param us microseconds
+ * @return none
+ */
+void host_port_advance_us(uint32_t us);
+
+
+/**
+ * @brief wait all flushes are finished, the panel memory and statistics are stable after it
+ * @param none
+ * @return none
+ */
+void host_port_sync(void);
+
+
+/**
+ * @brief register the in-memory panel as sgl framebuffer device
+ * @param none
+ * @return int, 0 if success, -1 if failed
+ * @note call it before sgl_init(), just like the board does with demo_panel_flush_area
+ */
+int host_port_init(void);
+
+
+/**
+ * @brief fake tick source, it replaces the TIM2 interrupt of the board
+ * @param ms milliseconds to advance
+ * @return none
+ */
+static inline void host_port_tick_inc(uint32_t ms)
+{
+    sgl_tick_inc(ms);
+}
+
+
+/**
+ * @brief get the panel memory, it is what the screen shows after the last flush
+ * @param none
+ * @return pointer to HOST_PANEL_WIDTH * HOST_PANEL_HEIGHT pixels
+ */
+const sgl_color_t* host_port_panel(void);
+
+
+/**
+ * @brief get the checksum of the panel memory
+ * @param none
+ * @return FNV-1a hash of the panel memory
+ * @note it is used to check that an optimization did not change the rendering result
+ */
+uint32_t host_port_panel_checksum(void);
+
+
+/**
+ * @brief get host port statistics
+ * @param none
+ * @return current statistics
+ */
+host_port_stats_t host_port_stats_get(void);
+
+
+/**
+ * @brief reset host port statistics
+ * @param none
+ * @return none
+ */
+void host_port_stats_reset(void);
+
+
+/**
+ * @brief get monotonic time in microseconds
+ * @param none
+ * @return microseconds
+ */
+uint64_t host_port_time_us(void);
+
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // !__HOST_PORT_H__
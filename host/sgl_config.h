@@ -0,0 +1,44 @@
+//****************************************************************
+//* lite-manager                                                 *
+//* NOTE: host build configuration, keep it in step with         *
+//*       sgl/sgl_config.h so numbers match the STM32 target     *
+//****************************************************************
+
+#ifndef  __CONFIG_H__
+#define  __CONFIG_H__
+
+
+#define    CONFIG_SGL_PANEL_PIXEL_DEPTH       16
+#define    CONFIG_SGL_EVENT_QUEUE_SIZE        16
+#define    CONFIG_SGL_EVENT_HIT_GRID_CELL     32
+#define    CONFIG_SGL_ANIMATION               1
+#define    CONFIG_SGL_ANIMATION_TICK_MS       10
+#define    CONFIG_SGL_ANIM_POOL_SIZE          32
+#define    CONFIG_SGL_DEBUG                   0
+#define    CONFIG_SGL_BOOT_LOGO               0
+#define    CONFIG_SGL_HEAP_ALGO               lwmem
+#define    CONFIG_SGL_HEAP_MEMORY_SIZE        10240
+#define    CONFIG_SGL_HEAP_TRACE              1
+#define    CONFIG_SGL_PAGE_REGION             1
+/* sgl_obj_report builds the full object layout too */
+#ifndef    CONFIG_SGL_OBJ_COMPACT
+#define    CONFIG_SGL_OBJ_COMPACT             1
+#endif
+#define    CONFIG_SGL_FONT_SONG23             1
+#define    CONFIG_SGL_FONT_CONSOLAS14         1
+#define    CONFIG_SGL_GLYPH_CACHE_SIZE        4096
+#define    CONFIG_SGL_FONT_LOOKUP_CACHE       64
+#define    CONFIG_SGL_DRAW_SCRATCH_SIZE       1024
+#ifndef    CONFIG_SGL_DRAW_BATCH
+#define    CONFIG_SGL_DRAW_BATCH              8
+#endif
+#ifndef    CONFIG_SGL_DRAW_LIST_SIZE
+#define    CONFIG_SGL_DRAW_LIST_SIZE          64
+#endif
+#ifndef    CONFIG_SGL_DRAW_CORNER_CACHE
+#define    CONFIG_SGL_DRAW_CORNER_CACHE       8
+#endif
+#define    CONFIG_SGL_FRAME_PACING            1
+
+
+#endif  //!__CONFIG_H__
@@ -0,0 +1,148 @@
+/* host/tools/font_index.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Builder of the font index, the two level page table of sgl_font_index_t. It is used by the
+ * sgl_font_index_<font> generators, see font_index_main.c, and by sgl_lookup_bench for the
+ * fonts that it makes at run time.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "font_index.h"
+
+
+#define  FONT_INDEX_UNICODE_MAX            (0x10000)
+#define  FONT_INDEX_BLOCK_MAX              (FONT_INDEX_UNICODE_MAX / SGL_FONT_INDEX_BLOCK_SIZE)
+#define  FONT_INDEX_PRINT_COLUMNS          (16)
+
+
+sgl_font_index_t* font_index_build(const sgl_font_t *font)
+{
+    uint16_t *block = malloc(FONT_INDEX_BLOCK_MAX * sizeof(uint16_t));
+    uint16_t *glyph = malloc(FONT_INDEX_UNICODE_MAX * sizeof(uint16_t));
+    sgl_font_index_t *ret = malloc(sizeof(sgl_font_index_t));
+    int32_t first = -1, last = -1, glyph_num = 0;
+
+    if (block == NULL || glyph == NULL || ret == NULL) {
+        goto fail;
+    }
+
+    for (int32_t b = 0; b < FONT_INDEX_BLOCK_MAX; b++) {
+        uint16_t *entry = &glyph[glyph_num * SGL_FONT_INDEX_BLOCK_SIZE];
+        bool used = false;
+
+        for (int32_t i = 0; i < SGL_FONT_INDEX_BLOCK_SIZE; i++) {
+            int32_t index = sgl_font_search_unicode(font, b * SGL_FONT_INDEX_BLOCK_SIZE + i);
+            entry[i] = index < 0 ? SGL_FONT_INDEX_NONE : index;
+            used = used || index >= 0;
+        }
+
+        block[b] = used ? glyph_num++ : SGL_FONT_INDEX_NONE;
+        if (used) {
+            first = first < 0 ? b : first;
+            last = b;
+        }
+    }
+
+    if (first < 0) {
+        goto fail;
+    }
+
+    /* the unicode blocks before the first one of the font are not kept */
+    memmove(block, block + first, (last - first + 1) * sizeof(uint16_t));
+
+    sgl_font_index_t index = {
+        .block = block,
+        .glyph = glyph,
+        .first_block = first,
+        .block_num = last - first + 1,
+    };
+    memcpy(ret, &index, sizeof(sgl_font_index_t));
+    return ret;
+
+fail:
+    free(block);
+    free(glyph);
+    free(ret);
+    return NULL;
+}
+
+
+void font_index_free(sgl_font_index_t *index)
+{
+    if (index != NULL) {
+        free((void*)index->block);
+        free((void*)index->glyph);
+        free(index);
+    }
+}
+
+
+uint32_t font_index_glyph_num(const sgl_font_index_t *index)
+{
+    uint32_t num = 0;
+
+    for (uint32_t b = 0; b < index->block_num; b++) {
+        if (index->block[b] != SGL_FONT_INDEX_NONE && index->block[b] >= num) {
+            num = index->block[b] + 1;
+        }
+    }
+
+    return num;
+}
+
+
+static void font_index_print_table(FILE *out, const char *name, const char *table,
+                                   const uint16_t *data, uint32_t num)
+{
+    fprintf(out, "static const uint16_t %s_index_%s[%u] = {", name, table, num);
+    for (uint32_t i = 0; i < num; i++) {
+        fprintf(out, "%s0x%04X,", i % FONT_INDEX_PRINT_COLUMNS ? " " : "\n    ", data[i]);
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+
+void font_index_print(FILE *out, const char *name, const sgl_font_index_t *index)
+{
+    uint32_t glyph_num = font_index_glyph_num(index);
+
+    fprintf(out, "/* font index of %s, %u unicode blocks from block %u, %u glyph blocks, %u bytes,\n"
+                 " * generated by sgl_font_index_%s, set .index = &%s_index in the font\n"
+                 " */\n\n",
+            name, index->block_num, index->first_block, glyph_num,
+            (unsigned)((index->block_num + glyph_num * SGL_FONT_INDEX_BLOCK_SIZE) * sizeof(uint16_t)),
+            name, name);
+
+    font_index_print_table(out, name, "block", index->block, index->block_num);
+    font_index_print_table(out, name, "glyph", index->glyph, glyph_num * SGL_FONT_INDEX_BLOCK_SIZE);
+
+    fprintf(out, "const sgl_font_index_t %s_index = {\n", name);
+    fprintf(out, "    .block = %s_index_block,\n", name);
+    fprintf(out, "    .glyph = %s_index_glyph,\n", name);
+    fprintf(out, "    .first_block = %u,\n", index->first_block);
+    fprintf(out, "    .block_num = %u,\n", index->block_num);
+    fprintf(out, "};\n");
+}
@@ -0,0 +1,68 @@
+/* host/tools/font_index.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __FONT_INDEX_H__
+#define __FONT_INDEX_H__
+
+#include <stdio.h>
+#include <sgl.h>
+
+
+/**
+ * @brief build the font index of a font, see sgl_font_index_t
+ * @param font font, its own index is not used
+ * @return font index in the host heap, NULL if out of memory or the font has no character
+ */
+sgl_font_index_t* font_index_build(const sgl_font_t *font);
+
+
+/**
+ * @brief free a font index of font_index_build()
+ * @param index font index
+ * @return none
+ */
+void font_index_free(sgl_font_index_t *index);
+
+
+/**
+ * @brief get the number of glyph blocks of a font index
+ * @param index font index
+ * @return number of glyph blocks
+ */
+uint32_t font_index_glyph_num(const sgl_font_index_t *index);
+
+
+/**
+ * @brief print a font index as C source, the const block and glyph tables and the
+ *        sgl_font_index_t that the font points to with its index field
+ * @param out output file
+ * @param name name of the font, the tables are <name>_index_block, <name>_index_glyph and
+ *        the font index is <name>_index
+ * @param index font index
+ * @return none
+ */
+void font_index_print(FILE *out, const char *name, const sgl_font_index_t *index);
+
+
+#endif // !__FONT_INDEX_H__
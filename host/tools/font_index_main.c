@@ -0,0 +1,74 @@
+/* host/tools/font_index_main.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_font_index_<font> [file]
+ *
+ * Prints the font index of one font as C source, to the file or to stdout. The generator is
+ * built for every font source with the sgl_font_index() function of CMakeLists.txt, the font
+ * source is linked in and FONT_INDEX_FONT is the name of its sgl_font_t. The output is built
+ * with the font, or pasted into its source, and the font points to it with
+ * ".index = &<font>_index", so the characters are found in O(1) whatever the unicode parts
+ * look like.
+ */
+
+#include <stdlib.h>
+#include "font_index.h"
+
+
+#ifndef FONT_INDEX_FONT
+#error "FONT_INDEX_FONT must be the name of the font, e.g. -DFONT_INDEX_FONT=song23"
+#endif
+
+#define  FONT_INDEX_STR_(x)                #x
+#define  FONT_INDEX_STR(x)                 FONT_INDEX_STR_(x)
+
+extern const sgl_font_t FONT_INDEX_FONT;
+
+
+int main(int argc, char *argv[])
+{
+    FILE *out = stdout;
+    sgl_font_index_t *index = font_index_build(&FONT_INDEX_FONT);
+
+    if (index == NULL) {
+        fprintf(stderr, "%s: the font has no character or out of memory\n", FONT_INDEX_STR(FONT_INDEX_FONT));
+        return EXIT_FAILURE;
+    }
+
+    if (argc > 1 && (out = fopen(argv[1], "w")) == NULL) {
+        fprintf(stderr, "%s: can not open %s\n", FONT_INDEX_STR(FONT_INDEX_FONT), argv[1]);
+        font_index_free(index);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "/* generated file, do not edit */\n\n#include <sgl.h>\n\n");
+    font_index_print(out, FONT_INDEX_STR(FONT_INDEX_FONT), index);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    font_index_free(index);
+    return EXIT_SUCCESS;
+}
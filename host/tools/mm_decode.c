@@ -0,0 +1,211 @@
+/* host/tools/mm_decode.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_mm_decode [file]
+ *
+ * Decodes the heap trace that sgl_mm_trace_dump() prints, from the file or from stdin, e.g. a
+ * UART log of the board or the output of "sgl_bench -m". The lines without "mm:" are skipped
+ * and the text before "mm:" is ignored, so the log prefixes do not matter. Every dump is
+ * printed as a report: the heap usage, the fragmentation, that is how much of the free memory
+ * is not in the largest free block, the free block histogram and the owners sorted by bytes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define  DECODE_HIST_NUM                   (8)
+#define  DECODE_OWNER_NUM                  (64)
+
+
+typedef struct decode_owner {
+    char          name[48];
+    unsigned long count;
+    unsigned long bytes;
+    unsigned long peak;
+} decode_owner_t;
+
+
+static struct {
+    unsigned long   total, used, peak, free, largest, blocks, allocs, frees, failed;
+    unsigned long   hist[DECODE_HIST_NUM];
+    decode_owner_t  owner[DECODE_OWNER_NUM];
+    int             owner_num;
+    int             valid;
+} dump;
+
+
+static double decode_percent(unsigned long part, unsigned long whole)
+{
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+
+static int decode_owner_cmp(const void *a, const void *b)
+{
+    const decode_owner_t *x = a, *y = b;
+
+    return (x->bytes < y->bytes) - (x->bytes > y->bytes);
+}
+
+
+/**
+ * @brief get the short name of an owner, "widgets/sgl_button.c" is "button"
+ * @param name file name
+ * @param out short name
+ * @param size size of out
+ * @return none
+ */
+static void decode_owner_name(const char *name, char *out, size_t size)
+{
+    size_t len;
+
+    if (strncmp(name, "sgl_", 4) == 0) {
+        name += 4;
+    }
+
+    snprintf(out, size, "%s", name);
+    len = strlen(out);
+    if (len > 2 && strcmp(out + len - 2, ".c") == 0) {
+        out[len - 2] = '\0';
+    }
+}
+
+
+static void decode_print(void)
+{
+    static const char *bins[DECODE_HIST_NUM] = { "<16", "<32", "<64", "<128", "<256", "<512", "<1K", ">=1K" };
+    char name[48];
+
+    printf("heap    total %lu  used %lu (%.1f%%)  peak %lu (%.1f%%)\n",
+           dump.total, dump.used, decode_percent(dump.used, dump.total),
+           dump.peak, decode_percent(dump.peak, dump.total));
+    printf("free    %lu in %lu blocks  largest %lu  fragmentation %.1f%%\n",
+           dump.free, dump.blocks, dump.largest,
+           dump.free ? 100.0 - decode_percent(dump.largest, dump.free) : 0.0);
+    printf("calls   alloc %lu  free %lu  failed %lu\n", dump.allocs, dump.frees, dump.failed);
+
+    printf("blocks ");
+    for (int i = 0; i < DECODE_HIST_NUM; i++) {
+        printf(" %6s", bins[i]);
+    }
+    printf("\n       ");
+    for (int i = 0; i < DECODE_HIST_NUM; i++) {
+        printf(" %6lu", dump.hist[i]);
+    }
+    printf("\n");
+
+    qsort(dump.owner, dump.owner_num, sizeof(decode_owner_t), decode_owner_cmp);
+    printf("%-20s %6s %8s %8s\n", "owner", "count", "bytes", "peak");
+    for (int i = 0; i < dump.owner_num; i++) {
+        decode_owner_name(dump.owner[i].name, name, sizeof(name));
+        printf("%-20s %6lu %8lu %8lu\n", name, dump.owner[i].count, dump.owner[i].bytes, dump.owner[i].peak);
+    }
+    printf("\n");
+}
+
+
+/**
+ * @brief decode one line of the dump
+ * @param line text after "mm:"
+ * @return 0 if success, -1 if the line is broken
+ */
+static int decode_line(const char *line)
+{
+    if (strncmp(line, "v1 ", 3) == 0) {
+        memset(&dump, 0, sizeof(dump));
+        dump.valid = sscanf(line + 3, "%lx %lx %lx %lx %lx %lx %lx %lx %lx",
+                            &dump.total, &dump.used, &dump.peak, &dump.free, &dump.largest,
+                            &dump.blocks, &dump.allocs, &dump.frees, &dump.failed) == 9;
+        return dump.valid ? 0 : -1;
+    }
+
+    if (!dump.valid) {
+        return -1;
+    }
+
+    if (strncmp(line, "h ", 2) == 0) {
+        const char *p = line + 2;
+        char *end;
+
+        for (int i = 0; i < DECODE_HIST_NUM; i++, p = end) {
+            dump.hist[i] = strtoul(p, &end, 16);
+            if (end == p) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    if (strncmp(line, "o ", 2) == 0 && dump.owner_num < DECODE_OWNER_NUM) {
+        decode_owner_t *owner = &dump.owner[dump.owner_num];
+
+        if (sscanf(line + 2, "%47s %lx %lx %lx", owner->name, &owner->count, &owner->bytes, &owner->peak) != 4) {
+            return -1;
+        }
+        dump.owner_num ++;
+        return 0;
+    }
+
+    if (strncmp(line, "end", 3) == 0) {
+        decode_print();
+        dump.valid = 0;
+        return 0;
+    }
+
+    return -1;
+}
+
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    char line[256];
+    int bad = 0;
+
+    if (argc > 1 && (in = fopen(argv[1], "r")) == NULL) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        const char *p = strstr(line, "mm:");
+
+        if (p != NULL && decode_line(p + 3)) {
+            bad ++;
+        }
+    }
+
+    if (bad) {
+        fprintf(stderr, "sgl_mm_decode: %d broken lines\n", bad);
+    }
+
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
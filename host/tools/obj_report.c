@@ -0,0 +1,69 @@
+/* host/tools/obj_report.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * usage: sgl_obj_report
+ *
+ * Memory report of the object types, the size of every type with the pointer links and in
+ * the compact layout of CONFIG_SGL_OBJ_COMPACT, and how many of them fit in the sgl heap of
+ * CONFIG_SGL_HEAP_MEMORY_SIZE bytes. Every heap block is counted with 8 bytes of head and
+ * 8 bytes alignment, like lwmem on the board. The sizes are the ones of the host, the
+ * pointers of the board are half as big, so the savings there are smaller in bytes.
+ */
+
+#include <stdio.h>
+#include <sgl.h>
+#include "obj_report.h"
+
+
+#define OBJ_REPORT_ROW(name, type)         { name, sizeof(type) },
+
+static const struct {
+    const char *name;
+    size_t     size;
+} obj_report_compact[] = { OBJ_REPORT_TYPES(OBJ_REPORT_ROW) };
+
+
+static size_t obj_report_fit(size_t size)
+{
+    return CONFIG_SGL_HEAP_MEMORY_SIZE / (((size + 7) & ~(size_t)7) + 8);
+}
+
+
+int main(void)
+{
+    if (!CONFIG_SGL_OBJ_COMPACT) {
+        printf("CONFIG_SGL_OBJ_COMPACT is 0, both columns are the full layout\n");
+    }
+
+    printf("%-12s %6s %8s %6s %6s %9s %9s\n", "type", "full", "compact", "saved", "%", "fit full", "fit comp");
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(obj_report_compact); i++) {
+        size_t full = obj_report_full[i], compact = obj_report_compact[i].size;
+
+        printf("%-12s %6zu %8zu %6zu %5.1f%% %9zu %9zu\n", obj_report_compact[i].name, full, compact,
+               full - compact, 100.0 * (full - compact) / full, obj_report_fit(full), obj_report_fit(compact));
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+/* host/tools/obj_report.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __OBJ_REPORT_H__
+#define __OBJ_REPORT_H__
+
+#include <stddef.h>
+
+
+/* every object type of sgl.h, X(name, type) */
+#define OBJ_REPORT_TYPES(X)                                     \
+    X("obj",         sgl_obj_t)                                 \
+    X("page",        sgl_page_t)                                \
+    X("line",        sgl_line_t)                                \
+    X("rectangle",   sgl_rectangle_t)                           \
+    X("circle",      sgl_circle_t)                              \
+    X("ring",        sgl_ring_t)                                \
+    X("arc",         sgl_arc_t)                                 \
+    X("button",      sgl_button_t)                              \
+    X("slider",      sgl_slider_t)                              \
+    X("progress",    sgl_progress_t)                            \
+    X("label",       sgl_label_t)                               \
+    X("switch",      sgl_switch_t)                              \
+    X("msgbox",      sgl_msgbox_t)                              \
+    X("textline",    sgl_textline_t)                            \
+    X("textbox",     sgl_textbox_t)                             \
+    X("checkbox",    sgl_checkbox_t)                            \
+    X("icon",        sgl_icon_t)                                \
+    X("numberkbd",   sgl_numberkbd_t)                           \
+    X("keyboard",    sgl_keyboard_t)                            \
+    X("unzip_img",   sgl_unzip_img_t)                           \
+    X("led",         sgl_led_t)                                 \
+    X("2dball",      sgl_2dball_t)                              \
+    X("scroll",      sgl_scroll_t)                              \
+    X("dropdown",    sgl_dropdown_t)                            \
+    X("scope",       sgl_scope_t)                               \
+    X("ext_img",     sgl_ext_img_t)                             \
+    X("polygon",     sgl_polygon_t)                             \
+    X("box",         sgl_box_t)                                 \
+    X("canvas",      sgl_canvas_t)                              \
+    X("bar",         sgl_bar_t)                                 \
+    X("win",         sgl_win_t)
+
+
+/* sizes of the object types with the pointer links, from obj_report_full.c */
+extern const size_t obj_report_full[];
+
+
+#endif // !__OBJ_REPORT_H__
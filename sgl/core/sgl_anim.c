@@ -34,9 +34,17 @@
 sgl_anim_ctx_t sgl_anim_ctx = {
     .anim_list_head = NULL,
     .anim_list_tail = NULL,
+    .delay_list_head = NULL,
+    .iter = NULL,
 };
 
 
+#if (CONFIG_SGL_ANIM_POOL_SIZE)
+/* static animation objects, sgl_anim_create() uses them instead of heap */
+static sgl_anim_t sgl_anim_pool[CONFIG_SGL_ANIM_POOL_SIZE];
+#endif
+
+
 /**
  * @brief  Animation static initialization
  * @param  anim - Animation object
@@ -44,12 +52,15 @@ sgl_anim_ctx_t sgl_anim_ctx = {
  */
 void sgl_anim_init(sgl_anim_t *anim)
 {
+    anim->prev = NULL;
     anim->next = NULL;
     anim->data = NULL;
     anim->act_delay = 0;
     anim->act_duration = 0;
     anim->start_value = 0;
     anim->end_value = 0;
+    anim->start_time = 0;
+    anim->last_value = 0;
 
     anim->path_cb = NULL;
     anim->path_algo = NULL;
@@ -57,21 +68,50 @@ void sgl_anim_init(sgl_anim_t *anim)
     anim->finish_cb = NULL;
     anim->auto_free = 0;
     anim->finished = 1;
+    anim->delayed = 0;
+    anim->value_valid = 0;
+    anim->restarted = 0;
 }
 
 
 /**
  * @brief dynamic alloc animation object with initialization
  * @param  none
- * @return animation object
+ * @return animation object, NULL if no memory
+ * @note   if CONFIG_SGL_ANIM_POOL_SIZE is not 0, the object is got from the static pool
 */
 sgl_anim_t* sgl_anim_create(void)
 {
-    sgl_anim_t *anim = sgl_malloc(sizeof(sgl_anim_t));
+    sgl_anim_t *anim = NULL;
+
+#if (CONFIG_SGL_ANIM_POOL_SIZE)
+    if (sgl_anim_ctx.free_list != NULL) {
+        anim = sgl_anim_ctx.free_list;
+        sgl_anim_ctx.free_list = anim->next;
+    }
+    else if (sgl_anim_ctx.pool_used < CONFIG_SGL_ANIM_POOL_SIZE) {
+        anim = &sgl_anim_pool[sgl_anim_ctx.pool_used++];
+    }
+    else {
+        SGL_LOG_ERROR("sgl_anim_create: animation pool is empty");
+        return NULL;
+    }
+#elif (CONFIG_SGL_PAGE_REGION)
+    /* the animation may live longer than the page that is being built, keep it in the heap */
+    sgl_mm_region_t *region = sgl_mm_region_enter(NULL);
+    anim = sgl_malloc(sizeof(sgl_anim_t));
+    sgl_mm_region_enter(region);
+    if (anim == NULL) {
+        SGL_LOG_ERROR("sgl_anim_create: malloc failed");
+        return NULL;
+    }
+#else
+    anim = sgl_malloc(sizeof(sgl_anim_t));
     if (anim == NULL) {
         SGL_LOG_ERROR("sgl_anim_create: malloc failed");
         return NULL;
     }
+#endif
 
     sgl_anim_init(anim);
     return anim;
@@ -79,76 +119,145 @@ sgl_anim_t* sgl_anim_create(void)
 
 
 /**
- * @brief add animation object to animation list
+ * @brief give animation object back to the pool or heap
+ * @param  anim animation object
+ * @return none
+*/
+static void sgl_anim_free(sgl_anim_t *anim)
+{
+#if (CONFIG_SGL_ANIM_POOL_SIZE)
+    SGL_ASSERT(anim >= sgl_anim_pool && anim < sgl_anim_pool + CONFIG_SGL_ANIM_POOL_SIZE);
+    anim->next = sgl_anim_ctx.free_list;
+    sgl_anim_ctx.free_list = anim;
+#else
+    sgl_free(anim);
+#endif
+}
+
+
+/**
+ * @brief add animation object to the tail of running list
  * @param  anim animation object
  * @return none
 */
 static void sgl_anim_add(sgl_anim_t *anim)
 {
+    anim->prev = sgl_anim_ctx.anim_list_tail;
+    anim->next = NULL;
+    anim->delayed = 0;
+
     if (sgl_anim_ctx.anim_list_tail != NULL) {
         sgl_anim_ctx.anim_list_tail->next = anim;
-        sgl_anim_ctx.anim_list_tail = anim;
     }
     else {
         sgl_anim_ctx.anim_list_head = anim;
-        sgl_anim_ctx.anim_list_tail = anim;
     }
+    sgl_anim_ctx.anim_list_tail = anim;
+}
 
-    anim->next = NULL;
-    anim->finished = 0;
+
+/**
+ * @brief add animation object to delayed list, the list is ordered by start time
+ * @param  anim animation object
+ * @return none
+ * @note   the animations with same start time keep the order that they are started
+*/
+static void sgl_anim_add_delayed(sgl_anim_t *anim)
+{
+    sgl_anim_t *prev = NULL, *pos = sgl_anim_ctx.delay_list_head;
+
+    /* tick may wrap around, so compare the difference */
+    while (pos != NULL && (int32_t)(pos->start_time - anim->start_time) <= 0) {
+        prev = pos;
+        pos = pos->next;
+    }
+
+    anim->prev = prev;
+    anim->next = pos;
+    anim->delayed = 1;
+
+    if (prev != NULL) {
+        prev->next = anim;
+    }
+    else {
+        sgl_anim_ctx.delay_list_head = anim;
+    }
+
+    if (pos != NULL) {
+        pos->prev = anim;
+    }
 }
 
 
 /**
- * @brief remove animation object from animation list
+ * @brief remove animation object from running list or delayed list
  * @param  anim animation object
  * @return none
 */
 static void sgl_anim_remove(sgl_anim_t *anim)
 {
     SGL_ASSERT(anim != NULL);
-    sgl_anim_t *prev = NULL;
 
-    if (sgl_anim_ctx.anim_list_head == anim) {
-        sgl_anim_ctx.anim_list_head = anim->next;
-        if (sgl_anim_ctx.anim_list_head == NULL) {
-            sgl_anim_ctx.anim_list_tail = NULL;
-        }
-        return;
+    /* keep the walk of sgl_anim_task() valid */
+    if (sgl_anim_ctx.iter == anim) {
+        sgl_anim_ctx.iter = anim->next;
     }
 
-    prev = sgl_anim_ctx.anim_list_head;
-    while (prev != NULL && prev->next != anim) {
-        prev = prev->next;
+    if (anim->prev != NULL) {
+        anim->prev->next = anim->next;
     }
-
-    if (prev == NULL) {
-        return;
+    else if (anim->delayed) {
+        sgl_anim_ctx.delay_list_head = anim->next;
+    }
+    else {
+        sgl_anim_ctx.anim_list_head = anim->next;
     }
-    prev->next = anim->next;
 
-    if (anim == sgl_anim_ctx.anim_list_tail) {
-        sgl_anim_ctx.anim_list_tail = prev;
+    if (anim->next != NULL) {
+        anim->next->prev = anim->prev;
+    }
+    else if (!anim->delayed) {
+        sgl_anim_ctx.anim_list_tail = anim->prev;
     }
+
+    anim->prev = NULL;
+    anim->next = NULL;
+    anim->delayed = 0;
 }
 
 
 /**
- * @brief start animation
+ * @brief start animation, it is started again if it is running
  * @param  anim animation object
- * @para  repeat_cnt repeat count of animation
+ * @para  repeat_cnt repeat count of animation, 0 means stop it
  * @return none
+ * @note   the animation starts after the active delay
 */
 void sgl_anim_start(sgl_anim_t *anim, uint32_t repeat_cnt)
 {
     SGL_ASSERT(anim != NULL);
-    if (anim->finished && repeat_cnt) {
-        sgl_anim_add(anim);
-        anim->finished = 0;
+
+    if (!anim->finished) {
+        sgl_anim_remove(anim);
+        anim->finished = 1;
     }
 
-    anim->act_delay = sgl_tick_get();
     anim->repeat_cnt = repeat_cnt & SGL_ANIM_REPEAT_LOOP;
+    if (anim->repeat_cnt == 0) {
+        return;
+    }
+
+    anim->finished = 0;
+    anim->value_valid = 0;
+    anim->restarted = 1;
+    anim->start_time = sgl_tick_get() + anim->act_delay;
+
+    if (anim->act_delay) {
+        sgl_anim_add_delayed(anim);
+    }
+    else {
+        sgl_anim_add(anim);
+    }
 }
 
 
@@ -164,7 +273,6 @@ void sgl_anim_stop(sgl_anim_t *anim)
         sgl_anim_remove(anim);
         anim->finished = 1;
     }
-    anim->act_delay = 0;
 }
 
 
@@ -179,36 +287,56 @@ void sgl_anim_delete(sgl_anim_t *anim)
     if (!anim->finished) {
         sgl_anim_stop(anim);
     } 
-    sgl_free(anim);
+    sgl_anim_free(anim);
 }
 
 
 /**
- * @brief animation task, it will foreach all animation
+ * @brief animation task, it will foreach all running animation
  * @param  none
  * @return none
- * @note   this function should be called in sgl_task()
+ * @note   this function should be called in sgl_task(), the delayed animations are moved to
+ *         running list when their start time comes, only the head of delayed list is checked
  */
 void sgl_anim_task(void)
 {
     int32_t value = 0;
-    uint32_t elaps_time = 0, act_time = 0;
-    sgl_anim_t *anim = sgl_anim_ctx.anim_list_head, *next = NULL;
+    uint32_t elaps_time = 0, act_time = sgl_frame_get_display_tick();
+    sgl_anim_t *anim = NULL;
 
-    while (anim != NULL) {
-        act_time = sgl_tick_get();
+    while (sgl_anim_ctx.delay_list_head != NULL && (int32_t)(act_time - sgl_anim_ctx.delay_list_head->start_time) >= 0) {
+        anim = sgl_anim_ctx.delay_list_head;
+        sgl_anim_remove(anim);
+        sgl_anim_add(anim);
+    }
 
-        if(act_time < anim->act_delay) {
+    for (anim = sgl_anim_ctx.anim_list_head; anim != NULL; anim = sgl_anim_ctx.iter) {
+        sgl_anim_ctx.iter = anim->next;
+
+        /* an animation that a callback has started after act_time waits for the next task */
+        if ((int32_t)(act_time - anim->start_time) < 0) {
             continue;
         }
 
-        elaps_time = act_time - anim->act_delay;
+        elaps_time = act_time - anim->start_time;
+        anim->restarted = 0;
 
         /* check callback function for debug */
         SGL_ASSERT(anim->path_cb != NULL);
         SGL_ASSERT(anim->path_algo != NULL);
         value = anim->path_algo(sgl_min(elaps_time, anim->act_duration), anim->act_duration, anim->start_value, anim->end_value);
-        anim->path_cb(anim, value);
+
+        /* nothing to do if the value is not changed since last tick */
+        if (!anim->value_valid || value != anim->last_value) {
+            anim->last_value = value;
+            anim->value_valid = 1;
+            anim->path_cb(anim, value);
+        }
+
+        /* the callback has started it again, its start time and repeat count are new */
+        if (anim->restarted) {
+            continue;
+        }
 
         if (elaps_time > anim->act_duration) {
             if (anim->repeat_cnt != SGL_ANIM_REPEAT_LOOP) {
@@ -219,24 +347,50 @@ void sgl_anim_task(void)
                 anim->finish_cb(anim);
             }
 
+            if (anim->restarted) {
+                continue;
+            }
+
             /* remove anim object if repeat count is 0 */
             if (anim->repeat_cnt == 0) {
                 sgl_anim_stop(anim);
 
                 /* if animation is auto free, free it */
                 if (anim->auto_free) {
-                    next = anim->next;
-                    sgl_free(anim);
-                    anim = next;
-                    continue;
+                    sgl_anim_free(anim);
                 }
+                continue;
             }
 
-            anim->act_delay += anim->act_duration;
+            anim->start_time += anim->act_duration;
         }
+    }
+
+    sgl_anim_ctx.iter = NULL;
+}
 
-        anim = anim->next;
+
+/**
+ * @brief  get the time until sgl_anim_task() has work to do
+ * @param  now  current tick milliseconds
+ * @return 0 if an animation is running, the time until the first delayed animation starts,
+ *         or SGL_WAIT_FOREVER if there is no animation
+ * @note   the delayed list is ordered by start time, so only its head is checked
+ */
+uint32_t sgl_anim_get_wait(uint32_t now)
+{
+    int32_t wait;
+
+    if (sgl_anim_ctx.anim_list_head != NULL) {
+        return 0;
     }
+
+    if (sgl_anim_ctx.delay_list_head != NULL) {
+        wait = (int32_t)(sgl_anim_ctx.delay_list_head->start_time - now);
+        return wait > 0 ? (uint32_t)wait : 0;
+    }
+
+    return SGL_WAIT_FOREVER;
 }
 
 
@@ -45,10 +45,94 @@ const uint8_t sgl_opa4_table[16] = {0,  17, 34,  51, 68, 85, 102, 119, 136, 153,
 const uint8_t sgl_opa2_table[4]  = {0, 85, 170, 255};
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+/**
+ * the memory pool, it is word aligned and public, because the objects are in it and their
+ * tree links are word offsets in it, see sgl_obj_to_link()
+*/
+uint32_t sgl_obj_heap[(CONFIG_SGL_HEAP_MEMORY_SIZE + 3) / 4];
+#define  sgl_mem_pool                       sgl_obj_heap
+
+/* the words at the start of the heap that are not given to the allocator, so that no object
+ * has the link 0, two words keep the 8 bytes alignment of the heap */
+#define  SGL_OBJ_HEAP_RESERVED              2
+
+
+/**
+ * the construct functions of all object types, sgl_obj_t.cls is an index of it, 0 is NULL
+ */
+sgl_construct_fn_t sgl_obj_class[CONFIG_SGL_OBJ_CLASS_NUM];
+
+
+/**
+ * side table of the rarely used object fields, the entries that do not fit in it are allocated
+ * from the heap and kept in the sgl_obj_side_more list
+ * @obj: link of the object, 0 if the entry is free
+ * @data: event data
+ * @name: object name
+ * @next: next entry of the sgl_obj_side_more list
+ */
+static struct sgl_obj_side {
+    sgl_obj_link_t  obj;
+    void            *data;
+#if (CONFIG_SGL_OBJ_USE_NAME)
+    const char      *name;
+#endif
+    struct sgl_obj_side *next;
+} sgl_obj_side[CONFIG_SGL_OBJ_SIDE_NUM];
+static struct sgl_obj_side *sgl_obj_side_more = NULL;
+#else
 /**
  * the memory pool, it will be used to allocate memory for the page pool
 */
 static uint8_t sgl_mem_pool[CONFIG_SGL_HEAP_MEMORY_SIZE];
+#endif
+
+
+#if (CONFIG_SGL_DRAW_SCRATCH_SIZE)
+/**
+ * the scratch arena of draw code, it is reset after every frame, see sgl_scratch_alloc()
+ * @buffer: arena memory, it is 8 bytes aligned
+ * @top: offset of the free space
+ * @last: offset of the last buffer, it is given back at once by sgl_scratch_free()
+ * @peak: high water mark of top
+ * @fallback: number of buffers taken from heap
+*/
+static struct {
+    uint64_t  buffer[(CONFIG_SGL_DRAW_SCRATCH_SIZE + 7) / 8];
+    size_t    top;
+    size_t    last;
+    size_t    peak;
+    uint32_t  fallback;
+} sgl_scratch;
+#endif
+
+
+#if (CONFIG_SGL_DRAW_LIST_SIZE && !CONFIG_SGL_USE_FBDEV_VRAM)
+/**
+ * the display list of a dirty area, the visible objects that overlap the area in paint order,
+ * the slices of the area are drawn from it instead of walking the object tree, see draw_list_build()
+ * @obj: object to draw
+ * @y1: first row of the object in the dirty area
+ * @y2: last row of the object in the dirty area
+ * @end: index after the last child of the object, a slice that the object misses skips them too
+ * @depth: depth of the object in the tree, only used to build the list
+ * @wide: the object covers the full width of the dirty area
+ * @opaque: 0 if it is not asked yet, 1 if the object is not opaque, 2 if it is
+*/
+static struct {
+    struct {
+        sgl_obj_t  *obj;
+        int16_t    y1;
+        int16_t    y2;
+        uint16_t   end;
+        uint8_t    depth;
+        uint8_t    wide : 1;
+        uint8_t    opaque : 2;
+    } item[CONFIG_SGL_DRAW_LIST_SIZE];
+    uint16_t  num;
+} sgl_draw_list;
+#endif
 
 
 /**
@@ -90,8 +174,16 @@ int sgl_fbdev_register(sgl_fbinfo_t *fbinfo)
     sgl_system.fbdev.surf.w = fbinfo->xres;
 
     sgl_system.tick_ms = 0;
-    sgl_system.fbdev.fb_status = 3;
+    sgl_system.fbdev.fb_ready[0] = 1;
+    sgl_system.fbdev.fb_ready[1] = 1;
     sgl_system.fbdev.fb_swap = 0;
+    sgl_system.fbdev.fb_flush = 0;
+    sgl_system.fbdev.draw_passes = 0;
+
+#if (CONFIG_SGL_FRAME_PACING)
+    memset(&sgl_system.pacing, 0, sizeof(sgl_pacing_t));
+    sgl_system.pacing.interval = 1;
+#endif
 
     return 0;
 }
@@ -129,6 +221,209 @@ uint8_t sgl_pixmal_get_bytes_per_pixel(const sgl_pixmap_t *pixmap)
 }
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+/**
+ * @brief set the construct function of an object, its class is registered at the first time
+ * @param obj point to object
+ * @param fn construct function
+ * @return none
+ */
+void sgl_obj_set_construct_fn(sgl_obj_t *obj, sgl_construct_fn_t fn)
+{
+    int i;
+
+    obj->cls = 0;
+    if (fn == NULL) {
+        return;
+    }
+
+    for (i = 1; i < CONFIG_SGL_OBJ_CLASS_NUM && sgl_obj_class[i] != NULL; i++) {
+        if (sgl_obj_class[i] == fn) {
+            obj->cls = i;
+            return;
+        }
+    }
+
+    if (i == CONFIG_SGL_OBJ_CLASS_NUM) {
+        SGL_LOG_ERROR("sgl_obj_set_construct_fn: class table is full, increase CONFIG_SGL_OBJ_CLASS_NUM");
+        SGL_ASSERT(0);
+        return;
+    }
+
+    sgl_obj_class[i] = fn;
+    obj->cls = i;
+}
+
+
+/**
+ * @brief find the side table entry of an object
+ * @param obj point to object
+ * @param add true to take a free entry if the object has none
+ * @return the entry, NULL if not found or out of memory
+ * @note when the table is full, the new entry is allocated from the heap
+ */
+static struct sgl_obj_side* sgl_obj_side_get(sgl_obj_t *obj, bool add)
+{
+    sgl_obj_link_t link = sgl_obj_to_link(obj);
+    struct sgl_obj_side *side = NULL;
+
+    if (obj->side == 0 && !add) {
+        return NULL;
+    }
+
+    for (int i = 0; i < CONFIG_SGL_OBJ_SIDE_NUM; i++) {
+        if (sgl_obj_side[i].obj == link && obj->side) {
+            return &sgl_obj_side[i];
+        }
+        if (sgl_obj_side[i].obj == 0 && side == NULL) {
+            side = &sgl_obj_side[i];
+        }
+    }
+
+    if (obj->side) {
+        for (struct sgl_obj_side *more = sgl_obj_side_more; more != NULL; more = more->next) {
+            if (more->obj == link) {
+                return more;
+            }
+        }
+    }
+
+    if (!add) {
+        return NULL;
+    }
+
+    if (side != NULL) {
+        memset(side, 0, sizeof(struct sgl_obj_side));
+        side->obj = link;
+        return side;
+    }
+
+#if (CONFIG_SGL_PAGE_REGION)
+    /* the entry is freed with the object, keep it out of the page region */
+    sgl_mm_region_t *region = sgl_mm_region_enter(NULL);
+    side = sgl_malloc(sizeof(struct sgl_obj_side));
+    sgl_mm_region_enter(region);
+#else
+    side = sgl_malloc(sizeof(struct sgl_obj_side));
+#endif
+    if (side == NULL) {
+        SGL_LOG_ERROR("sgl_obj_side_get: malloc failed");
+        SGL_ASSERT(0);
+        return NULL;
+    }
+
+    memset(side, 0, sizeof(struct sgl_obj_side));
+    side->obj = link;
+    side->next = sgl_obj_side_more;
+    sgl_obj_side_more = side;
+    return side;
+}
+
+
+/**
+ * @brief free the side table entry of an object
+ * @param obj point to object
+ * @return none
+ */
+static void sgl_obj_side_free(sgl_obj_t *obj)
+{
+    struct sgl_obj_side *side = sgl_obj_side_get(obj, false);
+
+    if (side != NULL && side >= sgl_obj_side && side < sgl_obj_side + CONFIG_SGL_OBJ_SIDE_NUM) {
+        side->obj = 0;
+    }
+    else if (side != NULL) {
+        /* the entry is in the heap */
+        struct sgl_obj_side **prev = &sgl_obj_side_more;
+
+        while (*prev != side) {
+            prev = &(*prev)->next;
+        }
+        *prev = side->next;
+        sgl_free(side);
+    }
+    obj->side = 0;
+}
+
+
+/**
+ * @brief get the event data of an object from the side table
+ * @param obj point to object
+ * @return event data, NULL if it is not set
+ */
+void* sgl_obj_get_event_data(sgl_obj_t *obj)
+{
+    struct sgl_obj_side *side;
+
+    if ((obj->side & SGL_OBJ_SIDE_DATA) == 0) {
+        return NULL;
+    }
+
+    side = sgl_obj_side_get(obj, false);
+    return side ? side->data : NULL;
+}
+
+
+/**
+ * @brief set the event data of an object in the side table
+ * @param obj point to object
+ * @param data event data
+ * @return none
+ */
+void sgl_obj_set_event_data(sgl_obj_t *obj, void *data)
+{
+    struct sgl_obj_side *side;
+
+    if (data == NULL && (obj->side & SGL_OBJ_SIDE_DATA) == 0) {
+        return;
+    }
+
+    side = sgl_obj_side_get(obj, true);
+    if (side != NULL) {
+        side->data = data;
+        obj->side |= SGL_OBJ_SIDE_DATA;
+    }
+}
+
+
+#if (CONFIG_SGL_OBJ_USE_NAME)
+/**
+ * @brief set object name
+ * @param obj The object to set the name
+ * @param name The name to set.
+ * @return None.
+ */
+void sgl_obj_set_name(sgl_obj_t *obj, const char *name)
+{
+    struct sgl_obj_side *side = sgl_obj_side_get(obj, true);
+
+    if (side != NULL) {
+        side->name = name;
+        obj->side |= SGL_OBJ_SIDE_NAME;
+    }
+}
+
+
+/**
+ * @brief get object name
+ * @param obj The object
+ * @return name of the object, NULL if it is not set
+ */
+const char* sgl_obj_get_name(sgl_obj_t *obj)
+{
+    struct sgl_obj_side *side;
+
+    if ((obj->side & SGL_OBJ_SIDE_NAME) == 0) {
+        return NULL;
+    }
+
+    side = sgl_obj_side_get(obj, false);
+    return side ? side->name : NULL;
+}
+#endif
+#endif // !CONFIG_SGL_OBJ_COMPACT
+
+
 /**
  * @brief add object to parent
  * @param parent: pointer of parent object
@@ -138,19 +433,29 @@ uint8_t sgl_pixmal_get_bytes_per_pixel(const sgl_pixmap_t *pixmap)
 void sgl_obj_add_child(sgl_obj_t *parent, sgl_obj_t *obj)
 {
     SGL_ASSERT(parent != NULL && obj != NULL);
-    sgl_obj_t *tail = parent->child;
+#if (CONFIG_SGL_OBJ_COMPACT)
+    /* the link of an object is its offset in the heap, it can not be anywhere else */
+    SGL_ASSERT((uint32_t*)obj >= sgl_obj_heap + SGL_OBJ_HEAP_RESERVED && (uint32_t*)obj < sgl_obj_heap + SGL_ARRAY_SIZE(sgl_obj_heap));
+#endif
+    sgl_obj_t *tail = sgl_obj_from_link(parent->child);
 
-    if (parent->child) {
-        while (tail->sibling != NULL) {
-            tail = tail->sibling;
+    if (tail != NULL) {
+        while (sgl_obj_from_link(tail->sibling) != NULL) {
+            tail = sgl_obj_from_link(tail->sibling);
         };
-        tail->sibling = obj;
+        tail->sibling = sgl_obj_to_link(obj);
     }
     else {
-        parent->child = obj;
+        parent->child = sgl_obj_to_link(obj);
     }
 
-    obj->parent = parent;
+    obj->parent = sgl_obj_to_link(parent);
+    sgl_event_hit_grid_invalidate();
+
+    /* the new parent must lead the dirty area pass to the marks of the object */
+    if (obj->subtree) {
+        sgl_obj_set_subtree(parent);
+    }
 }
 
 
@@ -164,13 +469,13 @@ void sgl_obj_remove(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
 
-    sgl_obj_t *parent = obj->parent;
+    sgl_obj_t *parent = sgl_obj_from_link(obj->parent);
     sgl_obj_t *pos = NULL;
 
-    if (parent->child != obj) {
-        pos = parent->child;
-        while (pos->sibling != obj) {
-            pos = pos->sibling;
+    if (sgl_obj_from_link(parent->child) != obj) {
+        pos = sgl_obj_from_link(parent->child);
+        while (sgl_obj_from_link(pos->sibling) != obj) {
+            pos = sgl_obj_from_link(pos->sibling);
         }
         pos->sibling = obj->sibling;
     }
@@ -178,7 +483,8 @@ void sgl_obj_remove(sgl_obj_t *obj)
         parent->child = obj->sibling;
     }
 
-    obj->sibling = NULL;
+    obj->sibling = sgl_obj_to_link(NULL);
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -195,27 +501,28 @@ void sgl_obj_move_child_pos(sgl_obj_t *obj, int16_t ofs_x, int16_t ofs_y)
 	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
     int top = 0;
 
-    if (obj->child == NULL) {
+    if (sgl_obj_from_link(obj->child) == NULL) {
         return;
     }
-    stack[top++] = obj->child;
+    stack[top++] = sgl_obj_from_link(obj->child);
+    sgl_event_hit_grid_invalidate();
 
     while (top > 0) {
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-        obj->dirty = 1;
+        sgl_obj_set_dirty(obj);
         obj->coords.x1 += ofs_x;
         obj->coords.x2 += ofs_x;
         obj->coords.y1 += ofs_y;
         obj->coords.y2 += ofs_y;
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
 		}
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
 		}
     }
 }
@@ -234,11 +541,12 @@ void sgl_obj_set_abs_pos(sgl_obj_t *obj, int16_t abs_x, int16_t abs_y)
     int16_t x_diff = abs_x - obj->coords.x1;
     int16_t y_diff = abs_y - obj->coords.y1;
 
-    obj->dirty = 1;
+    sgl_obj_set_dirty(obj);
     obj->coords.x1 += x_diff;
     obj->coords.x2 += x_diff;
     obj->coords.y1 += y_diff;
     obj->coords.y2 += y_diff;
+    sgl_event_hit_grid_invalidate();
 
     sgl_obj_move_child_pos(obj, x_diff, y_diff);
 }
@@ -258,6 +566,7 @@ void sgl_obj_size_zoom(sgl_obj_t *obj, int16_t zoom)
     obj->coords.x2 += zoom;
     obj->coords.y1 -= zoom;
     obj->coords.y2 += zoom;
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -270,31 +579,33 @@ void sgl_obj_size_zoom(sgl_obj_t *obj, int16_t zoom)
 void sgl_obj_move_up(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
-    sgl_obj_t *parent = obj->parent;
+    sgl_obj_t *parent = sgl_obj_from_link(obj->parent);
     sgl_obj_t *prev = NULL;
     sgl_obj_t *next = NULL;
 
     /* if the object is the last child, do not move it */
-    if (obj->sibling == NULL) {
+    if (sgl_obj_from_link(obj->sibling) == NULL) {
         return;
     }
-    else if (parent->child == obj) {
+    else if (sgl_obj_from_link(parent->child) == obj) {
         parent->child = obj->sibling;
-        obj->sibling = obj->sibling->sibling;
+        obj->sibling = sgl_obj_from_link(obj->sibling)->sibling;
         /* mark object as dirty */
         sgl_obj_set_dirty(obj);
+        sgl_event_hit_grid_invalidate();
         return;
     }
 
     /* move the object to its next sibling */
     sgl_obj_for_each_child(prev, parent) {
-        if (prev->sibling == obj) {
-            next = obj->sibling;
+        if (sgl_obj_from_link(prev->sibling) == obj) {
+            next = sgl_obj_from_link(obj->sibling);
             obj->sibling = next->sibling;
-            prev->sibling = next;
-            next->sibling = obj;
+            prev->sibling = sgl_obj_to_link(next);
+            next->sibling = sgl_obj_to_link(obj);
             /* mark object as dirty */
             sgl_obj_set_dirty(obj);
+            sgl_event_hit_grid_invalidate();
             return;
         }
     }
@@ -310,17 +621,17 @@ void sgl_obj_move_up(sgl_obj_t *obj)
 void sgl_obj_move_down(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
-    sgl_obj_t *parent = obj->parent;
+    sgl_obj_t *parent = sgl_obj_from_link(obj->parent);
     sgl_obj_t *prev_prev = NULL;
     sgl_obj_t *prev = NULL;
 
-    if (parent->child == obj) {
+    if (sgl_obj_from_link(parent->child) == obj) {
         return;
     }
 
     // Find the previous sibling node (prev) and the node before it (prev_prev)
     sgl_obj_for_each_child(prev, parent) {
-        if (prev->sibling == obj) {
+        if (sgl_obj_from_link(prev->sibling) == obj) {
             break;
         }
         prev_prev = prev;
@@ -328,15 +639,16 @@ void sgl_obj_move_down(sgl_obj_t *obj)
 
     if (prev != NULL) {
         if (prev_prev != NULL) {
-            prev_prev->sibling = obj;
+            prev_prev->sibling = sgl_obj_to_link(obj);
         }
         else {
-            parent->child = obj;
+            parent->child = sgl_obj_to_link(obj);
         }
 
         prev->sibling = obj->sibling;
-        obj->sibling = prev;
+        obj->sibling = sgl_obj_to_link(prev);
         sgl_obj_set_dirty(obj);
+        sgl_event_hit_grid_invalidate();
     }
 }
 
@@ -349,19 +661,19 @@ void sgl_obj_move_down(sgl_obj_t *obj)
  */
 void sgl_obj_move_top(sgl_obj_t *obj)
 {
-    SGL_ASSERT(obj != NULL && obj->parent != NULL);
+    SGL_ASSERT(obj != NULL && sgl_obj_from_link(obj->parent) != NULL);
 
-    sgl_obj_t *parent = obj->parent;
-    sgl_obj_t *prev = NULL, *curr = parent->child, *last = NULL;
+    sgl_obj_t *parent = sgl_obj_from_link(obj->parent);
+    sgl_obj_t *prev = NULL, *curr = sgl_obj_from_link(parent->child), *last = NULL;
 
     /* if the object is the last child, do not move it */
-    if (obj->sibling == NULL) {
+    if (sgl_obj_from_link(obj->sibling) == NULL) {
         return;
     }
 
     while (curr != NULL && curr != obj) {
         prev = curr;
-        curr = curr->sibling;
+        curr = sgl_obj_from_link(curr->sibling);
     }
 
     if (prev == NULL) {
@@ -371,20 +683,21 @@ void sgl_obj_move_top(sgl_obj_t *obj)
         prev->sibling = obj->sibling;
     }
 
-    last = parent->child;
+    last = sgl_obj_from_link(parent->child);
     if (last == NULL) {
-        parent->child = obj;
-        obj->sibling = NULL;
+        parent->child = sgl_obj_to_link(obj);
+        obj->sibling = sgl_obj_to_link(NULL);
     }
     else {
-        while (last->sibling != NULL) {
-            last = last->sibling;
+        while (sgl_obj_from_link(last->sibling) != NULL) {
+            last = sgl_obj_from_link(last->sibling);
         }
-        last->sibling = obj;
-        obj->sibling = NULL;
+        last->sibling = sgl_obj_to_link(obj);
+        obj->sibling = sgl_obj_to_link(NULL);
     }
 
     sgl_obj_set_dirty(obj);
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -397,25 +710,26 @@ void sgl_obj_move_top(sgl_obj_t *obj)
 void sgl_obj_move_bottom(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
-    sgl_obj_t *parent = obj->parent;
+    sgl_obj_t *parent = sgl_obj_from_link(obj->parent);
     sgl_obj_t *prev = NULL;
 
     /* if the object is the first child, do not move it */
-    if (parent->child == obj) {
+    if (sgl_obj_from_link(parent->child) == obj) {
         return;
     }
 
     sgl_obj_for_each_child(prev, parent) {
-        if (prev->sibling == obj) {
+        if (sgl_obj_from_link(prev->sibling) == obj) {
             break;
         }
     }
 
     prev->sibling = obj->sibling;
     obj->sibling = parent->child;
-    parent->child = obj;
+    parent->child = sgl_obj_to_link(obj);
     /* mark object as dirty */
     sgl_obj_set_dirty(obj);
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -436,7 +750,8 @@ void sgl_obj_set_radius(sgl_obj_t *obj, size_t radius)
         radius = sgl_is_odd(d_min) ? d_min / 2 : (d_min - 1) / 2;
     }
 
-    obj->radius = radius & 0xFFF;
+    /* the radius field is 11 bits, its largest value is SGL_RADIUS_INVALID */
+    obj->radius = sgl_min(radius, SGL_RADIUS_INVALID - 1);
 }
 
 
@@ -456,19 +771,19 @@ void sgl_obj_print_name(sgl_obj_t *obj)
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-        if (obj->name == NULL) {
+        if (sgl_obj_get_name(obj) == NULL) {
             SGL_LOG_INFO("[OBJ NAME]: %s", "NULL");
         }
         else {
-            SGL_LOG_INFO("[OBJ NAME]: %s", obj->name);
+            SGL_LOG_INFO("[OBJ NAME]: %s", sgl_obj_get_name(obj));
         }
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
 		}
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
 		}
     }
 }
@@ -497,7 +812,10 @@ static void sgl_page_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             sgl_draw_fill_rect_pixmap(surf, &obj->area, &obj->coords, 0, pixmap, page->alpha);
         }
     }
-    else {
+    else if (evt->type == SGL_EVENT_DRAW_OPAQUE) {
+        *(bool*)evt->param = (page->alpha == SGL_ALPHA_MAX);
+    }
+    else if (evt->type != SGL_EVENT_DESTROYED) {
         if (obj->event_fn) {
             obj->event_fn(evt);
         }
@@ -574,10 +892,10 @@ static sgl_page_t* sgl_page_create(void)
     page->color = SGL_THEME_DESKTOP;
     page->alpha = SGL_ALPHA_MAX;
 
-    obj->parent = obj;
+    obj->parent = sgl_obj_to_link(obj);
     obj->clickable = 0;
-    obj->construct_fn = sgl_page_construct_cb;
-    obj->dirty = 1;
+    sgl_obj_set_construct_fn(obj, sgl_page_construct_cb);
+    sgl_obj_set_dirty(obj);
     obj->page = 1;
     obj->border = 0;
     obj->coords = (sgl_area_t) {
@@ -600,6 +918,66 @@ static sgl_page_t* sgl_page_create(void)
 }
 
 
+#if (CONFIG_SGL_PAGE_REGION)
+/**
+ * @brief create a page with its own memory region
+ * @param size size of the region, the page itself is also cut from it
+ * @return point to the page, NULL if the heap has no block of the size
+ * @note the widgets that are created between sgl_page_region_enter() and sgl_page_region_leave()
+ *       are cut from the region, with their option lists and texts. When the region is full they
+ *       go to the heap. Deleting the page frees the region with one sgl_free(), deleting a single
+ *       widget of the page does not give its memory back before the page is deleted.
+ */
+sgl_obj_t* sgl_page_create_with_region(size_t size)
+{
+    sgl_mm_region_t *region = sgl_mm_region_create(sizeof(sgl_page_t) + size);
+    sgl_mm_region_t *prev;
+    sgl_page_t *page;
+
+    if (region == NULL) {
+        SGL_LOG_ERROR("sgl_page_create_with_region: create region failed");
+        return NULL;
+    }
+
+    prev = sgl_mm_region_enter(region);
+    page = sgl_page_create();
+    sgl_mm_region_enter(prev);
+
+    if (page == NULL) {
+        sgl_mm_region_delete(region);
+        return NULL;
+    }
+
+    page->region = region;
+    return &page->obj;
+}
+
+
+/**
+ * @brief make the region of a page active, the allocations go to it until sgl_page_region_leave()
+ * @param obj point to the page
+ * @return none
+ * @note do not create anything that lives longer than the page while the region is active
+ */
+void sgl_page_region_enter(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL && obj->page == 1);
+    sgl_mm_region_enter(((sgl_page_t*)obj)->region);
+}
+
+
+/**
+ * @brief leave the active page region, the allocations go to the heap again
+ * @param none
+ * @return none
+ */
+void sgl_page_region_leave(void)
+{
+    sgl_mm_region_enter(NULL);
+}
+#endif
+
+
 /**
  * @brief Create an object
  * @param parent parent object
@@ -628,11 +1006,16 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
         }
 
         obj->coords = parent->coords;
-        obj->parent = parent;
+        obj->parent = sgl_obj_to_link(parent);
         obj->event_fn = NULL;
-        obj->event_data = 0;
-        obj->construct_fn = NULL;
-        obj->dirty = 1;
+#if (CONFIG_SGL_OBJ_COMPACT)
+        obj->side = 0;
+#else
+        obj->event_data = NULL;
+#endif
+        sgl_obj_set_construct_fn(obj, NULL);
+        obj->subtree = 0;
+        sgl_obj_set_dirty(obj);
 
         /* init node */
         sgl_obj_node_init(obj);
@@ -652,6 +1035,7 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
 static inline void sgl_dirty_area_init(void)
 {
     sgl_system.fbdev.dirty_num = 0;
+    sgl_system.fbdev.raw_pixels = 0;
 }
 
 
@@ -666,7 +1050,11 @@ int sgl_init(void)
     sgl_obj_t *obj = NULL;
 
     /* init memory pool */
+#if (CONFIG_SGL_OBJ_COMPACT)
+    sgl_mm_init(sgl_obj_heap + SGL_OBJ_HEAP_RESERVED, sizeof(sgl_obj_heap) - SGL_OBJ_HEAP_RESERVED * 4);
+#else
     sgl_mm_init(sgl_mem_pool, sizeof(sgl_mem_pool));
+#endif
 
     /* initialize current context */
     sgl_system.fbdev.active = NULL;
@@ -715,6 +1103,7 @@ void sgl_screen_load(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     sgl_system.fbdev.active = obj;
+    sgl_event_hit_grid_invalidate();
 
     /* initialize dirty area */
     sgl_dirty_area_init();
@@ -804,122 +1193,342 @@ bool sgl_area_selfclip(sgl_area_t *clip, sgl_area_t *area)
 
 
 /**
- * @brief Computes the total boundary expansion (in Manhattan distance) required to merge rectangle b into rectangle a.
- *
- * @param a[in]    Pointer to the b rectangle
- * @param b[in]    Pointer to the a rectangle
- * @return int32_t Total expansion amount (always non-negative)
+ * @brief get the pixel number of an area
+ * @param area [in] Pointer to the area
+ * @return int32_t pixel number
+ */
+static inline int32_t sgl_area_pixels(sgl_area_t *area)
+{
+    return (int32_t)(area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+}
+
+
+/**
+ * @brief get the overlapped pixel number of two areas
+ * @param a [in] Pointer to the first area
+ * @param b [in] Pointer to the second area
+ * @return int32_t overlapped pixel number, 0 if not overlapped
  */
-static inline int32_t sgl_area_growth(sgl_area_t *a, sgl_area_t *b)
+static inline int32_t sgl_area_overlap_pixels(sgl_area_t *a, sgl_area_t *b)
 {
-    return (a->x1 - sgl_min(a->x1, b->x1)) + (sgl_max(a->x2, b->x2) - a->x2)
-           + (a->y1 - sgl_min(a->y1, b->y1)) + (sgl_max(a->y2, b->y2) - a->y2);
+    int32_t w = sgl_min(a->x2, b->x2) - sgl_max(a->x1, b->x1) + 1;
+    int32_t h = sgl_min(a->y2, b->y2) - sgl_max(a->y1, b->y1) + 1;
+
+    return (w > 0 && h > 0) ? w * h : 0;
+}
+
+
+/**
+ * @brief check if area a contains area b
+ * @param a [in] Pointer to the outer area
+ * @param b [in] Pointer to the inner area
+ * @return true if b is inside a
+ */
+static inline bool sgl_area_contains(sgl_area_t *a, sgl_area_t *b)
+{
+    return (a->x1 <= b->x1 && a->y1 <= b->y1 && a->x2 >= b->x2 && a->y2 >= b->y2);
 }
 
 
 /**
- * @brief Quickly determines if two rectangles are close enough to be merged.
+ * @brief estimate the cost to flush an area into screen
  *
- * This fast heuristic is useful in performance-critical contexts (e.g., real-time segmentation or region merging)
- * to avoid excessive fragmentation while preventing merges between distant regions.
+ * The cost is counted in pixels: every pixel of the area is sent once, and every slice of the
+ * area costs CONFIG_SGL_DIRTY_AREA_FLUSH_COST more, that is the window setting of the panel and
+ * the object tree walk of draw_obj_slice. A wide area gets fewer lines per slice.
  *
- * @param a[in] Pointer to the first rectangle
- * @param b[in] Pointer to the second rectangle
- * @return bool true if the rectangles are sufficiently close for merging; false otherwise
+ * @param area [in] Pointer to the area
+ * @return int32_t cost of the area
  */
-static inline bool sgl_merge_determines(sgl_area_t* a, sgl_area_t* b)
+static inline int32_t sgl_dirty_area_cost(sgl_area_t *area)
 {
-    int16_t gap_x = (a->x1 > b->x2) ? (a->x1 - b->x2) : (b->x1 > a->x2) ? (b->x1 - a->x2) : 0;
-    int16_t gap_y = (a->y1 > b->y2) ? (a->y1 - b->y2) : (b->y1 > a->y2) ? (b->y1 - a->y2) : 0;    
-    int16_t threshold = (sgl_min4(a->x2 - a->x1 + 1, a->y2 - a->y1 + 1, b->x2 - b->x1 + 1, b->y2 - b->y1 + 1) >> 2);
+    int32_t w = area->x2 - area->x1 + 1;
+    int32_t h = area->y2 - area->y1 + 1;
+#if (!CONFIG_SGL_USE_FBDEV_VRAM)
+    int32_t lines = sgl_max((int32_t)(sgl_system.fbdev.surf.size / w), 1);
+    int32_t slices = (h + lines - 1) / lines;
+#else
+    int32_t slices = 1;
+#endif
+
+    return w * h + slices * CONFIG_SGL_DIRTY_AREA_FLUSH_COST;
+}
+
+
+/**
+ * @brief get how much cheaper it is to flush two areas as their bounding box
+ * @param a [in] Pointer to the first area
+ * @param b [in] Pointer to the second area
+ * @return int32_t benefit of merge, negative if the two areas should be flushed separately
+ * @note the overlapped pixels are counted once, because the planner cuts them off if the
+ *       two areas are not merged
+ */
+static inline int32_t sgl_dirty_area_merge_benefit(sgl_area_t *a, sgl_area_t *b)
+{
+    sgl_area_t merge;
+    sgl_area_merge(a, b, &merge);
+
+    return sgl_dirty_area_cost(a) + sgl_dirty_area_cost(b) - sgl_area_overlap_pixels(a, b) - sgl_dirty_area_cost(&merge);
+}
+
+
+/**
+ * @brief remove a dirty area, the last dirty area will fill its slot
+ * @param index [in] index of the dirty area
+ * @return none
+ */
+static inline void sgl_dirty_area_remove(int index)
+{
+    sgl_system.fbdev.dirty[index] = sgl_system.fbdev.dirty[--sgl_system.fbdev.dirty_num];
+}
+
+
+/**
+ * @brief merge the pair of dirty areas that has the max merge benefit
+ * @param force [in] merge the best pair even if the benefit is negative
+ * @return true if two areas are merged
+ */
+static bool sgl_dirty_area_merge_best(bool force)
+{
+    sgl_area_t *dirty = sgl_system.fbdev.dirty;
+    int32_t best = INT32_MIN, benefit;
+    int best_i = -1, best_j = -1;
+
+    for (int i = 0; i < sgl_system.fbdev.dirty_num; i++) {
+        for (int j = i + 1; j < sgl_system.fbdev.dirty_num; j++) {
+            benefit = sgl_dirty_area_merge_benefit(&dirty[i], &dirty[j]);
+            if (benefit > best) {
+                best = benefit;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+
+    if (best_i < 0 || (best < 0 && !force)) {
+        return false;
+    }
 
-    return (gap_x <= threshold) && (gap_y <= threshold);
+    sgl_area_selfmerge(&dirty[best_i], &dirty[best_j]);
+    sgl_dirty_area_remove(best_j);
+    return true;
 }
 
 
 /**
  * @brief merge an area into global dirty area
- * 
- * This function calculates how much rectangle 'a' would need to grow in each direction (left, right, top, bottom)
- * to fully enclose both 'a' and 'b'. The result is the sum of the expansions along all four sides.
- * Note: This is not the increase in area, th is a lightweight heuristic for merge cost in bounding-box algorithms.
- * 
+ *
+ * The area is only collected here and areas that are inside another one are dropped, the final
+ * layout is decided by sgl_dirty_area_plan() once per frame. If there is no free slot, the two
+ * areas that are the cheapest to merge are merged to make room for the new one.
+ *
  * @param area [in] Pointer to the area
  * @return none
  */
 void sgl_dirty_area_push(sgl_area_t *area)
 {
     SGL_ASSERT(area != NULL);
-    int32_t best_idx = -1, min_growth = INT32_MAX, growth = INT32_MAX;
+    sgl_area_t *dirty = sgl_system.fbdev.dirty;
+
     /* skip invalid area */
     if (area->x1 > area->x2 || area->y1 > area->y2) {
         return;
     }
 
-    if (sgl_system.fbdev.dirty_num == 0) {
-        sgl_system.fbdev.dirty[0] = *area;
-        sgl_system.fbdev.dirty_num = 1;
-        return;
-    }
-
-    for (uint8_t i = 0; i < sgl_system.fbdev.dirty_num; i++) {
-        if (sgl_merge_determines(&sgl_system.fbdev.dirty[i], area)) {
-            growth = sgl_area_growth(&sgl_system.fbdev.dirty[i], area);
-            if (growth == 0) {
-                /* already contains the area */
-                return;
-            }
-            else if (growth < min_growth) {
-                min_growth = growth;
-                best_idx = i;
-            }
+    for (int i = 0; i < sgl_system.fbdev.dirty_num; i++) {
+        if (sgl_area_contains(&dirty[i], area)) {
+            /* already contains the area */
+            return;
+        }
+        else if (sgl_area_contains(area, &dirty[i])) {
+            /* the new area will take its place */
+            sgl_system.fbdev.raw_pixels -= sgl_area_pixels(&dirty[i]);
+            sgl_dirty_area_remove(i--);
         }
     }
 
-    if (best_idx >= 0) {
-        /* merge object area into best_idx dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[best_idx], area);
-        return;
+    if (sgl_system.fbdev.dirty_num == SGL_DIRTY_AREA_NUM_MAX) {
+        sgl_dirty_area_merge_best(true);
     }
 
-    if (sgl_system.fbdev.dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
-        /* add new dirty area */
-        sgl_system.fbdev.dirty[sgl_system.fbdev.dirty_num++] = *area;
-    } else {
-        /* merge object area into last dirty area */
-        sgl_area_selfmerge(&sgl_system.fbdev.dirty[SGL_DIRTY_AREA_NUM_MAX - 1], area);
-    }
+    sgl_system.fbdev.raw_pixels += sgl_area_pixels(area);
+    dirty[sgl_system.fbdev.dirty_num++] = *area;
 }
 
 
 /**
- * @brief initialize object
- * @param obj object
- * @param parent parent object
- * @return int, 0 means successful, -1 means failed
+ * @brief cut area b into at most 4 pieces that are not overlapped with area a
+ * @param a [in] Pointer to the area that is kept
+ * @param b [in] Pointer to the area that is cut
+ * @param piece [out] pieces of b
+ * @return int number of pieces
  */
-int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+static int sgl_area_subtract(sgl_area_t *a, sgl_area_t *b, sgl_area_t piece[4])
 {
-    SGL_ASSERT(obj != NULL);
+    int num = 0;
+    int16_t y1 = sgl_max(a->y1, b->y1);
+    int16_t y2 = sgl_min(a->y2, b->y2);
 
-    if (parent == NULL) {
-        parent = sgl_screen_act();
-        if (parent == NULL) {
-            SGL_LOG_ERROR("sgl_obj_init: have no active page");
-            return -1;
-        }
+    if (b->y1 < a->y1) {
+        piece[num++] = (sgl_area_t){ .x1 = b->x1, .y1 = b->y1, .x2 = b->x2, .y2 = a->y1 - 1 };
+    }
+    if (b->y2 > a->y2) {
+        piece[num++] = (sgl_area_t){ .x1 = b->x1, .y1 = a->y2 + 1, .x2 = b->x2, .y2 = b->y2 };
+    }
+    if (b->x1 < a->x1) {
+        piece[num++] = (sgl_area_t){ .x1 = b->x1, .y1 = y1, .x2 = a->x1 - 1, .y2 = y2 };
+    }
+    if (b->x2 > a->x2) {
+        piece[num++] = (sgl_area_t){ .x1 = a->x2 + 1, .y1 = y1, .x2 = b->x2, .y2 = y2 };
     }
 
-    /* set essential member */
-    obj->coords = parent->coords;
-    obj->parent = parent;
-    obj->event_fn = NULL;
-    obj->event_data = 0;
-    obj->construct_fn = NULL;
-    obj->dirty = 1;
-    obj->clickable = 0;
+    return num;
+}
 
-    /* init object area to invalid */
+
+/**
+ * @brief cut the first overlapped pair of dirty areas, the smaller one is cut
+ * @param none
+ * @return true if a pair is cut or merged
+ * @note if there are not enough free slots for the pieces, the pair is merged
+ */
+static bool sgl_dirty_area_cut_overlap(void)
+{
+    sgl_area_t *dirty = sgl_system.fbdev.dirty;
+    sgl_area_t piece[4];
+    int num, keep, cut;
+
+    for (int i = 0; i < sgl_system.fbdev.dirty_num; i++) {
+        for (int j = i + 1; j < sgl_system.fbdev.dirty_num; j++) {
+            if (!sgl_area_is_overlap(&dirty[i], &dirty[j])) {
+                continue;
+            }
+
+            keep = sgl_area_pixels(&dirty[i]) >= sgl_area_pixels(&dirty[j]) ? i : j;
+            cut = i + j - keep;
+            num = sgl_area_subtract(&dirty[keep], &dirty[cut], piece);
+
+            if (sgl_system.fbdev.dirty_num + num - 1 > SGL_DIRTY_AREA_NUM_MAX) {
+                sgl_area_selfmerge(&dirty[keep], &dirty[cut]);
+                sgl_dirty_area_remove(cut);
+                return true;
+            }
+
+            sgl_dirty_area_remove(cut);
+            for (int k = 0; k < num; k++) {
+                dirty[sgl_system.fbdev.dirty_num++] = piece[k];
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+#if (CONFIG_SGL_FRAME_PACING)
+/**
+ * @brief sort the dirty areas from top to bottom, like the panel scans
+ * @param none
+ * @return none
+ * @note a frame starts after the TE pulse, when the scan is at the top row, so the flushes stay
+ *       ahead of the scan only if the upper areas are sent first. The planned areas do not
+ *       overlap, the order does not change the pixels
+ */
+static void sgl_dirty_area_sort_scan(void)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    sgl_area_t area;
+    int j;
+
+    for (int i = 1; i < fbdev->dirty_num; i++) {
+        area = fbdev->dirty[i];
+        for (j = i; j > 0 && fbdev->dirty[j - 1].y1 > area.y1; j--) {
+            fbdev->dirty[j] = fbdev->dirty[j - 1];
+        }
+        fbdev->dirty[j] = area;
+    }
+}
+#endif // !CONFIG_SGL_FRAME_PACING
+
+
+/**
+ * @brief plan the dirty areas of current frame before drawing
+ *
+ * Two areas are merged only if flushing their bounding box is cheaper than flushing them
+ * separately, see sgl_dirty_area_cost(). The areas that are still overlapped are cut then,
+ * so that no pixel is drawn and flushed twice in a frame.
+ *
+ * @param none
+ * @return none
+ */
+static void sgl_dirty_area_plan(void)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    bool changed = true;
+    int32_t pixels = 0;
+
+    /* every pass merges areas or cuts overlapped pixels, the limit is only a guard */
+    for (int pass = 0; changed && pass < SGL_DIRTY_AREA_NUM_MAX * 4; pass++) {
+        changed = false;
+
+        while (sgl_dirty_area_merge_best(false)) {
+            changed = true;
+        }
+
+        if (sgl_dirty_area_cut_overlap()) {
+            changed = true;
+        }
+    }
+
+    for (int i = 0; i < fbdev->dirty_num; i++) {
+        pixels += sgl_area_pixels(&fbdev->dirty[i]);
+    }
+
+    fbdev->saved_pixels = fbdev->raw_pixels - pixels;
+    fbdev->raw_pixels = 0;
+
+#if (CONFIG_SGL_FRAME_PACING)
+    sgl_dirty_area_sort_scan();
+#endif
+
+    SGL_LOG_TRACE("sgl_dirty_area_plan: %d areas, %d pixels saved", fbdev->dirty_num, fbdev->saved_pixels);
+}
+
+
+/**
+ * @brief initialize object
+ * @param obj object
+ * @param parent parent object
+ * @return int, 0 means successful, -1 means failed
+ */
+int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
+{
+    SGL_ASSERT(obj != NULL);
+
+    if (parent == NULL) {
+        parent = sgl_screen_act();
+        if (parent == NULL) {
+            SGL_LOG_ERROR("sgl_obj_init: have no active page");
+            return -1;
+        }
+    }
+
+    /* set essential member */
+    obj->coords = parent->coords;
+    obj->parent = sgl_obj_to_link(parent);
+    obj->event_fn = NULL;
+#if (CONFIG_SGL_OBJ_COMPACT)
+    obj->side = 0;
+#else
+    obj->event_data = NULL;
+#endif
+    sgl_obj_set_construct_fn(obj, NULL);
+    obj->subtree = 0;
+    sgl_obj_set_dirty(obj);
+    obj->clickable = 0;
+
+    /* init object area to invalid */
     sgl_area_init(&obj->area);
 
     /* add the child into parent's child list */
@@ -933,29 +1542,73 @@ int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent)
  * @brief  free an object
  * @param  obj: object to free
  * @retval none
- * @note this function will free all the itself and children of the object
+ * @note this function will free all the itself and children of the object, every object
+ *       gets SGL_EVENT_DESTROYED before any of them is freed, so that it can free its own
+ *       resource while its parent is still valid. The objects in the region of a page are not
+ *       freed one by one, the region is freed at the end, the events are still sent for the
+ *       memory that the objects have in the heap
  */
 void sgl_obj_free(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
-	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX], *root = obj;
+    sgl_event_t evt = {
+        .type = SGL_EVENT_DESTROYED,
+    };
     int top = 0;
     stack[top++] = obj;
 
+#if (CONFIG_SGL_PAGE_REGION)
+    sgl_mm_region_t *region = obj->page ? ((sgl_page_t*)obj)->region : NULL;
+#endif
+
+    /* the grid must not keep the freed objects */
+    sgl_event_hit_grid_invalidate();
+
+    /* the whole tree is still linked while the objects get the event */
+    while (top > 0) {
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
+		}
+
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
+		}
+
+        if (sgl_obj_get_construct_fn(obj) != NULL) {
+            sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
+        }
+    }
+
+    stack[top++] = root;
     while (top > 0) {
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
 		}
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
 		}
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+        if (obj->side) {
+            sgl_obj_side_free(obj);
+        }
+#endif
         sgl_free(obj);
     }
+
+#if (CONFIG_SGL_PAGE_REGION)
+    if (region != NULL) {
+        sgl_mm_region_delete(region);
+    }
+#endif
 }
 
 
@@ -977,12 +1630,12 @@ void sgl_obj_clear_all_dirty(sgl_obj_t *obj)
 		obj = stack[--top];
         obj->dirty = 0;
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
 		}
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
 		}
     }
 }
@@ -1000,8 +1653,8 @@ void sgl_obj_delete(sgl_obj_t *obj)
 {
     if (obj == NULL || obj == sgl_screen_act()) {
         obj = sgl_screen_act();
-        if (obj->child) {
-            sgl_obj_free(obj->child);
+        if (sgl_obj_from_link(obj->child)) {
+            sgl_obj_free(sgl_obj_from_link(obj->child));
         }
         sgl_obj_node_init(obj);
         sgl_obj_set_dirty(obj);
@@ -1046,12 +1699,14 @@ uint32_t sgl_utf8_to_unicode(const char *utf8_str, uint32_t *p_unicode_buffer)
 
 
 /**
- * @brief Search for the index of a Unicode character in the font table
+ * @brief Search for the index of a Unicode character in the unicode parts of font
  * @param font Pointer to the font structure containing character data
  * @param unicode Unicode of the character to be searched
- * @return Index of the character in the font table
+ * @return Index of the character in the font table, -1 if the character is not in the font
+ * @note it walks the unicode parts and ignores font index and lookup cache, it is the slow path
+ *       of sgl_search_unicode_ch_index()
  */
-uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
+int32_t sgl_font_search_unicode(const sgl_font_t *font, uint32_t unicode)
 {
     uint32_t left = 0, right = 0, mid = 0;
     uint32_t target = unicode;
@@ -1068,14 +1723,14 @@ uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
 
     if (code->list == NULL) {
         if (target >= code->len) {
-            SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
-            return 0;
+            return -1;
         }
         return target + code->tab_offset;
     }
 
-    right = code->len - 1;
-    while (left <= right) {
+    /* search in [left, right), right = mid - 1 would wrap around if target is below list[0] */
+    right = code->len;
+    while (left < right) {
         mid = left + (right - left) / 2;
 
         if (code->list[mid] == target) {
@@ -1085,12 +1740,98 @@ uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
             left = mid + 1;
         }
         else {
-            right = mid - 1;
+            right = mid;
         }
     }
 
-    SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
-    return 0;
+    return -1;
+}
+
+
+/**
+ * @brief look up a Unicode character in the index of font
+ * @param index Pointer to the font index
+ * @param unicode Unicode of the character to be searched
+ * @return Index of the character in the font table, -1 if the character is not in the font
+ */
+static inline int32_t sgl_font_index_lookup(const sgl_font_index_t *index, uint32_t unicode)
+{
+    uint32_t block = (unicode >> SGL_FONT_INDEX_BLOCK_BITS) - index->first_block;
+    uint32_t glyph;
+
+    /* unicode below first block wraps around and fails the range check too */
+    if (block >= index->block_num || index->block[block] == SGL_FONT_INDEX_NONE) {
+        return -1;
+    }
+
+    glyph = index->glyph[(index->block[block] << SGL_FONT_INDEX_BLOCK_BITS) | (unicode & (SGL_FONT_INDEX_BLOCK_SIZE - 1))];
+    return glyph == SGL_FONT_INDEX_NONE ? -1 : (int32_t)glyph;
+}
+
+
+#if (CONFIG_SGL_FONT_LOOKUP_CACHE > 0)
+#if (CONFIG_SGL_FONT_LOOKUP_CACHE & (CONFIG_SGL_FONT_LOOKUP_CACHE - 1))
+#error "CONFIG_SGL_FONT_LOOKUP_CACHE must be a power of 2"
+#endif
+
+/* direct mapped cache for the fonts without index, a missing character is cached as -1 */
+static struct sgl_font_lookup_cache {
+    const sgl_font_t *font;
+    uint32_t         unicode;
+    int32_t          index;
+} sgl_font_lookup_cache[CONFIG_SGL_FONT_LOOKUP_CACHE];
+#endif
+
+
+/**
+ * @brief Search for the index of a Unicode character in the font table
+ * @param font Pointer to the font structure containing character data
+ * @param unicode Unicode of the character to be searched
+ * @return Index of the character in the font table, 0 if the character is not in the font
+ * @note the font index is used if the font has one, otherwise the unicode parts are searched
+ *       and the result is kept in lookup cache, see CONFIG_SGL_FONT_LOOKUP_CACHE
+ */
+uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
+{
+    static uint32_t last_miss = UINT32_MAX;
+    int32_t index;
+
+    if (font->index != NULL) {
+        index = sgl_font_index_lookup(font->index, unicode);
+    }
+    else if (font->unicode_num == 1 && font->unicode->list == NULL) {
+        /* one dense range is direct mapped already */
+        index = (unicode - font->unicode->offset) < font->unicode->len ? (int32_t)(unicode - font->unicode->offset + font->unicode->tab_offset) : -1;
+    }
+    else {
+#if (CONFIG_SGL_FONT_LOOKUP_CACHE > 0)
+        struct sgl_font_lookup_cache *entry;
+        entry = &sgl_font_lookup_cache[(unicode ^ ((uintptr_t)font >> 3)) & (CONFIG_SGL_FONT_LOOKUP_CACHE - 1)];
+
+        if (likely(entry->font == font && entry->unicode == unicode)) {
+            index = entry->index;
+        }
+        else {
+            index = sgl_font_search_unicode(font, unicode);
+            entry->font = font;
+            entry->unicode = unicode;
+            entry->index = index;
+        }
+#else
+        index = sgl_font_search_unicode(font, unicode);
+#endif
+    }
+
+    if (unlikely(index < 0)) {
+        /* the same missing character is drawn again and again, only report it once */
+        if (unicode != last_miss) {
+            last_miss = unicode;
+            SGL_LOG_WARN("sgl_search_unicode_ch_index: [0x%x]unicode not found in font table", unicode);
+        }
+        return 0;
+    }
+
+    return index;
 }
 
 
@@ -1309,12 +2050,12 @@ void sgl_obj_set_pos_align(sgl_obj_t *obj, sgl_align_type_t type)
     };
 
     p_size = (sgl_size_t){
-        .w = obj->parent->coords.x2 - obj->parent->coords.x1 + 1,
-        .h = obj->parent->coords.y2 - obj->parent->coords.y1 + 1,
+        .w = sgl_obj_from_link(obj->parent)->coords.x2 - sgl_obj_from_link(obj->parent)->coords.x1 + 1,
+        .h = sgl_obj_from_link(obj->parent)->coords.y2 - sgl_obj_from_link(obj->parent)->coords.y1 + 1,
     };
     p_pos = (sgl_pos_t){
-        .x = obj->parent->coords.x1,
-        .y = obj->parent->coords.y1,
+        .x = sgl_obj_from_link(obj->parent)->coords.x1,
+        .y = sgl_obj_from_link(obj->parent)->coords.y1,
     };
 
     obj_pos = sgl_get_align_pos(&p_size, &obj_size, type);
@@ -1341,7 +2082,7 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
 {
     SGL_ASSERT(ref != NULL && obj != NULL);
 
-    if (unlikely(ref == obj->parent)) {
+    if (unlikely(ref == sgl_obj_from_link(obj->parent))) {
         sgl_obj_set_pos_align(obj, type);
         return;
     }
@@ -1386,6 +2127,54 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
         SGL_LOG_WARN("invalid align type");
     break;
     }
+
+    sgl_event_hit_grid_invalidate();
+}
+
+
+/**
+ * @brief find the top-most object that covers the whole slice with opaque pixels
+ * @param obj it should point to active root object
+ * @param surf surface that draw to
+ * @return the object, NULL if no object covers the slice
+ * @note the objects are walked in drawing order, so the last opaque one is on the top
+ */
+static inline sgl_obj_t* draw_obj_slice_find_opaque(sgl_obj_t *obj, sgl_surf_t *surf)
+{
+    int top = 0;
+    bool opaque;
+    sgl_obj_t *found = NULL;
+	sgl_event_t evt = { .type = SGL_EVENT_DRAW_OPAQUE, .param = &opaque };
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+
+	stack[top++] = obj;
+
+	while (top > 0) {
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
+		}
+
+        if (sgl_obj_is_hidden(obj) || !sgl_surf_area_is_overlap(surf, &obj->area)) {
+            continue;
+        }
+
+        if (sgl_area_contains(&obj->area, (sgl_area_t*)surf)) {
+            opaque = false;
+            sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
+            if (opaque) {
+                found = obj;
+            }
+        }
+
+        if (sgl_obj_from_link(obj->child) != NULL) {
+            stack[top++] = sgl_obj_from_link(obj->child);
+        }
+	}
+
+    return found;
 }
 
 
@@ -1395,22 +2184,26 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
  * @param surf surface that draw to
  * @param dirty_h dirty height
  * @return none
+ * @note the objects under the top-most opaque object of the slice are not drawn
  */
 static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
 {
     int top = 0;
 	sgl_event_t evt;
 	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *start = NULL;
 
 	SGL_ASSERT(obj != NULL);
+	start = draw_obj_slice_find_opaque(obj, surf);
 	stack[top++] = obj;
+    sgl_system.fbdev.draw_passes ++;
 
 	while (top > 0) {
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
 		}
 
         if (sgl_obj_is_hidden(obj)) {
@@ -1418,12 +2211,21 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
         }
 
 		if (sgl_surf_area_is_overlap(surf, &obj->area)) {
+            /* skip the objects that are covered by the opaque object */
+            if (start != NULL && obj != start) {
+                if (sgl_obj_from_link(obj->child) != NULL) {
+                    stack[top++] = sgl_obj_from_link(obj->child);
+                }
+                continue;
+            }
+
+            start = NULL;
 			evt.type = SGL_EVENT_DRAW_MAIN;
-			SGL_ASSERT(obj->construct_fn != NULL);
-			obj->construct_fn(surf, obj, &evt);
+			SGL_ASSERT(sgl_obj_get_construct_fn(obj) != NULL);
+			sgl_obj_get_construct_fn(obj)(surf, obj, &evt);
 
-            if (obj->child != NULL) {
-                stack[top++] = obj->child;
+            if (sgl_obj_from_link(obj->child) != NULL) {
+                stack[top++] = sgl_obj_from_link(obj->child);
             }
 		}
 	}
@@ -1433,110 +2235,541 @@ static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf)
 }
 
 
+#if (CONFIG_SGL_DRAW_LIST_SIZE && !CONFIG_SGL_USE_FBDEV_VRAM)
 /**
- * @brief calculate dirty area by for each all object that is dirty and visible
+ * @brief build the display list of a dirty area
  * @param obj it should point to active root object
- * @return none
- * @note if there is no dirty area, the dirty area will remain unchanged
+ * @param dirty dirty area
+ * @return true if success, false if the area has more objects than CONFIG_SGL_DRAW_LIST_SIZE
+ * @note the tree is walked like draw_obj_slice() does, the children of an object that misses
+ *       the area are not listed, so a slice of the list draws the same objects as a walk
  */
-static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
+static bool draw_list_build(sgl_obj_t *obj, sgl_area_t *dirty)
 {
+    int top = 0, open_num = 0;
+    uint8_t depth;
 	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
-    int top = 0;
-    stack[top++] = obj;
+    uint8_t stack_depth[SGL_OBJ_DEPTH_MAX];
+    uint16_t open[SGL_OBJ_DEPTH_MAX];
+
+    sgl_draw_list.num = 0;
+	stack[top] = obj;
+    stack_depth[top++] = 0;
+    sgl_system.fbdev.draw_passes ++;
 
-    /* for each all object from the first task of page */
 	while (top > 0) {
-        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
+        depth = stack_depth[top];
 
-        /* if sibling exists, push it to stack, it will be pop in next loop */
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top] = sgl_obj_from_link(obj->sibling);
+            stack_depth[top++] = depth;
 		}
 
-        /* if object is hidden, skip it */
-        if (unlikely(sgl_obj_is_hidden(obj))) {
+        if (sgl_obj_is_hidden(obj) || !sgl_area_is_overlap(dirty, &obj->area)) {
             continue;
         }
 
-        /* check if obj is destroyed */
-        if (unlikely(sgl_obj_is_destroyed(obj))) {
-            /* merge destroy area */
-            sgl_dirty_area_push(&obj->area);
+        /* the objects before at the same or a deeper level have no more children */
+        while (open_num > 0 && sgl_draw_list.item[open[open_num - 1]].depth >= depth) {
+            sgl_draw_list.item[open[--open_num]].end = sgl_draw_list.num;
+        }
 
-            sgl_event_t evt = {
-                .type = SGL_EVENT_DESTROYED,
-            };
+        if (sgl_draw_list.num == CONFIG_SGL_DRAW_LIST_SIZE) {
+            return false;
+        }
 
-            /* check construct function */
-            SGL_ASSERT(obj->construct_fn != NULL);
-            obj->construct_fn(NULL, obj, &evt);
+        sgl_draw_list.item[sgl_draw_list.num].obj = obj;
+        sgl_draw_list.item[sgl_draw_list.num].y1 = sgl_max(obj->area.y1, dirty->y1);
+        sgl_draw_list.item[sgl_draw_list.num].y2 = sgl_min(obj->area.y2, dirty->y2);
+        sgl_draw_list.item[sgl_draw_list.num].depth = depth;
+        sgl_draw_list.item[sgl_draw_list.num].wide = obj->area.x1 <= dirty->x1 && obj->area.x2 >= dirty->x2;
+        sgl_draw_list.item[sgl_draw_list.num].opaque = 0;
+        open[open_num++] = sgl_draw_list.num++;
+
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top] = sgl_obj_from_link(obj->child);
+            stack_depth[top++] = depth + 1;
+		}
+	}
 
-            /* remove obj from parent */
-            sgl_obj_remove(obj);
+    while (open_num > 0) {
+        sgl_draw_list.item[open[--open_num]].end = sgl_draw_list.num;
+    }
 
-            /* free obj resource */
-            sgl_obj_free(obj);
+    return true;
+}
 
-            /* object is destroyed, skip */
-            continue;
-        }
 
-        /* check child need init coords */
-        if (unlikely(sgl_obj_is_needinit(obj))) {
-            sgl_event_t evt = {
-                .type = SGL_EVENT_DRAW_INIT,
-            };
+/**
+ * @brief draw a slice of the dirty area from its display list
+ * @param surf surface that draw to, it has the full width of the dirty area
+ * @return none
+ * @note the objects whose rows miss the slice are skipped with their children, the opaque
+ *       answer of an object is kept for the other slices of the area
+ */
+static void draw_list_slice(sgl_surf_t *surf)
+{
+    int start = 0, i = 0;
+    bool opaque;
+    sgl_obj_t *obj;
+	sgl_event_t evt = { .type = SGL_EVENT_DRAW_OPAQUE, .param = &opaque };
 
-            /* check construct function */
-            SGL_ASSERT(obj->construct_fn != NULL);
-            obj->construct_fn(NULL, obj, &evt);
-            /* maybe no need to clear flag */
-            sgl_obj_clear_needinit(obj);
+    /* find the top-most object that covers the whole slice with opaque pixels */
+    while (i < sgl_draw_list.num) {
+        if (sgl_draw_list.item[i].y2 < surf->y1 || sgl_draw_list.item[i].y1 > surf->y2) {
+            i = sgl_draw_list.item[i].end;
+            continue;
         }
 
-        /* check child dirty and merge all dirty area */
-        if (sgl_obj_is_dirty(obj)) {
-            /* merge dirty area */
-            sgl_dirty_area_push(&obj->area);
-
-            sgl_area_t fill_area = sgl_obj_get_fill_rect(obj->parent);
-            /* update obj area */
-            if (unlikely(!sgl_area_clip(&fill_area, &obj->coords, &obj->area))) {
-                sgl_area_init(&obj->area);
-                sgl_obj_clear_dirty(obj);
-                continue;
+        if (sgl_draw_list.item[i].wide && sgl_draw_list.item[i].y1 <= surf->y1 && sgl_draw_list.item[i].y2 >= surf->y2) {
+            if (sgl_draw_list.item[i].opaque == 0) {
+                obj = sgl_draw_list.item[i].obj;
+                opaque = false;
+                sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
+                sgl_draw_list.item[i].opaque = opaque ? 2 : 1;
             }
 
-            /* merge dirty area */
-            sgl_dirty_area_push(&obj->area);
+            if (sgl_draw_list.item[i].opaque == 2) {
+                start = i;
+            }
+        }
+        i ++;
+    }
 
-            /* clear dirty flag */
-            sgl_obj_clear_dirty(obj);
+    /* the objects under the opaque one are not drawn */
+    i = start;
+    while (i < sgl_draw_list.num) {
+        if (sgl_draw_list.item[i].y2 < surf->y1 || sgl_draw_list.item[i].y1 > surf->y2) {
+            i = sgl_draw_list.item[i].end;
+            continue;
         }
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
-		}
+        obj = sgl_draw_list.item[i].obj;
+        evt.type = SGL_EVENT_DRAW_MAIN;
+        evt.param = NULL;
+        SGL_ASSERT(sgl_obj_get_construct_fn(obj) != NULL);
+        sgl_obj_get_construct_fn(obj)(surf, obj, &evt);
+        i ++;
     }
+
+    /* flush dirty area into screen */
+    sgl_fbdev_flush_area((sgl_area_t*)surf, surf->buffer);
 }
+#endif // !CONFIG_SGL_DRAW_LIST_SIZE
 
 
+#if (CONFIG_SGL_DRAW_BATCH > 1 && !CONFIG_SGL_USE_FBDEV_VRAM)
 /**
- * @brief sgl to draw complete frame
- * @param fbdev point to  frame buffer device
+ * @brief find the top-most opaque object of every surface of a batch
+ * @param obj it should point to active root object
+ * @param sub surfaces of the batch
+ * @param num number of surfaces
+ * @param found [out] the opaque object of every surface, NULL if no object covers it
  * @return none
- * @note this function should be called in deamon thread or cyclic thread
+ * @note it is draw_obj_slice_find_opaque() for many surfaces in one walk
  */
-static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
+static inline void draw_obj_batch_find_opaque(sgl_obj_t *obj, sgl_surf_t *sub, int num, sgl_obj_t **found)
 {
-    sgl_surf_t *surf = &fbdev->surf;
-    sgl_obj_t  *head = fbdev->active;
-    sgl_area_t *dirty = NULL;
+    int top = 0;
+    bool opaque, asked, overlap;
+	sgl_event_t evt = { .type = SGL_EVENT_DRAW_OPAQUE, .param = &opaque };
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+
+	stack[top++] = obj;
+
+	while (top > 0) {
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
+		}
+
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
+        asked = false;
+        overlap = false;
+        opaque = false;
+
+        for (int i = 0; i < num; i++) {
+            if (!sgl_surf_area_is_overlap(&sub[i], &obj->area)) {
+                continue;
+            }
+
+            overlap = true;
+            if (!sgl_area_contains(&obj->area, (sgl_area_t*)&sub[i])) {
+                continue;
+            }
+
+            /* the object is asked once, the answer is the same for every surface */
+            if (!asked) {
+                asked = true;
+                sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
+            }
+
+            if (opaque) {
+                found[i] = obj;
+            }
+        }
+
+        if (overlap && sgl_obj_from_link(obj->child) != NULL) {
+            stack[top++] = sgl_obj_from_link(obj->child);
+        }
+	}
+}
+
+
+/**
+ * @brief draw a batch of dirty areas, every area is a surface in its own part of the draw buffer
+ * @param obj it should point to active root object
+ * @param sub surfaces of the batch
+ * @param num number of surfaces
+ * @return none
+ * @note the object tree is walked once for the batch, every object is drawn into every surface
+ *       that it overlaps, with the same opaque skip as draw_obj_slice(), then the areas are
+ *       flushed one after the other from the same buffer
+ */
+static inline void draw_obj_batch(sgl_obj_t *obj, sgl_surf_t *sub, int num)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+    int top = 0;
+    bool overlap;
+	sgl_event_t evt;
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *start[CONFIG_SGL_DRAW_BATCH] = { NULL };
+
+	SGL_ASSERT(obj != NULL);
+	draw_obj_batch_find_opaque(obj, sub, num, start);
+	stack[top++] = obj;
+    fbdev->draw_passes ++;
+
+	while (top > 0) {
+		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
+		}
+
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
+        overlap = false;
+
+        for (int i = 0; i < num; i++) {
+            if (!sgl_surf_area_is_overlap(&sub[i], &obj->area)) {
+                continue;
+            }
+
+            overlap = true;
+
+            /* skip the objects that are covered by the opaque object of this surface */
+            if (start[i] != NULL && obj != start[i]) {
+                continue;
+            }
+
+            start[i] = NULL;
+			evt.type = SGL_EVENT_DRAW_MAIN;
+			SGL_ASSERT(sgl_obj_get_construct_fn(obj) != NULL);
+			sgl_obj_get_construct_fn(obj)(&sub[i], obj, &evt);
+        }
+
+        if (overlap && sgl_obj_from_link(obj->child) != NULL) {
+            stack[top++] = sgl_obj_from_link(obj->child);
+        }
+	}
+
+    for (int i = 0; i < num; i++) {
+        if (i > 0) {
+            /* the area before is sent from the same buffer, wait until it is done */
+            while (sgl_fbdev_flush_wait_ready(fbdev));
+            fbdev->fb_ready[fbdev->fb_swap] = 0;
+        }
+
+        /* the last area changes to the next framebuffer, if there is one */
+        if (i == num - 1) {
+            sgl_fbdev_flush_area((sgl_area_t*)&sub[i], sub[i].buffer);
+            break;
+        }
+
+        while (fbdev->fbinfo.buffer[1] != NULL && sgl_fbdev_flush_wait_idle(fbdev));
+        fbdev->fb_flush = fbdev->fb_swap;
+        sgl_fbdev_flush_transfer((sgl_area_t*)&sub[i], sub[i].buffer);
+    }
+}
+#endif // !CONFIG_SGL_DRAW_BATCH
+
+
+/**
+ * @brief calculate dirty area by for each all object that is dirty and visible
+ * @param obj it should point to active root object
+ * @return none
+ * @note if there is no dirty area, the dirty area will remain unchanged. only the objects with the
+ *       subtree mark are walked, so a page that has nothing to do is skipped at once
+ */
+static inline void sgl_dirty_area_calculate(sgl_obj_t *obj)
+{
+	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    int top = 0;
+    stack[top++] = obj;
+
+    /* for each all object from the first task of page */
+	while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+		obj = stack[--top];
+
+        /* if sibling exists, push it to stack, it will be pop in next loop */
+		if (sgl_obj_from_link(obj->sibling) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->sibling);
+		}
+
+        /* nothing is marked in the object and its children, skip them all */
+        if (likely(!obj->subtree)) {
+            continue;
+        }
+
+        /* if object is hidden, skip it, it keeps the mark until it is visible */
+        if (unlikely(sgl_obj_is_hidden(obj))) {
+            continue;
+        }
+
+        obj->subtree = 0;
+
+        /* check if obj is destroyed */
+        if (unlikely(sgl_obj_is_destroyed(obj))) {
+            /* merge destroy area */
+            sgl_dirty_area_push(&obj->area);
+
+            /* remove obj from parent */
+            sgl_obj_remove(obj);
+
+            /* free obj resource, it sends SGL_EVENT_DESTROYED to obj and its children */
+            sgl_obj_free(obj);
+
+            /* object is destroyed, skip */
+            continue;
+        }
+
+        /* check child need init coords */
+        if (unlikely(sgl_obj_is_needinit(obj))) {
+            sgl_event_t evt = {
+                .type = SGL_EVENT_DRAW_INIT,
+            };
+
+            /* check construct function */
+            SGL_ASSERT(sgl_obj_get_construct_fn(obj) != NULL);
+            sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
+            /* maybe no need to clear flag */
+            sgl_obj_clear_needinit(obj);
+            /* the object may set its coords in DRAW_INIT */
+            sgl_event_hit_grid_invalidate();
+        }
+
+        /* check child dirty and merge all dirty area */
+        if (sgl_obj_is_dirty(obj)) {
+            /* merge dirty area */
+            sgl_dirty_area_push(&obj->area);
+
+            sgl_area_t fill_area = sgl_obj_get_fill_rect(sgl_obj_from_link(obj->parent));
+            sgl_area_t last_area = obj->area;
+            /* update obj area */
+            bool visible = sgl_area_clip(&fill_area, &obj->coords, &obj->area);
+            if (unlikely(!visible)) {
+                sgl_area_init(&obj->area);
+            }
+
+            /* widgets may write coords directly, a moved or resized area must update the hit-test grid */
+            if (memcmp(&last_area, &obj->area, sizeof(sgl_area_t))) {
+                sgl_event_hit_grid_invalidate();
+            }
+
+            if (unlikely(!visible)) {
+                sgl_obj_clear_dirty(obj);
+                continue;
+            }
+
+            /* merge dirty area */
+            sgl_dirty_area_push(&obj->area);
+
+            /* clear dirty flag */
+            sgl_obj_clear_dirty(obj);
+        }
+
+		if (sgl_obj_from_link(obj->child) != NULL) {
+			stack[top++] = sgl_obj_from_link(obj->child);
+		}
+    }
+}
+
+
+/**
+ * @brief get a temporary buffer for draw code, it is valid until the end of current frame
+ * @param size size of buffer
+ * @return pointer to buffer, NULL if the arena is full and the heap is out of memory
+ * @note the buffer is taken from the scratch arena, that is reset after every frame, so it
+ *       costs no heap time and leaves no hole in heap. If the arena is full, the buffer is
+ *       taken from heap, so always give it back with sgl_scratch_free()
+ */
+void* sgl_scratch_alloc(size_t size)
+{
+#if (CONFIG_SGL_DRAW_SCRATCH_SIZE)
+    size_t align = (size + 7) & ~(size_t)7;
+
+    if (align <= sizeof(sgl_scratch.buffer) - sgl_scratch.top) {
+        uint8_t *p = (uint8_t*)sgl_scratch.buffer + sgl_scratch.top;
+
+        sgl_scratch.last = sgl_scratch.top;
+        sgl_scratch.top += align;
+        sgl_scratch.peak = sgl_max(sgl_scratch.peak, sgl_scratch.top);
+        return p;
+    }
+
+    sgl_scratch.fallback ++;
+    SGL_LOG_TRACE("sgl_scratch_alloc: arena is full, %d bytes from heap", (int)size);
+#endif
+
+    return sgl_malloc(size);
+}
+
+
+/**
+ * @brief give back a buffer of sgl_scratch_alloc()
+ * @param p pointer to buffer
+ * @return none
+ * @note the arena space of the last buffer is reused at once, so a buffer that is taken and
+ *       given back in every slice does not fill the arena
+ */
+void sgl_scratch_free(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+#if (CONFIG_SGL_DRAW_SCRATCH_SIZE)
+    uint8_t *base = (uint8_t*)sgl_scratch.buffer;
+
+    if ((uint8_t*)p >= base && (uint8_t*)p < base + sizeof(sgl_scratch.buffer)) {
+        if ((uint8_t*)p == base + sgl_scratch.last) {
+            sgl_scratch.top = sgl_scratch.last;
+        }
+        return;
+    }
+#endif
+
+    sgl_free(p);
+}
+
+
+/**
+ * @brief get scratch arena monitor info
+ * @param none
+ * @return scratch arena monitor info
+ */
+sgl_scratch_monitor_t sgl_scratch_get_monitor(void)
+{
+    sgl_scratch_monitor_t monitor = { 0 };
+
+#if (CONFIG_SGL_DRAW_SCRATCH_SIZE)
+    monitor.total_size = sizeof(sgl_scratch.buffer);
+    monitor.peak_size = sgl_scratch.peak;
+    monitor.fallback = sgl_scratch.fallback;
+#endif
+
+    return monitor;
+}
+
+
+#if (CONFIG_SGL_DRAW_BATCH > 1 && !CONFIG_SGL_USE_FBDEV_VRAM)
+/**
+ * @brief pack the dirty areas from index into the draw buffer and draw them as a batch
+ * @param fbdev point to frame buffer device
+ * @param head active root object
+ * @param index index of the first dirty area
+ * @return number of dirty areas that are drawn, 0 if fewer than two areas fit in the buffer
+ * @note the areas are taken in order, so the flushes keep the order of the dirty areas
+ */
+static inline int sgl_draw_batch_task(sgl_fbdev_t *fbdev, sgl_obj_t *head, int index)
+{
+    sgl_surf_t sub[CONFIG_SGL_DRAW_BATCH];
+    sgl_area_t *dirty;
+    uint32_t used = 0, pixels;
+    int num = 0;
+
+    while (num < CONFIG_SGL_DRAW_BATCH && index + num < fbdev->dirty_num) {
+        dirty = &fbdev->dirty[index + num];
+
+#if (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
+        sgl_area_t screen = { .x1 = 0, .y1 = 0, .x2 = SGL_SCREEN_WIDTH - 1, .y2 = SGL_SCREEN_HEIGHT - 1 };
+        sgl_area_selfclip(dirty, &screen);
+#endif
+
+        pixels = (uint32_t)sgl_area_pixels(dirty);
+        if (used + pixels > fbdev->surf.size) {
+            break;
+        }
+
+        sub[num].x1 = dirty->x1;
+        sub[num].y1 = dirty->y1;
+        sub[num].x2 = dirty->x2;
+        sub[num].y2 = dirty->y2;
+        sub[num].w = dirty->x2 - dirty->x1 + 1;
+        sub[num].h = dirty->y2 - dirty->y1 + 1;
+        sub[num].buffer = fbdev->surf.buffer + used;
+        sub[num].size = pixels;
+        sub[num].dirty = dirty;
+
+        used += pixels;
+        num ++;
+    }
+
+    if (num < 2) {
+        return 0;
+    }
+
+    /* wait current framebuffer for ready */
+    while (sgl_fbdev_flush_wait_ready(fbdev));
+
+    /* reset current framebuffer ready flag */
+    fbdev->fb_ready[fbdev->fb_swap] = 0;
+
+    draw_obj_batch(head, sub, num);
+    return num;
+}
+#endif // !CONFIG_SGL_DRAW_BATCH
+
+
+/**
+ * @brief sgl to draw complete frame
+ * @param fbdev point to  frame buffer device
+ * @return none
+ * @note this function should be called in deamon thread or cyclic thread
+ */
+static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
+{
+    sgl_surf_t *surf = &fbdev->surf;
+    sgl_obj_t  *head = fbdev->active;
+    sgl_area_t *dirty = NULL;
+
+    if (fbdev->dirty_num > 0) {
+        fbdev->frame ++;
+    }
 
     /* dirty area number must less than SGL_DIRTY_AREA_MAX */
     for (int i = 0; i < fbdev->dirty_num; i++) {
+#if (CONFIG_SGL_DRAW_BATCH > 1 && !CONFIG_SGL_USE_FBDEV_VRAM)
+        /* the small areas that fit in the draw buffer together share one walk of the tree */
+        int batch = sgl_draw_batch_task(fbdev, head, i);
+        if (batch > 0) {
+            i += batch - 1;
+            continue;
+        }
+#endif
+
         dirty = &fbdev->dirty[i];
         surf->dirty = dirty;
 
@@ -1561,6 +2794,11 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
 
         SGL_LOG_TRACE("[fb:%d]sgl_draw_task: dirty area  x1:%d y1:%d x2:%d y2:%d", fbdev->fb_swap, dirty->x1, dirty->y1, dirty->x2, dirty->y2);
 
+#if (CONFIG_SGL_DRAW_LIST_SIZE)
+        /* an area of many slices walks the tree once, the slices are drawn from the list */
+        bool listed = surf->h <= dirty->y2 - dirty->y1 && draw_list_build(head, dirty);
+#endif
+
         while (surf->y1 <= dirty->y2) {
             draw_h = sgl_min(dirty->y2 - surf->y1 + 1, surf->h);
             surf->y2 = surf->y1 + draw_h - 1;
@@ -1569,10 +2807,19 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
             while (sgl_fbdev_flush_wait_ready(fbdev));
 
             /* reset current framebuffer ready flag */
-            fbdev->fb_status = (fbdev->fb_status & (2 - fbdev->fb_swap));
+            fbdev->fb_ready[fbdev->fb_swap] = 0;
 
             /* draw object slice until the dirty area is finished */
+#if (CONFIG_SGL_DRAW_LIST_SIZE)
+            if (listed) {
+                draw_list_slice(surf);
+            }
+            else {
+                draw_obj_slice(head, surf);
+            }
+#else
             draw_obj_slice(head, surf);
+#endif
             surf->y1 += draw_h;
         }
 #else
@@ -1585,9 +2832,191 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
     }
     /* clear dirty area */
     fbdev->dirty_num = 0;
+
+#if (CONFIG_SGL_DRAW_SCRATCH_SIZE)
+    /* the temporary buffers of this frame are all dead now */
+    sgl_scratch.top = 0;
+    sgl_scratch.last = 0;
+#endif
+}
+
+
+#if (CONFIG_SGL_FRAME_PACING)
+/* the TE signal is lost if there is no pulse for this time, the frames follow the tick again */
+#define  SGL_FRAME_TE_TIMEOUT_MS            (100)
+
+
+/**
+ * @brief check if the TE pulses come, two pulses are needed to know their period
+ * @param pacing frame pacing state
+ * @param tick current tick
+ * @return true if the frames are paced by the TE pulses
+ */
+static inline bool sgl_frame_te_alive(sgl_pacing_t *pacing, uint32_t tick)
+{
+    return pacing->te_count > 1 && (tick - pacing->te_tick) < SGL_FRAME_TE_TIMEOUT_MS;
+}
+
+
+/**
+ * @brief get the period of the TE pulses in milliseconds, rounded and at least 1
+ * @param pacing frame pacing state
+ * @return period in milliseconds
+ */
+static inline uint32_t sgl_frame_te_period_ms(sgl_pacing_t *pacing)
+{
+    return sgl_max((pacing->te_period + 128) >> 8, 1u);
+}
+
+
+/**
+ * @brief check if a frame should start now
+ * @param none
+ * @return true if the next frame is due
+ * @note with TE pulses, a frame is due when the pacing interval of TE pulses has passed since the
+ *       last frame, otherwise when SGL_SYSTEM_TICK_MS has passed
+ */
+bool sgl_frame_is_due(void)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    uint32_t tick = sgl_tick_get();
+
+    if (sgl_frame_te_alive(pacing, tick)) {
+        return pacing->te_count - pacing->frame_te >= pacing->interval;
+    }
+
+    return tick - sgl_last_tick_get() >= SGL_SYSTEM_TICK_MS;
+}
+
+
+/**
+ * @brief get the time until the next frame is due
+ * @param now current tick
+ * @return milliseconds, it is at least 1 while a TE pulse is waited for, the TE interrupt may
+ *         come a little later than its period
+ */
+static uint32_t sgl_frame_get_wait(uint32_t now)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    uint32_t elaps = now - sgl_last_tick_get();
+    uint32_t pulses;
+    int32_t wait;
+
+    if (!sgl_frame_te_alive(pacing, now)) {
+        return elaps < SGL_SYSTEM_TICK_MS ? SGL_SYSTEM_TICK_MS - elaps : 0;
+    }
+
+    pulses = pacing->te_count - pacing->frame_te;
+    if (pulses >= pacing->interval) {
+        return 0;
+    }
+
+    wait = (int32_t)(pacing->te_tick + (pacing->interval - pulses) * sgl_frame_te_period_ms(pacing) - now);
+    return wait > 0 ? (uint32_t)wait : 1;
+}
+
+
+/**
+ * @brief start a frame, count the coalesced frames and predict when the frame is on the panel
+ * @param none
+ * @return true if the frame is started by a TE pulse
+ */
+static inline bool sgl_frame_begin(void)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    uint32_t tick = sgl_tick_get();
+    uint32_t te = pacing->te_count;
+    bool alive = sgl_frame_te_alive(pacing, tick);
+    uint32_t periods = alive ? te - pacing->frame_te : (tick - pacing->frame_tick) / SGL_SYSTEM_TICK_MS;
+    uint32_t display = tick + ((pacing->render_avg + 8) >> 4);
+
+    /* an animation wanted every period, but the periods between were not drawn */
+    if (pacing->busy && periods > 1) {
+        pacing->stats.coalesced += periods - 1;
+    }
+
+    /* the animations are sampled at the time the frame is seen, it never goes back */
+    if ((int32_t)(display - pacing->display_tick) > 0) {
+        pacing->display_tick = display;
+    }
+
+    pacing->frame_te = te;
+    pacing->frame_tick = tick;
+
+    return alive && periods > 0;
 }
 
 
+/**
+ * @brief finish a frame, update the frame time and the pacing interval
+ * @param drawn true if the frame had dirty areas
+ * @param by_te true if the frame was started by a TE pulse
+ * @return none
+ * @note the interval is the TE periods that a frame takes, so the frames of a slow scene are
+ *       evenly spaced instead of one late frame after the other
+ */
+static inline void sgl_frame_end(bool drawn, bool by_te)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    uint32_t tick = sgl_tick_get();
+    uint32_t ms = tick - pacing->frame_tick;
+    uint32_t need, interval;
+
+#if (CONFIG_SGL_ANIMATION)
+    pacing->busy = sgl_anim_get_wait(tick) == 0;
+#endif
+
+    if (!drawn) {
+        return;
+    }
+
+    pacing->stats.frames ++;
+    pacing->stats.te_frames += by_te;
+    pacing->stats.last_ms = (uint16_t)sgl_min(ms, UINT16_MAX);
+    pacing->stats.max_ms = sgl_max(pacing->stats.max_ms, pacing->stats.last_ms);
+    pacing->render_avg += ((int32_t)(pacing->stats.last_ms << 4) - (int32_t)pacing->render_avg) / 4;
+
+    if (sgl_frame_te_alive(pacing, tick)) {
+        need = sgl_max((uint32_t)SGL_SYSTEM_TICK_MS << 8, (uint32_t)pacing->render_avg << 4);
+        interval = (need + pacing->te_period - 1) / pacing->te_period;
+        pacing->interval = (uint8_t)sgl_clamp(interval, 1, CONFIG_SGL_FRAME_PACING_SKIP_MAX);
+    }
+    else {
+        pacing->interval = 1;
+    }
+}
+
+
+/**
+ * @brief get frame time statistics
+ * @param none
+ * @return frame time statistics
+ */
+sgl_frame_stats_t sgl_frame_get_stats(void)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    sgl_frame_stats_t stats = pacing->stats;
+
+    stats.avg_ms = (pacing->render_avg + 8) >> 4;
+    stats.te_period_ms = sgl_frame_te_alive(pacing, sgl_tick_get()) ? sgl_frame_te_period_ms(pacing) : 0;
+    stats.interval = pacing->interval;
+
+    return stats;
+}
+
+
+/**
+ * @brief reset frame time statistics
+ * @param none
+ * @return none
+ */
+void sgl_frame_stats_reset(void)
+{
+    memset(&sgl_system.pacing.stats, 0, sizeof(sgl_frame_stats_t));
+}
+#endif // !CONFIG_SGL_FRAME_PACING
+
+
 /**
  * @brief sgl task handle function with sync mode
  * @param none
@@ -1596,6 +3025,17 @@ static inline void sgl_draw_task(sgl_fbdev_t *fbdev)
  */
 void sgl_task_handle_sync(void)
 {
+#if (CONFIG_SGL_FRAME_PACING)
+    uint32_t frame = sgl_system.fbdev.frame;
+    bool by_te = sgl_frame_begin();
+#endif
+#if (CONFIG_SGL_PAGE_REGION)
+    /* the glyph cache, the text layouts and the other blocks of a frame outlive a page, so
+     * they are never cut from the region of the page that is being built
+     */
+    sgl_mm_region_t *region = sgl_mm_region_enter(NULL);
+#endif
+
     /* event task */
     sgl_event_task();
 
@@ -1606,6 +3046,50 @@ void sgl_task_handle_sync(void)
     /* foreach all object tree and calculate dirty area */
     sgl_dirty_area_calculate(sgl_system.fbdev.active);
 
+    /* merge or cut dirty areas to reduce flushed pixels */
+    sgl_dirty_area_plan();
+
     /* draw all object into screen */
     sgl_draw_task(&sgl_system.fbdev);
+
+#if (CONFIG_SGL_FRAME_PACING)
+    sgl_frame_end(sgl_system.fbdev.frame != frame, by_te);
+#endif
+#if (CONFIG_SGL_PAGE_REGION)
+    sgl_mm_region_resume(region);
+#endif
+}
+
+
+/**
+ * @brief get the time until sgl task has work to do, the main loop may sleep for it
+ * @param none
+ * @return milliseconds to wait, 0 means that sgl_task_handle() runs a frame now,
+ *         SGL_WAIT_FOREVER means that nothing is pending until the next input
+ * @note pending events, marked objects and dirty areas are drawn in the next frame, that is
+ *       SGL_SYSTEM_TICK_MS after the last one, a delayed animation is waited for until it starts
+ */
+uint32_t sgl_task_get_wait(void)
+{
+    uint32_t now = sgl_tick_get();
+#if (CONFIG_SGL_FRAME_PACING)
+    uint32_t frame = sgl_frame_get_wait(now);
+#else
+    uint32_t elaps = now - sgl_last_tick_get();
+    uint32_t frame = elaps < SGL_SYSTEM_TICK_MS ? SGL_SYSTEM_TICK_MS - elaps : 0;
+#endif
+    sgl_obj_t *active = sgl_system.fbdev.active;
+
+    if (sgl_event_is_pending() || sgl_system.fbdev.dirty_num || (active != NULL && active->subtree)) {
+        return frame;
+    }
+
+#if (CONFIG_SGL_ANIMATION)
+    uint32_t wait = sgl_anim_get_wait(now);
+    if (wait != SGL_WAIT_FOREVER) {
+        return sgl_max(wait, frame);
+    }
+#endif // !CONFIG_SGL_ANIMATION
+
+    return SGL_WAIT_FOREVER;
 }
@@ -32,35 +32,74 @@
 
 /* define event queue size */
 #define SGL_EVENT_QUEUE_SIZE          (CONFIG_SGL_EVENT_QUEUE_SIZE)
-#define SGL_EVENT_QUEUE_SIZE_MASK     (SGL_EVENT_QUEUE_SIZE - 1)
+#define SGL_EVENT_INPUT_QUEUE_SIZE    (CONFIG_SGL_EVENT_INPUT_QUEUE_SIZE)
 
 /**
- * @brief event queue struct
+ * @brief single producer and single consumer event queue, it has no lock
  * @buffer: event buffer to save all event data
- * @head: event queue head which is used to push event
- * @tail: event queue tail which is used to pop event
- * @count: event queue count which have been pushed
+ * @mask: size of buffer minus 1, the size must be power of 2
+ * @head: event queue head which is used to push event, only the producer writes it
+ * @tail: event queue tail which is used to pop event, only the consumer writes it
+ * @dropped: number of events that are dropped because the queue is full
+ * @note the producer may interrupt the consumer, but not the other way around, that is the case
+ *       of a touch interrupt and the sgl task on a single core
  */
 typedef struct event_queue {
-    sgl_event_t buffer[SGL_EVENT_QUEUE_SIZE];
-    uint16_t    head;
-    uint16_t    tail;
+    sgl_event_t       *buffer;
+    uint16_t          mask;
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint16_t dropped;
 } event_queue_t;
 
 
+#if (CONFIG_SGL_EVENT_HIT_GRID_CELL)
+/**
+ * @brief hit-test grid, the screen is divided into cells of CONFIG_SGL_EVENT_HIT_GRID_CELL pixels
+ *        and every cell keeps the objects whose coords cover it, in the order of tree walk
+ * @entry: objects of all cells, the objects of cell i are entry[start[i]] .. entry[start[i + 1] - 1]
+ * @start: first entry of every cell, it has cols * rows + 1 items
+ * @screen: the screen that the grid is built from
+ * @total: number of entries
+ * @cols: number of cell columns
+ * @rows: number of cell rows
+ * @valid: false if objects are added, removed, moved or resized after the grid is built
+ */
+typedef struct hit_grid {
+    struct sgl_obj **entry;
+    uint16_t       *start;
+    struct sgl_obj *screen;
+    uint32_t        total;
+    uint16_t        cols;
+    uint16_t        rows;
+    bool            valid;
+} hit_grid_t;
+#endif
+
+
 /**
  * @brief event context struct
  * @last_click: last click object which may be lost event
  * @last_touch: last touch position
- * @evtq: event queue
+ * @evtq: event queue of the events that are sent to objects in sgl task
+ * @inputq: event queue of the input device, it may be pushed in interrupt
+ * @grid: hit-test grid of click_detect_object
  */
 static struct event_context {
     struct sgl_obj *last_click;
     sgl_event_pos_t last_touch;
     event_queue_t   evtq;
+    event_queue_t   inputq;
+#if (CONFIG_SGL_EVENT_HIT_GRID_CELL)
+    hit_grid_t      grid;
+#endif
 } evt_ctx;
 
 
+static sgl_event_t evtq_buffer[SGL_EVENT_QUEUE_SIZE];
+static sgl_event_t inputq_buffer[SGL_EVENT_INPUT_QUEUE_SIZE];
+
+
 /**
  * @brief Initialize the event queue
  * @param none
@@ -70,70 +109,120 @@ static struct event_context {
  */
 int sgl_event_queue_init(void)
 {
-    if (!sgl_is_pow2(SGL_EVENT_QUEUE_SIZE)) {
+    if (!sgl_is_pow2(SGL_EVENT_QUEUE_SIZE) || !sgl_is_pow2(SGL_EVENT_INPUT_QUEUE_SIZE)) {
         SGL_LOG_ERROR("The capacity must be power of 2");
         return -1;
     }
 
-    evt_ctx.evtq.head = evt_ctx.evtq.tail = 0;
+    evt_ctx.evtq = (event_queue_t) {
+        .buffer = evtq_buffer,
+        .mask = SGL_EVENT_QUEUE_SIZE - 1,
+    };
+    evt_ctx.inputq = (event_queue_t) {
+        .buffer = inputq_buffer,
+        .mask = SGL_EVENT_INPUT_QUEUE_SIZE - 1,
+    };
+
     return 0;
 }
 
 
 /**
- * @brief Check whether the event queue is empty
- * @param none
- * @return true if the event queue is empty, false otherwise
+ * @brief Push an event into an event queue, it is called by the producer of the queue only
+ * @param q The event queue
+ * @param event The event to be pushed
+ * @return none
+ * @note A MOTION event is merged into the last queued MOTION event of the same object, the
+ *       position is the latest one and the distance is accumulated, so that a fast drag does
+ *       not fill the queue. The last event is merged only if it is not the tail, because the
+ *       consumer may be interrupted while it copies the tail event.
  */
-static inline bool sgl_event_queue_is_empty(void)
+static void event_queue_push(event_queue_t *q, sgl_event_t *event)
 {
-    return evt_ctx.evtq.head == evt_ctx.evtq.tail;
+    uint16_t head = q->head;
+    uint16_t tail = q->tail;
+    uint16_t last = (head - 1) & q->mask;
+    uint16_t next = (head + 1) & q->mask;
+
+    if (event->type == SGL_EVENT_MOTION && head != tail && last != tail) {
+        sgl_event_t *prev = &q->buffer[last];
+
+        if (prev->type == SGL_EVENT_MOTION && prev->obj == event->obj) {
+            prev->pos = event->pos;
+            prev->distance += event->distance;
+            return;
+        }
+    }
+
+    if (unlikely(next == tail)) {
+        q->dropped ++;
+        return;
+    }
+
+    q->buffer[head] = *event;
+
+    /* the event must be written before it is published */
+    sgl_barrier();
+    q->head = next;
 }
 
 
 /**
- * @brief Check whether the event queue is full
- * @param none
- * @return true if the event queue is full, false otherwise
+ * @brief Pop an event from an event queue, it is called by the consumer of the queue only
+ * @param q The event queue
+ * @param out_event The event to be popped
+ * @return 0 on success, -1 if the queue is empty
  */
-static inline bool sgl_event_queue_is_full(void)
+static inline int event_queue_pop(event_queue_t *q, sgl_event_t *out_event)
 {
-    uint32_t next_head = (evt_ctx.evtq.head + 1) & SGL_EVENT_QUEUE_SIZE_MASK;
-    return next_head == evt_ctx.evtq.tail;
+    uint16_t tail = q->tail;
+
+    if (tail == q->head) {
+        return -1;
+    }
+
+    /* the event must be read after head is read, and before the slot is given back */
+    sgl_barrier();
+    *out_event = q->buffer[tail];
+    sgl_barrier();
+    q->tail = (tail + 1) & q->mask;
+    return 0;
 }
 
 
 /**
  * @brief Push an event into the event queue
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note call it in sgl task only, such as the event callback of objects, the input device
+ *       should use sgl_event_send_pos() or sgl_event_pos_input()
  */
 void sgl_event_queue_push(sgl_event_t event)
 {
-    if (unlikely(sgl_event_queue_is_full())) {
-        SGL_LOG_ERROR("Event queue is full, maybe system is too slow");
-        return;
-    }
-
-    evt_ctx.evtq.buffer[evt_ctx.evtq.head] = event;
-    evt_ctx.evtq.head = ((evt_ctx.evtq.head + 1) & SGL_EVENT_QUEUE_SIZE_MASK);
+    event_queue_push(&evt_ctx.evtq, &event);
 }
 
 
 /**
- * @brief Pop an event from the event queue
- * @param out_event The event to be popped
- * @return 0 on success, -1 on failure
+ * @brief Get the number of events that are dropped because the event queue is full
+ * @param none
+ * @return number of dropped events of both event queue and input event queue
  */
-static inline int sgl_event_queue_pop(sgl_event_t* out_event)
+uint32_t sgl_event_queue_get_dropped(void)
 {
-    if (sgl_event_queue_is_empty()) {
-        return -1;
-    }
+    return (uint32_t)evt_ctx.evtq.dropped + evt_ctx.inputq.dropped;
+}
 
-    *out_event = evt_ctx.evtq.buffer[evt_ctx.evtq.tail];
-    evt_ctx.evtq.tail = ((evt_ctx.evtq.tail + 1) & SGL_EVENT_QUEUE_SIZE_MASK);
-    return 0;
+
+/**
+ * @brief Check if there are events that wait for sgl_event_task()
+ * @param none
+ * @return true if the event queue or the input event queue is not empty
+ * @note it can be called in interrupt, e.g. before the main loop goes to sleep
+ */
+bool sgl_event_is_pending(void)
+{
+    return evt_ctx.evtq.head != evt_ctx.evtq.tail || evt_ctx.inputq.head != evt_ctx.inputq.tail;
 }
 
 
@@ -186,13 +275,14 @@ static bool pos_is_focus_on_obj(sgl_event_pos_t *pos, sgl_rect_t *rect, int16_t
 
 
 /**
- * @brief check whether the position is clicked on the object
+ * @brief find the last object in tree walk order that the position is focus on
  * @param pos The position to be clicked
- * @return The object that is clicked on, NULL if no object is clicked
+ * @return The object, NULL if the position is not focus on any object
+ * @note an object is tested only if it is not hidden and all its parents are focused
  */
-static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+static struct sgl_obj* click_walk_object(sgl_event_pos_t *pos)
 {
-    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj = sgl_screen_act()->child, *find = NULL;
+    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj = sgl_obj_from_link(sgl_screen_act()->child), *find = NULL;
     int top = 0;
 
     if (unlikely(obj == NULL)) {
@@ -204,7 +294,7 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
         SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
         if (sgl_obj_has_sibling(obj)) {
-            stack[top++] = obj->sibling;
+            stack[top++] = sgl_obj_from_link(obj->sibling);
         }
 
         if (unlikely(sgl_obj_is_hidden(obj))) {
@@ -214,17 +304,220 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
         if (pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
             find = obj;
             if (sgl_obj_has_child(obj)) {
-                stack[top++] = obj->child;
+                stack[top++] = sgl_obj_from_link(obj->child);
+            }
+        }
+    }
+
+    return find;
+}
+
+
+#if (CONFIG_SGL_EVENT_HIT_GRID_CELL)
+/**
+ * @brief mark the hit-test grid out of date, it is rebuilt at the next click
+ * @param none
+ * @return none
+ */
+void sgl_event_hit_grid_invalidate(void)
+{
+    evt_ctx.grid.valid = false;
+}
+
+
+/**
+ * @brief walk all objects of the screen and visit the cells that every object covers
+ * @param grid hit-test grid
+ * @param mode 0: count the entries, 1: count the entries of every cell, 2: fill the entries
+ * @return none
+ * @note the objects are walked in the same order as click_walk_object(), hidden objects are
+ *       walked too, because hidden flag is checked when a cell is searched
+ */
+static void hit_grid_walk(hit_grid_t *grid, int mode)
+{
+    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj;
+    sgl_area_t *s = &grid->screen->coords, *o;
+    int top = 0, c1, c2, r1, r2;
+
+    if (sgl_obj_from_link(grid->screen->child) != NULL) {
+        stack[top++] = sgl_obj_from_link(grid->screen->child);
+    }
+
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+        if (sgl_obj_has_sibling(obj)) {
+            stack[top++] = sgl_obj_from_link(obj->sibling);
+        }
+        if (sgl_obj_has_child(obj)) {
+            stack[top++] = sgl_obj_from_link(obj->child);
+        }
+
+        o = &obj->coords;
+        if (o->x1 > s->x2 || o->x2 < s->x1 || o->y1 > s->y2 || o->y2 < s->y1 || o->x1 > o->x2 || o->y1 > o->y2) {
+            continue;
+        }
+
+        c1 = (sgl_max(o->x1, s->x1) - s->x1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+        c2 = (sgl_min(o->x2, s->x2) - s->x1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+        r1 = (sgl_max(o->y1, s->y1) - s->y1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+        r2 = (sgl_min(o->y2, s->y2) - s->y1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+
+        if (mode == 0) {
+            grid->total += (c2 - c1 + 1) * (r2 - r1 + 1);
+            continue;
+        }
+
+        for (int r = r1; r <= r2; r++) {
+            for (int c = c1; c <= c2; c++) {
+                if (mode == 1) {
+                    grid->start[r * grid->cols + c + 1] ++;
+                }
+                else {
+                    grid->entry[grid->start[r * grid->cols + c] ++] = obj;
+                }
             }
         }
     }
+}
+
+
+/**
+ * @brief build the hit-test grid of the active screen
+ * @param grid hit-test grid
+ * @return none
+ * @note grid->entry is NULL if the grid can not be built
+ */
+static void hit_grid_build(hit_grid_t *grid)
+{
+    int cells;
+
+    sgl_free(grid->entry);
+    grid->entry = NULL;
+    grid->start = NULL;
+    grid->total = 0;
+
+    /* if the grid can not be built, the tree walk is used until the grid is invalidated again */
+    grid->valid = true;
+    grid->screen = sgl_screen_act();
+    grid->cols = (grid->screen->coords.x2 - grid->screen->coords.x1) / CONFIG_SGL_EVENT_HIT_GRID_CELL + 1;
+    grid->rows = (grid->screen->coords.y2 - grid->screen->coords.y1) / CONFIG_SGL_EVENT_HIT_GRID_CELL + 1;
+    cells = grid->cols * grid->rows;
+
+    hit_grid_walk(grid, 0);
+    if (grid->total > UINT16_MAX) {
+        SGL_LOG_WARN("hit_grid_build: too many objects, use tree walk");
+        return;
+    }
+
+    /* one block for both arrays, the pointers are placed first for alignment */
+    grid->entry = sgl_malloc(grid->total * sizeof(struct sgl_obj*) + (cells + 1) * sizeof(uint16_t));
+    if (grid->entry == NULL) {
+        SGL_LOG_WARN("hit_grid_build: malloc failed, use tree walk");
+        return;
+    }
+    grid->start = (uint16_t*)(grid->entry + grid->total);
+    memset(grid->start, 0, (cells + 1) * sizeof(uint16_t));
+
+    /* count the entries of every cell, and turn the counts into the first entry of every cell */
+    hit_grid_walk(grid, 1);
+    for (int i = 0; i < cells; i++) {
+        grid->start[i + 1] += grid->start[i];
+    }
+
+    /* start[i] is moved to start[i + 1] when cell i is filled, so shift it back */
+    hit_grid_walk(grid, 2);
+    for (int i = cells; i > 0; i--) {
+        grid->start[i] = grid->start[i - 1];
+    }
+    grid->start[0] = 0;
+}
+
+
+/**
+ * @brief check whether the position is focus on the object and all its parents
+ * @param pos The position to be checked
+ * @param obj The object
+ * @param screen The screen that the object belongs to
+ * @return true if click_walk_object() tests the object and the position is focus on it
+ */
+static inline bool hit_grid_obj_is_focus(sgl_event_pos_t *pos, struct sgl_obj *obj, struct sgl_obj *screen)
+{
+    for (; obj != screen; obj = sgl_obj_from_link(obj->parent)) {
+        if (sgl_obj_is_hidden(obj) || !pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief find the last object in tree walk order that the position is focus on by grid
+ * @param pos The position to be clicked
+ * @param find [out] The object, NULL if the position is not focus on any object
+ * @return 0 on success, -1 if the grid can not be used, then the tree walk should be used
+ * @note the objects of a cell are in tree walk order, so the last focused one is the result
+ */
+static int hit_grid_find(sgl_event_pos_t *pos, struct sgl_obj **find)
+{
+    hit_grid_t *grid = &evt_ctx.grid;
+    struct sgl_obj *screen = sgl_screen_act();
+    int c, r, cell;
+
+    if (!grid->valid || grid->screen != screen) {
+        hit_grid_build(grid);
+    }
+
+    if (grid->entry == NULL) {
+        return -1;
+    }
+
+    if (pos->x < screen->coords.x1 || pos->x > screen->coords.x2 || pos->y < screen->coords.y1 || pos->y > screen->coords.y2) {
+        return -1;
+    }
+
+    c = (pos->x - screen->coords.x1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+    r = (pos->y - screen->coords.y1) / CONFIG_SGL_EVENT_HIT_GRID_CELL;
+    cell = r * grid->cols + c;
+
+    *find = NULL;
+    for (int i = grid->start[cell + 1] - 1; i >= (int)grid->start[cell]; i--) {
+        if (hit_grid_obj_is_focus(pos, grid->entry[i], screen)) {
+            *find = grid->entry[i];
+            break;
+        }
+    }
+
+    return 0;
+}
+#endif
+
+
+/**
+ * @brief check whether the position is clicked on the object
+ * @param pos The position to be clicked
+ * @return The object that is clicked on, NULL if no object is clicked
+ */
+static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+{
+    struct sgl_obj *find = NULL;
+
+#if (CONFIG_SGL_EVENT_HIT_GRID_CELL)
+    if (hit_grid_find(pos, &find)) {
+        find = click_walk_object(pos);
+    }
+#else
+    find = click_walk_object(pos);
+#endif
 
     /**
      * if the object is clickable, return it, otherwise return its parent 
      * because the object may be a label attached to the object
     */
     if (find != NULL) {
-        return sgl_obj_is_clickable(find) ? find : (sgl_obj_is_clickable(find->parent) ? find->parent : NULL);
+        return sgl_obj_is_clickable(find) ? find : (sgl_obj_is_clickable(sgl_obj_from_link(find->parent)) ? sgl_obj_from_link(find->parent) : NULL);
     }
 
     return find;
@@ -236,6 +529,8 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
  * @param pos The position to be handled
  * @param type The type of the event
  * @return none
+ * @note it can be called in interrupt, the input event queue has one producer, so do not
+ *       call it from two contexts at the same time
  */
 void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type)
 {
@@ -245,11 +540,7 @@ void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type)
         .pos = pos,
     };
 
-    if (type == SGL_EVENT_PRESSED) {
-        evt_ctx.last_touch = pos;
-    }
-
-    sgl_event_queue_push(event);
+    event_queue_push(&evt_ctx.inputq, &event);
 }
 
 
@@ -300,14 +591,17 @@ void sgl_event_task(void)
     sgl_event_t evt;
     struct sgl_obj *obj = NULL;
 
-    /* Get event from event queue */
-    while (sgl_event_queue_pop(&evt) == 0) {
+    /* Get event from event queue, the events sent to objects go first, then input events */
+    while (event_queue_pop(&evt_ctx.evtq, &evt) == 0 || event_queue_pop(&evt_ctx.inputq, &evt) == 0) {
         obj = evt.obj;
 
         /* if obj is NULL, it means the event from the input device */
         if (obj == NULL) {
             if (evt.type != SGL_EVENT_MOTION) {
                 obj = click_detect_object(&evt.pos);
+                if (evt.type == SGL_EVENT_PRESSED) {
+                    evt_ctx.last_touch = evt.pos;
+                }
             } else {
                 obj = evt_ctx.last_click;
                 sgl_get_move_info(&evt);
@@ -337,10 +631,10 @@ void sgl_event_task(void)
                 evt_ctx.last_click = NULL;
             }
 
-            SGL_ASSERT(obj->construct_fn);
-            evt.param = obj->event_data;
+            SGL_ASSERT(sgl_obj_get_construct_fn(obj));
+            evt.param = sgl_obj_get_event_data(obj);
             evt.obj = obj;
-            obj->construct_fn(NULL, obj, &evt);
+            sgl_obj_get_construct_fn(obj)(NULL, obj, &evt);
 
             /* call user event function */
             if(obj->event_fn) {
@@ -410,7 +704,6 @@ void sgl_event_pos_input(int16_t x, int16_t y, bool flag)
         else {
             sgl_event_send_pos(pos, SGL_EVENT_MOTION);
             last_motion = pos;
-            SGL_LOG_INFO("Touch SGL_EVENT_MOTION x: %d, y: %d", pos.x, pos.y);
         }
 
         act_count ++;
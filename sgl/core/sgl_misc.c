@@ -115,7 +115,7 @@ sgl_obj_t* sgl_logo_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &logo->obj;
     sgl_obj_init(&logo->obj, parent);
-    obj->construct_fn = sgl_logo_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_logo_construct_cb);
     logo->alpha = SGL_ALPHA_MAX;
     sgl_obj_set_border_width(obj, 0);
     return obj;
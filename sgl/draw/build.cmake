@@ -25,6 +25,7 @@ set(SGL_SOURCE
     ${SGL_SOURCE}
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_line.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_rect.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_span.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_circle.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_arc.c
     ${CMAKE_CURRENT_LIST_DIR}/sgl_draw_text.c
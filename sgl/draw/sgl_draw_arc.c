@@ -44,6 +44,11 @@ static void arc_dot_sin_cos(int16_t cx, int16_t cy, int16_t radius_in, int16_t r
     int len = (radius_out + radius_in) / 2;
     int r = (radius_out - radius_in) / 2;
     if (unlikely(r == 0)) {
+        /* a 1 pixel thick arc has no caps, no pixel is in the box of the dot */
+        dot->cx = cx;
+        dot->cy = cy;
+        dot->r = 0;
+        dot->outer = 0;
         return;
     }
 
@@ -74,7 +79,6 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
     uint32_t temp;
     uint8_t alpha = SGL_ALPHA_MIN, max = SGL_ALPHA_MIN;
     sgl_arc_dot_t *p = dot;
-    int32_t rate = (0xff00) / (dot->rmax - dot->r2);
 
     for (int k = 0; k < 2; k++, p++) {
         int x = ax > p->cx ? ax - p->cx : p->cx-ax;
@@ -87,7 +91,7 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
             }
             else if (temp > p->r2) {
                 if(dot->outer==0) {
-                    dot->outer = rate;
+                    dot->outer = (0xff00) / (dot->rmax - dot->r2);
                 }
                 alpha = (p->rmax - temp) * dot->outer >> 8;
             }
@@ -101,6 +105,49 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
 }
 
 
+/**
+ * @brief get the dx of a scanline where |a * dx + b| < SGL_ALPHA_MAX, the pixels out of range
+ *        of the arc are only touched there by the normal and ring modes
+ * @param a factor of dx
+ * @param b constant of the scanline
+ * @param lo first dx
+ * @param hi last dx, it is below lo if no dx matches
+ * @return none
+ */
+static void arc_near_line(int32_t a, int32_t b, int32_t *lo, int32_t *hi)
+{
+    int32_t lo2, hi2;
+
+    sgl_draw_half_line(a, b + SGL_ALPHA_MAX - 1, lo, hi);
+    sgl_draw_half_line(-a, -b + SGL_ALPHA_MAX - 1, &lo2, &hi2);
+
+    *lo = sgl_max(*lo, lo2);
+    *hi = sgl_min(*hi, hi2);
+}
+
+
+/**
+ * @brief get the dx of a scanline in the box of a round cap, arc_get_dot() is 0 out of the boxes
+ * @param dot round cap
+ * @param y y of the scanline
+ * @param cx x of the arc center
+ * @param lo first dx
+ * @param hi last dx, it is below lo if the scanline misses the box
+ * @return none
+ */
+static void arc_near_cap(sgl_arc_dot_t *dot, int y, int16_t cx, int32_t *lo, int32_t *hi)
+{
+    if (sgl_abs(y - dot->cy) < dot->r) {
+        *lo = dot->cx - dot->r + 1 - cx;
+        *hi = dot->cx + dot->r - 1 - cx;
+    }
+    else {
+        *lo = SGL_DRAW_HALF_LINE_INF;
+        *hi = -SGL_DRAW_HALF_LINE_INF;
+    }
+}
+
+
 /**
  * @brief draw an arc with alpha
  * @param surf pointer to surface
@@ -110,11 +157,11 @@ static inline uint8_t arc_get_dot(sgl_arc_dot_t *dot,int ax, int ay)
  */
 void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
 {
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
+    int y2 = 0, real_r2 = 0, edge_alpha = 0, num = 0;
     int in_r2 = sgl_pow2(desc->radius_in);
     int out_r2 = sgl_pow2(desc->radius_out);
     int inv_inner = 0, inv_outer = 0;
-    sgl_arc_dot_t arc_dot[2];
+    sgl_arc_dot_t arc_dot[2] = {0};
 
     int in_r2_max = sgl_pow2(desc->radius_in - 1);
     int out_r2_max = sgl_pow2(desc->radius_out + 1);
@@ -123,11 +170,15 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
 
     sgl_color_t *buf = NULL, *blend = NULL;
     int32_t dx, dy;
-    uint8_t flag = 0xff, in_range;
+    uint8_t flag = 0xff, in_range, far;
     int32_t ds = 0, de = 0, sd = 0, ed = 0;
     int32_t sx = 0, sy = 0, ex = 0, ey = 0;
+    int32_t cut[8], end;
+    bool smooth = (desc->mode == SGL_ARC_MODE_NORMAL_SMOOTH || desc->mode == SGL_ARC_MODE_RING_SMOOTH);
     sgl_color_t tmp_color;
     sgl_area_t clip = SGL_AREA_MAX;
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
@@ -149,7 +200,7 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
         ex = sgl_sin(desc->end_angle);
         ey = -sgl_cos(desc->end_angle);
 
-        if (desc->mode == SGL_ARC_MODE_NORMAL_SMOOTH || desc->mode == SGL_ARC_MODE_RING_SMOOTH) {
+        if (smooth) {
             arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[0], sx, sy);
             arc_dot_sin_cos(desc->cx, desc->cy, desc->radius_in, desc->radius_out, &arc_dot[1], ex, ey);
         }
@@ -160,84 +211,133 @@ void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc)
         ey = ey >> 7;
     }
 
+    /* the hole is the inside band, it is not drawn */
+    sgl_draw_band_init(&band, in_r2_max, in_r2, out_r2 + 1, out_r2_max);
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
         dy = y - desc->cy;
         y2 = sgl_pow2(dy);
-        blend = buf;
+        num = sgl_draw_band_runs(&band, desc->cx, y2, clip.x1, clip.x2, run);
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            dx = x - desc->cx;
-            real_r2 = sgl_pow2(x - desc->cx) + y2;
+        /* ds and de are linear in dx on a scanline, so the dx where each of them passes the range
+         * test is a half line. The pixels out of range are only touched near the two ends of the
+         * arc, where |ds| or |de| is small or in the boxes of the round caps, the others are left
+         * as they are or get bg_color. The pixels look the same between two cuts.
+         */
+        if (flag != 255) {
+            /* a * dx + b > 0 is a * dx + b - 1 >= 0 for integers */
+            sgl_draw_half_line(sy, -dy * sx - (flag > 0), &cut[0], &cut[1]);
+            sgl_draw_half_line(-ey, dy * ex - (flag > 0), &cut[2], &cut[3]);
 
-            if (real_r2 >= out_r2_max) {
-                if (x > desc->cx) {
-                    blend++;
-                    break;
-                }
-                continue;
+            if (!smooth) {
+                arc_near_line(sy, -dy * sx, &cut[4], &cut[5]);
+                arc_near_line(-ey, dy * ex, &cut[6], &cut[7]);
             }
-            if (real_r2 < in_r2_max) {
-                if (x < desc->cx) {
-                    blend += ((desc->cx - x) * 2);
-                    x = desc->cx * 2 - x;
-                }
+            else {
+                arc_near_cap(&arc_dot[0], y, desc->cx, &cut[4], &cut[5]);
+                arc_near_cap(&arc_dot[1], y, desc->cx, &cut[6], &cut[7]);
+            }
+        }
+
+        for (int i = 0; i < num; i++) {
+            if (run[i].band == SGL_DRAW_BAND_INSIDE) {
                 continue;
             }
-            if (real_r2 < in_r2 ) {
-                if(inv_inner == 0) {
-                    inv_inner = rate;
+
+            blend = buf + (run[i].x1 - clip.x1);
+            for (int x = run[i].x1; x <= run[i].x2; x = end + 1) {
+                dx = x - desc->cx;
+                end = run[i].x2;
+
+                if (flag != 255) {
+                    for (int k = 0; k < 8; k++) {
+                        int32_t c = desc->cx + cut[k] + (k & 1);
+                        if (c > x && c <= end) {
+                            end = c - 1;
+                        }
+                    }
+                    ds = (dx >= cut[0] && dx <= cut[1]);
+                    de = (dx >= cut[2] && dx <= cut[3]);
+                    in_range = flag > 0 ? (ds || de) : (ds && de);
+                    far = !in_range && !(dx >= cut[4] && dx <= cut[5]) && !(dx >= cut[6] && dx <= cut[7]);
                 }
-                edge_alpha  = (real_r2 - in_r2_max) * inv_inner >> 8;
-            }
-            else if (real_r2 > out_r2) {
-                if(inv_outer == 0) {
-                    inv_outer = rate2;
+                else {
+                    in_range = 1;
+                    far = 0;
                 }
-                edge_alpha = (out_r2_max - real_r2) * inv_outer >> 8;
-            }
-            else {
-                edge_alpha = SGL_ALPHA_MAX;
-            }
 
-            tmp_color = desc->color;
-            if (flag != 255) {
-                ds = (dx *  sy - dy *  sx);
-                de = (dy *  ex - dx *  ey);
-                in_range =  flag > 0 ? (ds > 0 || de >0) : (ds >= 0 && de >= 0);
-                if (!in_range) {
-
-                    switch (desc->mode) {
-                    case SGL_ARC_MODE_NORMAL:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dx, edge_alpha)) : *blend;
-                        break;
-
-                    case SGL_ARC_MODE_RING:
-                        sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
-                        ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
-                        dx =  sgl_min(sd, ed);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dx, edge_alpha)) : desc->bg_color;
-                        break;
-
-                    case SGL_ARC_MODE_NORMAL_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dx) : desc->color;
-                        break;
-
-                    case SGL_ARC_MODE_RING_SMOOTH:
-                        dx = arc_get_dot(arc_dot, x, y);
-                        tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dx) : desc->color;
-                        break;
-
-                    default: break;
+                if (far && (desc->mode == SGL_ARC_MODE_NORMAL || desc->mode == SGL_ARC_MODE_NORMAL_SMOOTH)) {
+                    blend += end - x + 1;
+                    continue;
+                }
+
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+                /* a mix with SGL_ALPHA_MAX is the foreground color, so the body is a span */
+                if (run[i].band == SGL_DRAW_BAND_BODY && (in_range || far)) {
+                    sgl_color_span(blend, in_range ? desc->color : desc->bg_color, desc->alpha, end - x + 1);
+                    blend += end - x + 1;
+                    continue;
+                }
+#endif
+
+                for (int px = x; px <= end; px++, blend++) {
+                    dx = px - desc->cx;
+                    real_r2 = sgl_pow2(dx) + y2;
+
+                    if (run[i].band == SGL_DRAW_BAND_INNER) {
+                        if(inv_inner == 0) {
+                            inv_inner = rate;
+                        }
+                        edge_alpha  = (real_r2 - in_r2_max) * inv_inner >> 8;
+                    }
+                    else if (run[i].band == SGL_DRAW_BAND_OUTER) {
+                        if(inv_outer == 0) {
+                            inv_outer = rate2;
+                        }
+                        edge_alpha = (out_r2_max - real_r2) * inv_outer >> 8;
+                    }
+                    else {
+                        edge_alpha = SGL_ALPHA_MAX;
+                    }
+
+                    tmp_color = desc->color;
+                    if (!in_range) {
+                        ds = (dx *  sy - dy *  sx);
+                        de = (dy *  ex - dx *  ey);
+
+                        switch (desc->mode) {
+                        case SGL_ARC_MODE_NORMAL:
+                            sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
+                            ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
+                            dx =  sgl_min(sd, ed);
+                            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, sgl_min(255 - dx, edge_alpha)) : *blend;
+                            break;
+
+                        case SGL_ARC_MODE_RING:
+                            sd = sgl_xy_has_component(dx,dy, sx, sy) ? sgl_abs(ds) : 256;
+                            ed = sgl_xy_has_component(dx,dy, ex, ey) ? sgl_abs(de) : 256;
+                            dx =  sgl_min(sd, ed);
+                            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, sgl_min(255 - dx, edge_alpha)) : desc->bg_color;
+                            break;
+
+                        case SGL_ARC_MODE_NORMAL_SMOOTH:
+                            dx = arc_get_dot(arc_dot, px, y);
+                            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, *blend, dx) : desc->color;
+                            break;
+
+                        case SGL_ARC_MODE_RING_SMOOTH:
+                            dx = arc_get_dot(arc_dot, px, y);
+                            tmp_color = (dx < SGL_ALPHA_MAX) ? sgl_color_mixer(desc->color, desc->bg_color, dx) : desc->color;
+                            break;
+
+                        default: break;
+                        }
                     }
+
+                    *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
                 }
             }
-
-            *blend = desc->alpha == SGL_ALPHA_MAX ? sgl_color_mixer(tmp_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(tmp_color, *blend, edge_alpha), *blend, desc->alpha);
         }
         buf += surf->w;
     }
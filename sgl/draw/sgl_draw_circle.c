@@ -55,29 +55,33 @@ void sgl_draw_fill_circle(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_
         return;
     }
 
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
+    int y2 = 0, real_r2 = 0, edge_alpha = 0, num = 0;
     int r2 = sgl_pow2(radius);
     int r2_edge = sgl_pow2(radius + 1);
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
+
+    /* inside below r2, the edge up to r2_edge */
+    sgl_draw_band_init(&band, r2, r2, r2, r2_edge);
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         y2 = sgl_pow2(y - cy);
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
+        num = sgl_draw_band_runs(&band, cx, y2, clip.x1, clip.x2, run);
+
+        for (int i = 0; i < num; i++) {
+            blend = buf + (run[i].x1 - clip.x1);
 
-            if (real_r2 >= r2_edge) {
-                if(x > cx)
-                    break;
+            if (run[i].band == SGL_DRAW_BAND_INSIDE) {
+                sgl_color_span(blend, color, alpha, run[i].x2 - run[i].x1 + 1);
                 continue;
             }
-            else if (real_r2 >= r2) {
+
+            for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                real_r2 = sgl_pow2(x - cx) + y2;
                 edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
                 *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(color, *blend, edge_alpha), *blend, alpha));
             }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-            }
         }
         buf += surf->w;
     }
@@ -119,30 +123,33 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
     uint32_t scale_x = (pixmap->width << SGL_FIXED_SHIFT) / (radius * 2);
     uint32_t scale_y = (pixmap->height << SGL_FIXED_SHIFT) / (radius * 2);
     uint32_t step_x = 0, step_y = 0;
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
+    int num = 0;
+
+    sgl_draw_band_init(&band, r2, r2, r2, r2_max);
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         y2 = sgl_pow2(y - cy);
         step_y = (scale_y * (y - s_y)) >> SGL_FIXED_SHIFT;
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
-
-            step_x = (scale_x * (x - s_x)) >> SGL_FIXED_SHIFT;
-            pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
-
-            if (real_r2 >= r2_max) {
-                if(x > cx)
-                    break;
-                continue;
-            }
-            else if (real_r2 >= r2) {
-                edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(*pbuf, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(*pbuf, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
+        num = sgl_draw_band_runs(&band, cx, y2, clip.x1, clip.x2, run);
+
+        for (int i = 0; i < num; i++) {
+            blend = buf + (run[i].x1 - clip.x1);
+
+            for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                step_x = (scale_x * (x - s_x)) >> SGL_FIXED_SHIFT;
+                pbuf = sgl_pixmap_get_buf(pixmap, step_x, step_y);
+
+                if (run[i].band == SGL_DRAW_BAND_INSIDE) {
+                    *blend = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *blend, alpha));
+                }
+                else {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(*pbuf, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(*pbuf, *blend, edge_alpha), *blend, alpha));
+                }
             }
         }
         buf += surf->w;
@@ -173,30 +180,33 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
 
     const int32_t scale_x = ((int32_t)pixmap->width << SGL_FIXED_SHIFT) / (radius * 2);
     const int32_t scale_y = ((int32_t)pixmap->height << SGL_FIXED_SHIFT) / (radius * 2);
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
+    int num = 0;
+
+    sgl_draw_band_init(&band, r2, r2, r2, r2_max);
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         y2 = sgl_pow2(y - cy);
         fy = (int32_t)(y - s_y) * scale_y;
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
-
-            fx = (int32_t)(x - s_x) * scale_x;
-            ip_color = sgl_draw_biln_color(pix, pixmap->width, pixmap->height, fx, fy);
-
-            if (real_r2 >= r2_max) {
-                if(x > cx)
-                    break;
-                continue;
-            }
-            else if (real_r2 >= r2) {
-                edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(ip_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(ip_color, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? ip_color : sgl_color_mixer(ip_color, *blend, alpha));
+        num = sgl_draw_band_runs(&band, cx, y2, clip.x1, clip.x2, run);
+
+        for (int i = 0; i < num; i++) {
+            blend = buf + (run[i].x1 - clip.x1);
+
+            for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                fx = (int32_t)(x - s_x) * scale_x;
+                ip_color = sgl_draw_biln_color(pix, pixmap->width, pixmap->height, fx, fy);
+
+                if (run[i].band == SGL_DRAW_BAND_INSIDE) {
+                    *blend = (alpha == SGL_ALPHA_MAX ? ip_color : sgl_color_mixer(ip_color, *blend, alpha));
+                }
+                else {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(ip_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(ip_color, *blend, edge_alpha), *blend, alpha));
+                }
             }
         }
         buf += surf->w;
@@ -220,7 +230,7 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
 void sgl_draw_fill_circle_with_border(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius, sgl_color_t color, sgl_color_t border_color, int16_t border_width, uint8_t alpha)
 {
     int radius_in = sgl_max(radius - border_width + 1, 0);
-    int y2 = 0, real_r2 = 0;
+    int y2 = 0, real_r2 = 0, num = 0;
     int in_r2 = sgl_pow2(radius_in);
     int out_r2 = sgl_pow2(radius);
     sgl_color_t *buf = NULL, *blend = NULL;
@@ -229,36 +239,46 @@ void sgl_draw_fill_circle_with_border(sgl_surf_t *surf, sgl_area_t *area, int16_
     int out_r2_max = sgl_pow2(radius + 1);
     uint8_t edge_alpha = 0;
     sgl_area_t clip = SGL_AREA_MAX;
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
 
     sgl_surf_clip_area_return(surf, area, &clip);
 
+    /* the border is the body, its outer edge ends at out_r2_max */
+    sgl_draw_band_init(&band, in_r2_max, in_r2, out_r2 + 1, out_r2_max);
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         y2 = sgl_pow2(y - cy);
-
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
-
-            if (real_r2 >= out_r2_max) {
-                if (x > cx)
-                    break;
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                continue;
-            }
-            if (real_r2 < in_r2 ) {
-                edge_alpha = sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, color, sgl_sqrt_error(real_r2)) : sgl_color_mixer(sgl_color_mixer(border_color, color, edge_alpha), *blend, alpha));
-            }
-            else if (real_r2 > out_r2) {
-                edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, *blend, edge_alpha), *blend, alpha));
-            }
-            else {
-                *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
+        num = sgl_draw_band_runs(&band, cx, y2, clip.x1, clip.x2, run);
+
+        for (int i = 0; i < num; i++) {
+            blend = buf + (run[i].x1 - clip.x1);
+
+            switch (run[i].band) {
+            case SGL_DRAW_BAND_INSIDE:
+                sgl_color_span(blend, color, alpha, run[i].x2 - run[i].x1 + 1);
+                break;
+
+            case SGL_DRAW_BAND_BODY:
+                sgl_color_span(blend, border_color, alpha, run[i].x2 - run[i].x1 + 1);
+                break;
+
+            case SGL_DRAW_BAND_INNER:
+                for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+                    edge_alpha = sgl_sqrt_error(real_r2);
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, color, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, color, edge_alpha), *blend, alpha));
+                }
+                break;
+
+            default:
+                for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+                    *blend = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(border_color, *blend, edge_alpha) : sgl_color_mixer(sgl_color_mixer(border_color, *blend, edge_alpha), *blend, alpha));
+                }
+                break;
             }
         }
         buf += surf->w;
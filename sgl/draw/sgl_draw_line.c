@@ -40,7 +40,7 @@
  */
 void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t x1, int16_t x2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-	sgl_color_t *buf = NULL, *blend = NULL;
+	sgl_color_t *buf = NULL;
 	sgl_area_t c_rect = {.x1 = x1, .x2 = x2, .y1 = y - (width - 1) / 2, .y2 = y + width / 2}, clip = SGL_AREA_MAX;
 
 	if (c_rect.x1 > c_rect.x2) {
@@ -54,10 +54,7 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
 
     buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-		blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-        }
+        sgl_color_span(buf, color, alpha, clip.x2 - clip.x1 + 1);
 		buf += surf->w;
     }
 }
@@ -76,7 +73,7 @@ void sgl_draw_fill_hline(sgl_surf_t *surf, sgl_area_t *area, int16_t y, int16_t
  */
 void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y1, int16_t y2, uint8_t width, sgl_color_t color, uint8_t alpha)
 {
-	sgl_color_t *buf = NULL, *blend = NULL;
+	sgl_color_t *buf = NULL;
 	sgl_area_t c_rect = {.x1 = x - (width - 1) / 2, .x2 = x + width / 2, .y1 = y1,.y2 = y2}, clip = SGL_AREA_MAX;
 
 	if (c_rect.y1 > c_rect.y2) {
@@ -90,87 +87,593 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
 
     buf = sgl_surf_get_buf(surf,  clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-		blend = buf;
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-        }
+        sgl_color_span(buf, color, alpha, clip.x2 - clip.x1 + 1);
         buf += surf->w;
     }
 }
 
+
+#define  LINE_ROW_SEGS                      (16)
+
+
+/**
+ * @brief segment of a thick polyline that reaches a scanline
+ * @a: start point
+ * @b: end point
+ * @len: rounded length of segment
+ * @path: length of polyline before the start point, for the dashes
+ * @outer_x1, outer_x2: pixels of the scanline that the segment may touch
+ * @inner_x1, inner_x2: pixels of the scanline that the segment surely covers, x1 > x2 if none
+ */
+typedef struct line_seg {
+    sgl_pos_t  a;
+    sgl_pos_t  b;
+    int32_t    len;
+    int32_t    path;
+    int32_t    outer_x1;
+    int32_t    outer_x2;
+    int32_t    inner_x1;
+    int32_t    inner_x2;
+} line_seg_t;
+
+
 /**
  * SDF draw anti-aliased line
- * @param thickness line thickness (in pixels)
+ * @return distance of the pixel from the segment << 8, it is the distance from a if a == b
  */
 static int32_t sgl_capsule_sdf_optimized(int16_t px, int16_t py, int16_t ax, int16_t ay, int16_t bx, int16_t by)
 {
 	int64_t pax = px - ax, pay = py - ay, bax = bx - ax, bay = by - ay;
 	int64_t b_sqd = bax * bax + bay * bay;
 	int64_t h = (sgl_max(sgl_min((pax * bax + pay * bay), b_sqd), 0)) << 8;
-	int64_t dx = (pax << 8) - bax * h / b_sqd;
-	int64_t dy = (pay << 8) - bay * h / b_sqd;
+	int64_t dx = (pax << 8) - (b_sqd ? bax * h / b_sqd : 0);
+	int64_t dy = (pay << 8) - (b_sqd ? bay * h / b_sqd : 0);
 
 	return sgl_sqrt(dx * dx + dy * dy);
 }
 
 
 /**
- * @brief draw a slanted line with alpha
- * @param surf surface
- * @param area area that contains the line
- * @param x1 line start x position
- * @param y1 line start y position
- * @param x2 line end x position
- * @param y2 line end y position
- * @param thickness line width
+ * @brief blend a pixel of a thick line by its distance from the line
+ * @param blend pixel
+ * @param len distance of pixel << 8
+ * @param half half of line width
  * @param color line color
  * @param alpha alpha of color
  * @return none
- * @note This algorithm is SDF algorithm
  */
-void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha)
+static inline void line_blend_sdf(sgl_color_t *blend, int32_t len, int32_t half, sgl_color_t color, uint8_t alpha)
 {
     uint8_t c;
-    int64_t len;
-    sgl_area_t clip = SGL_AREA_MAX;
-    sgl_color_t *buf = NULL, *blend = NULL;
-    int16_t thick_half = (thickness >> 1);
 
-    sgl_area_t c_rect = {
-        .x1 = (x1 < x2 ? x1 : x2) - thick_half,
-        .x2 = (x1 > x2 ? x1 : x2) + thick_half,
-        .y1 = (y1 < y2 ? y1 : y2) - thick_half,
-        .y2 = (y1 > y2 ? y1 : y2) + thick_half,
-    };
+    if (len <= (half - 1) << 8) {
+        *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
+    }
+    else if (len < (half << 8)) {
+        c = len - ((half - 1) << 8);
 
-    sgl_surf_clip_area_return(surf, area, &clip);
-    if (!sgl_area_selfclip(&clip, &c_rect)) {
+        if (alpha == SGL_ALPHA_MAX)
+            *blend = sgl_color_mixer(*blend, color, c);
+        else
+            *blend = sgl_color_mixer(sgl_color_mixer(*blend, color, c), *blend, alpha);
+    }
+}
+
+
+/**
+ * @brief blend a pixel of a line of width 1 by its coverage
+ * @param blend pixel
+ * @param cov coverage of pixel
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ */
+static inline void line_blend_cov(sgl_color_t *blend, uint8_t cov, sgl_color_t color, uint8_t alpha)
+{
+    sgl_color_t c = (cov == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, cov));
+
+    *blend = (alpha == SGL_ALPHA_MAX ? c : sgl_color_mixer(c, *blend, alpha));
+}
+
+
+/**
+ * @brief get the pixels of a scanline within a distance of a segment, they are the caps at both
+ *        ends and the band between them
+ * @param dx x of segment end from its start
+ * @param dy y of segment end from its start
+ * @param py y of scanline from segment start
+ * @param d distance
+ * @param len length of segment, the band is d * len / length wide on each side
+ * @param hull true for the hull of the pieces, false for the longest run that they cover
+ * @param lo first x from segment start
+ * @param hi last x from segment start, it is below lo if no pixel matches
+ * @return none
+ */
+static void line_capsule_row(int32_t dx, int32_t dy, int32_t py, int32_t d, int32_t len, bool hull, int32_t *lo, int32_t *hi)
+{
+    int32_t piece[3][2], num = 0, q, t1, t2, d2 = dx * dx + dy * dy;
+
+    q = d * d - py * py;
+    if (q >= 0) {
+        q = sgl_sqrt(q);
+        piece[num][0] = -q;
+        piece[num++][1] = q;
+    }
+
+    q = d * d - (py - dy) * (py - dy);
+    if (q >= 0) {
+        q = sgl_sqrt(q);
+        piece[num][0] = dx - q;
+        piece[num++][1] = dx + q;
+    }
+
+    /* the band is cut by the two sides of the line and by the normals at both ends */
+    if (d2 > 0) {
+        sgl_draw_half_line(dy, d * len - py * dx, &piece[num][0], &piece[num][1]);
+        sgl_draw_half_line(-dy, d * len + py * dx, &t1, &t2);
+        piece[num][0] = sgl_max(piece[num][0], t1);
+        piece[num][1] = sgl_min(piece[num][1], t2);
+        sgl_draw_half_line(dx, py * dy, &t1, &t2);
+        piece[num][0] = sgl_max(piece[num][0], t1);
+        piece[num][1] = sgl_min(piece[num][1], t2);
+        sgl_draw_half_line(-dx, d2 - py * dy, &t1, &t2);
+        piece[num][0] = sgl_max(piece[num][0], t1);
+        piece[num][1] = sgl_min(piece[num][1], t2);
+        if (piece[num][0] <= piece[num][1]) {
+            num ++;
+        }
+    }
+
+    *lo = SGL_DRAW_HALF_LINE_INF;
+    *hi = -SGL_DRAW_HALF_LINE_INF;
+
+    if (hull) {
+        for (int i = 0; i < num; i++) {
+            *lo = sgl_min(*lo, piece[i][0]);
+            *hi = sgl_max(*hi, piece[i][1]);
+        }
         return;
     }
 
-    buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
-    for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
+    /* the band of a narrower d can be thinner than the caps, so the pieces may not touch */
+    for (int i = 1; i < num; i++) {
+        for (int j = i; j > 0 && piece[j][0] < piece[j - 1][0]; j--) {
+            sgl_swap(&piece[j][0], &piece[j - 1][0]);
+            sgl_swap(&piece[j][1], &piece[j - 1][1]);
+        }
+    }
+
+    for (int i = 0; i < num; i++) {
+        t1 = piece[i][0];
+        t2 = piece[i][1];
+        while (i + 1 < num && piece[i + 1][0] <= t2 + 1) {
+            i ++;
+            t2 = sgl_max(t2, piece[i][1]);
+        }
+        if (t2 - t1 > *hi - *lo) {
+            *lo = t1;
+            *hi = t2;
+        }
+    }
+}
+
+
+/**
+ * @brief set the pixels of a scanline that a segment of a thick line may touch or surely covers
+ * @param seg segment, its points and length are set
+ * @param y y of scanline
+ * @param half half of line width
+ * @param clip clip area
+ * @return false if the segment misses the scanline
+ * @note a pixel is solid if its SDF is at most (half - 1) << 8 and is touched if it is below
+ *       half << 8, the SDF is within a few 1/256 of the distance, so the ranges are taken at the
+ *       distances half - 2 and half + 1, with the length of segment rounded to the safe side
+ */
+static bool line_seg_row(line_seg_t *seg, int y, int32_t half, sgl_area_t *clip)
+{
+    int32_t dx = seg->b.x - seg->a.x, dy = seg->b.y - seg->a.y, py = y - seg->a.y, lo, hi;
+
+    if (y < sgl_min(seg->a.y, seg->b.y) - half - 1 || y > sgl_max(seg->a.y, seg->b.y) + half + 1) {
+        return false;
+    }
+
+    line_capsule_row(dx, dy, py, half + 1, seg->len + 1, true, &lo, &hi);
+    seg->outer_x1 = sgl_max(seg->a.x + lo, clip->x1);
+    seg->outer_x2 = sgl_min(seg->a.x + hi, clip->x2);
+    if (seg->outer_x1 > seg->outer_x2) {
+        return false;
+    }
+
+    seg->inner_x1 = 1;
+    seg->inner_x2 = 0;
+    if (half >= 2) {
+        line_capsule_row(dx, dy, py, half - 2, seg->len, false, &lo, &hi);
+        if (lo <= hi) {
+            seg->inner_x1 = sgl_max(seg->a.x + lo, clip->x1);
+            seg->inner_x2 = sgl_min(seg->a.x + hi, clip->x2);
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief check if a pixel of a dashed line is in a dash
+ * @param seg segment nearest to the pixel
+ * @param x x of pixel
+ * @param y y of pixel
+ * @param desc polyline description
+ * @return true if the pixel is in a dash
+ */
+static bool line_seg_dash(const line_seg_t *seg, int x, int y, const sgl_draw_polyline_t *desc)
+{
+    int32_t dx = seg->b.x - seg->a.x, dy = seg->b.y - seg->a.y;
+    int32_t t = (x - seg->a.x) * dx + (y - seg->a.y) * dy;
+
+    t = seg->len ? sgl_max(sgl_min(t, dx * dx + dy * dy), 0) / seg->len : 0;
+    return (uint32_t)(seg->path + t) % (desc->dash_on + desc->dash_off) < desc->dash_on;
+}
+
+
+/**
+ * @brief draw a scanline of a thick polyline, the interior of each segment is filled as a span
+ *        and only the pixels near the edges are tested, by the nearest segment
+ * @param row pixel of the scanline at x of surface
+ * @param x0 x of surface
+ * @param y y of scanline
+ * @param seg segments that reach the scanline
+ * @param num number of segments
+ * @param half half of line width
+ * @param desc polyline description
+ * @return none
+ */
+static void line_row_draw(sgl_color_t *row, int16_t x0, int y, const line_seg_t *seg, int num, int32_t half, const sgl_draw_polyline_t *desc)
+{
+    bool dash = desc->dash_on > 0;
+    int32_t x = SGL_DRAW_HALF_LINE_INF, end = -SGL_DRAW_HALF_LINE_INF, solid, next, len, best, near;
+    const line_seg_t *nearest;
+
+    for (int i = 0; i < num; i++) {
+        x = sgl_min(x, seg[i].outer_x1);
+        end = sgl_max(end, seg[i].outer_x2);
+    }
+
+    while (x <= end) {
+        solid = x - 1;
+        next = end;
+
+        /* the solid runs of the segments are joined, a dashed line has none */
+        for (bool grown = !dash; grown; ) {
+            grown = false;
+            for (int i = 0; i < num; i++) {
+                if (seg[i].inner_x1 <= solid + 1 && seg[i].inner_x2 > solid) {
+                    solid = seg[i].inner_x2;
+                    grown = true;
+                }
+            }
+        }
+
+        if (solid >= x) {
+            sgl_color_span(row + (x - x0), desc->color, desc->alpha, solid - x + 1);
+            x = solid + 1;
+            continue;
+        }
+
+        for (int i = 0; i < num && !dash; i++) {
+            if (seg[i].inner_x1 > x && seg[i].inner_x1 <= seg[i].inner_x2) {
+                next = sgl_min(next, seg[i].inner_x1 - 1);
+            }
+        }
+
+        for (; x <= next; x++) {
+            best = INT32_MAX;
+            near = next + 1;
+            nearest = NULL;
+
+            for (int i = 0; i < num; i++) {
+                if (seg[i].outer_x1 > x) {
+                    near = sgl_min(near, seg[i].outer_x1);
+                }
+                else if (seg[i].outer_x2 >= x) {
+                    len = sgl_capsule_sdf_optimized(x, y, seg[i].a.x, seg[i].a.y, seg[i].b.x, seg[i].b.y);
+                    if (len < best) {
+                        best = len;
+                        nearest = &seg[i];
+                    }
+                }
+            }
+
+            /* no segment reaches the pixel, skip to the next one that does */
+            if (nearest == NULL) {
+                x = near - 1;
+                continue;
+            }
+
+            if (dash && !line_seg_dash(nearest, x, y, desc)) {
+                continue;
+            }
 
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            len = sgl_capsule_sdf_optimized(x, y, x1, y1, x2, y2);
+            line_blend_sdf(row + (x - x0), best, half, desc->color, desc->alpha);
+        }
+    }
+}
+
+
+/**
+ * @brief draw a thick polyline by scanlines
+ * @param surf surface
+ * @param clip clip area
+ * @param x x coordinate of the origin of points
+ * @param y y coordinate of the origin of points
+ * @param points points of the polyline
+ * @param count number of points
+ * @param segs number of segments
+ * @param desc polyline description
+ * @return none
+ * @note the segments of a scanline are kept on the stack, a scanline that more than LINE_ROW_SEGS
+ *       segments reach tests its pixels by all segments
+ */
+static void line_draw_thick(sgl_surf_t *surf, sgl_area_t *clip, int16_t x, int16_t y, const sgl_pos_t *points, uint16_t count, uint16_t segs, const sgl_draw_polyline_t *desc)
+{
+    int32_t half = desc->width >> 1, y1 = INT16_MAX, y2 = INT16_MIN, path, len, best;
+    line_seg_t seg[LINE_ROW_SEGS], tmp, *nearest;
+    sgl_color_t *row;
+    int num;
+    bool over;
+
+    for (uint16_t i = 0; i < count; i++) {
+        y1 = sgl_min(y1, y + points[i].y);
+        y2 = sgl_max(y2, y + points[i].y);
+    }
+
+    y1 = sgl_max(y1 - half - 1, clip->y1);
+    y2 = sgl_min(y2 + half + 1, clip->y2);
 
-            if (len <= (thick_half - 1) << 8) {
-                *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
+    for (int py = y1; py <= y2; py++) {
+        row = sgl_surf_get_buf(surf, 0, py - surf->y1);
+        num = 0;
+        over = false;
+        path = 0;
+
+        for (uint16_t i = 0; i < segs; i++) {
+            tmp.a.x = x + points[i].x;
+            tmp.a.y = y + points[i].y;
+            tmp.b.x = x + points[(i + 1) % count].x;
+            tmp.b.y = y + points[(i + 1) % count].y;
+
+            /* the length of a segment that misses the scanline is only needed for the dashes */
+            if (!desc->dash_on && (py < sgl_min(tmp.a.y, tmp.b.y) - half - 1 || py > sgl_max(tmp.a.y, tmp.b.y) + half + 1)) {
                 continue;
             }
 
-            if (len > ((thick_half - 1) << 8) && len < (thick_half << 8)) {
-                c = len - ((thick_half - 1) << 8);
+            tmp.len = sgl_sqrt(sgl_pow2(tmp.b.x - tmp.a.x) + sgl_pow2(tmp.b.y - tmp.a.y));
+            tmp.path = path;
+            path += tmp.len;
 
-                if (alpha == SGL_ALPHA_MAX)
-                    *blend = sgl_color_mixer(*blend, color, c);
-                else
-                    *blend = sgl_color_mixer(sgl_color_mixer(*blend, color, c), *blend, alpha);
+            if (line_seg_row(&tmp, py, half, clip)) {
+                if (num < LINE_ROW_SEGS) {
+                    seg[num++] = tmp;
+                }
+                else {
+                    over = true;
+                }
             }
         }
-        buf += surf->w;
+
+        if (!over) {
+            line_row_draw(row, surf->x1, py, seg, num, half, desc);
+            continue;
+        }
+
+        for (int px = clip->x1; px <= clip->x2; px++) {
+            best = INT32_MAX;
+            nearest = NULL;
+            path = 0;
+
+            for (uint16_t i = 0; i < segs; i++) {
+                tmp.a.x = x + points[i].x;
+                tmp.a.y = y + points[i].y;
+                tmp.b.x = x + points[(i + 1) % count].x;
+                tmp.b.y = y + points[(i + 1) % count].y;
+                tmp.len = sgl_sqrt(sgl_pow2(tmp.b.x - tmp.a.x) + sgl_pow2(tmp.b.y - tmp.a.y));
+                tmp.path = path;
+                path += tmp.len;
+
+                if (px < sgl_min(tmp.a.x, tmp.b.x) - half || px > sgl_max(tmp.a.x, tmp.b.x) + half
+                    || py < sgl_min(tmp.a.y, tmp.b.y) - half || py > sgl_max(tmp.a.y, tmp.b.y) + half) {
+                    continue;
+                }
+
+                len = sgl_capsule_sdf_optimized(px, py, tmp.a.x, tmp.a.y, tmp.b.x, tmp.b.y);
+                if (len < best) {
+                    best = len;
+                    seg[0] = tmp;
+                    nearest = &seg[0];
+                }
+            }
+
+            if (nearest == NULL || (desc->dash_on && !line_seg_dash(nearest, px, py, desc))) {
+                continue;
+            }
+
+            line_blend_sdf(row + (px - surf->x1), best, half, desc->color, desc->alpha);
+        }
+    }
+}
+
+
+/**
+ * @brief draw a segment of width 1, every step on the longer axis blends the two pixels next to
+ *        the line by their coverage, only the steps in the clip area are walked
+ * @param surf surface
+ * @param clip clip area
+ * @param a start point
+ * @param b end point
+ * @param first first step to draw, it is 1 if the start point is drawn by the segment before
+ * @param last last step to draw
+ * @param dash steps of the polyline before the segment, for the dashes
+ * @param desc polyline description
+ * @return none
+ */
+static void line_draw_thin(sgl_surf_t *surf, sgl_area_t *clip, sgl_pos_t a, sgl_pos_t b, int32_t first, int32_t last, uint32_t dash, const sgl_draw_polyline_t *desc)
+{
+    bool steep = sgl_abs(b.y - a.y) > sgl_abs(b.x - a.x);
+    int32_t major = steep ? a.y : a.x, minor = steep ? a.x : a.y;
+    int32_t d_major = steep ? b.y - a.y : b.x - a.x, d_minor = steep ? b.x - a.x : b.y - a.y;
+    int32_t c_major1 = steep ? clip->y1 : clip->x1, c_major2 = steep ? clip->y2 : clip->x2;
+    int32_t c_minor1 = steep ? clip->x1 : clip->y1, c_minor2 = steep ? clip->x2 : clip->y2;
+    int32_t n = sgl_abs(d_major), dm = sgl_abs(d_minor), step = d_major < 0 ? -1 : 1, dir = d_minor < 0 ? -1 : 1;
+    int32_t lo, hi, q, r, q_step, r_step, m, f, period = desc->dash_on + desc->dash_off;
+    uint32_t phase = 0;
+    sgl_color_t *buf;
+
+    /* steps whose major is in the clip area */
+    sgl_draw_half_line(step, major - c_major1, &lo, &hi);
+    first = sgl_max(first, lo);
+    last = sgl_min(last, hi);
+    sgl_draw_half_line(-step, c_major2 - major, &lo, &hi);
+    first = sgl_max(first, lo);
+    last = sgl_min(last, hi);
+
+    /* the pixels of step i are within one pixel of i * dm / n from minor, on the side of dir */
+    lo = dir > 0 ? c_minor1 - minor - 1 : minor - c_minor2 - 1;
+    hi = dir > 0 ? c_minor2 - minor + 1 : minor - c_minor1 + 1;
+    if (n == 0) {
+        if (lo > 0 || hi < 0) {
+            return;
+        }
+    }
+    else {
+        sgl_draw_half_line(dm, -lo * n, &lo, &q);
+        sgl_draw_half_line(-dm, hi * n, &q, &hi);
+        first = sgl_max(first, lo);
+        last = sgl_min(last, hi);
+    }
+
+    if (first > last) {
+        return;
+    }
+
+    /* q is the minor offset of a step in 1/256 pixel, r is its remainder of n */
+    if (n != 0) {
+        q = (int32_t)((int64_t)first * dm * 256 / n);
+        r = (int32_t)((int64_t)first * dm * 256 % n);
+        q_step = dm * 256 / n;
+        r_step = dm * 256 % n;
+    }
+    else {
+        q = r = q_step = r_step = 0;
+    }
+
+    if (period) {
+        phase = (dash + first) % period;
+    }
+
+    for (int32_t i = first; i <= last; i++) {
+        if (!period || phase < desc->dash_on) {
+            m = minor + dir * (q >> 8);
+            f = q & 0xff;
+
+            for (int k = 0; k < 2; k++, m += dir) {
+                if (m >= c_minor1 && m <= c_minor2) {
+                    buf = steep ? sgl_surf_get_buf(surf, m - surf->x1, major + step * i - surf->y1)
+                                : sgl_surf_get_buf(surf, major + step * i - surf->x1, m - surf->y1);
+                    line_blend_cov(buf, k == 0 ? (f ? 256 - f : SGL_ALPHA_MAX) : f, desc->color, desc->alpha);
+                }
+
+                if (f == 0) {
+                    break;
+                }
+            }
+        }
+
+        if (period && ++phase >= (uint32_t)period) {
+            phase = 0;
+        }
+
+        q += q_step;
+        r += r_step;
+        if (r >= n && n != 0) {
+            q ++;
+            r -= n;
+        }
+    }
+}
+
+
+/**
+ * @brief draw a polyline, the pixels near a joint are blended once
+ * @param surf surface
+ * @param area area that contains the polyline
+ * @param x x coordinate of the origin of points
+ * @param y y coordinate of the origin of points
+ * @param points points of the polyline
+ * @param count number of points
+ * @param desc polyline description
+ * @return none
+ * @note the dashes of a line of width 1 are counted in steps of its longer axis, the others
+ *       along the polyline
+ */
+void sgl_draw_polyline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_pos_t *points, uint16_t count, const sgl_draw_polyline_t *desc)
+{
+    sgl_area_t clip = SGL_AREA_MAX;
+    uint16_t segs = (desc->closed && count > 2) ? count : count - 1;
+    sgl_pos_t a, b;
+    uint32_t dash = 0;
+    int32_t n;
+
+    if (count < 2 || desc->width == 0) {
+        return;
+    }
+
+    sgl_surf_clip_area_return(surf, area, &clip);
+
+    if (desc->width > 1) {
+        line_draw_thick(surf, &clip, x, y, points, count, segs, desc);
+        return;
+    }
+
+    /* a joint is the last step of a segment and is skipped as the first step of the next one */
+    for (uint16_t i = 0; i < segs; i++) {
+        a.x = x + points[i].x;
+        a.y = y + points[i].y;
+        b.x = x + points[(i + 1) % count].x;
+        b.y = y + points[(i + 1) % count].y;
+        n = sgl_max(sgl_abs(b.x - a.x), sgl_abs(b.y - a.y));
+
+        line_draw_thin(surf, &clip, a, b, i > 0, (segs == count && i == segs - 1) ? n - 1 : n, dash, desc);
+        dash += n;
+    }
+}
+
+
+/**
+ * @brief draw a slanted line with alpha
+ * @param surf surface
+ * @param area area that contains the line
+ * @param x1 line start x position
+ * @param y1 line start y position
+ * @param x2 line end x position
+ * @param y2 line end y position
+ * @param thickness line width
+ * @param color line color
+ * @param alpha alpha of color
+ * @return none
+ * @note the pixels are tested by a capsule SDF only near the edges of each scanline
+ */
+void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha)
+{
+    sgl_draw_polyline_t desc = { .color = color, .alpha = alpha, .width = (uint8_t)sgl_min(thickness, 255) };
+    sgl_pos_t points[2] = { { x1, y1 }, { x2, y2 } };
+    sgl_area_t clip = SGL_AREA_MAX;
+
+    if ((thickness >> 1) == 0) {
+        return;
     }
+
+    sgl_surf_clip_area_return(surf, area, &clip);
+    line_draw_thick(surf, &clip, 0, 0, points, 2, 1, &desc);
 }
 
 
@@ -183,6 +686,9 @@ void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int1
  */
 void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_line_t *desc)
 {
+	sgl_draw_polyline_t line = { .color = desc->color, .alpha = desc->alpha, .width = desc->width };
+	sgl_pos_t points[2] = { { desc->x1, desc->y1 }, { desc->x2, desc->y2 } };
+
 	if (desc->x1 == desc->x2) {
 		sgl_draw_fill_vline(surf, area, desc->x1, desc->y1, desc->y2, desc->width / 2, desc->color, desc->alpha);
 	}
@@ -190,6 +696,6 @@ void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_line_t *desc)
 		sgl_draw_fill_hline(surf, area, desc->y1, desc->x1, desc->x2, desc->width / 2, desc->color, desc->alpha);
 	}
 	else {
-		draw_line_fill_slanted(surf, area, desc->x1, desc->y1, desc->x2, desc->y2, desc->width, desc->color, desc->alpha);
+		sgl_draw_polyline(surf, area, 0, 0, points, 2, &line);
 	}
 }
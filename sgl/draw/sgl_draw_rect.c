@@ -26,6 +26,348 @@
 #include <sgl_core.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+
+
+/**
+ * @brief fill a row of rectangle, the pixels inside [in_x1, in_x2] are color, others are border
+ * @param buf pointer to the pixel at x1
+ * @param x1 start x of row
+ * @param x2 end x of row
+ * @param in_x1 start x of inner part
+ * @param in_x2 end x of inner part
+ * @param color color of inner part
+ * @param border_color color of border
+ * @param alpha alpha of rectangle
+ * @return none
+ */
+static inline void draw_rect_border_row(sgl_color_t *buf, int x1, int x2, int in_x1, int in_x2, sgl_color_t color, sgl_color_t border_color, uint8_t alpha)
+{
+    int end;
+
+    while (x1 <= x2) {
+        if (x1 < in_x1 || x1 > in_x2) {
+            end = x1 < in_x1 ? sgl_min(x2, in_x1 - 1) : x2;
+            sgl_color_span(buf, border_color, alpha, end - x1 + 1);
+        }
+        else {
+            end = sgl_min(x2, in_x2);
+            sgl_color_span(buf, color, alpha, end - x1 + 1);
+        }
+
+        buf += end - x1 + 1;
+        x1 = end + 1;
+    }
+}
+
+
+#if (CONFIG_SGL_DRAW_CORNER_CACHE)
+/**
+ * @brief coverage of one row of a corner, dx is the distance of a pixel from the corner center,
+ *        the pixels of a row are in this order from the center to the outside
+ * @solid: dx below it is inside, the fill color
+ * @inner: dx from solid and below it is the anti-aliased inner edge of the border
+ * @border: dx from inner and below it is the border, the fill color if the rect has no border
+ * @outer: dx from border and below it is the anti-aliased outer edge, the others are outside
+ * @alpha: index of the first inner edge alpha of the row, the outer edge alphas follow them
+ */
+typedef struct draw_corner_row {
+    uint16_t  solid;
+    uint16_t  inner;
+    uint16_t  border;
+    uint16_t  outer;
+    uint16_t  alpha;
+} draw_corner_row_t;
+
+
+/**
+ * @brief coverage mask of a quarter circle, it is one heap block with the rows and the alphas
+ * @radius: radius of the corner
+ * @radius_in: inner radius of the border, -1 if the rect has no border
+ * @stamp: time of the last use, the oldest mask is dropped when the cache is full
+ * @row: radius + 1 rows, the index is dy
+ * @alpha: edge alphas of all rows
+ */
+typedef struct draw_corner {
+    int16_t            radius;
+    int16_t            radius_in;
+    uint32_t           stamp;
+    draw_corner_row_t  *row;
+    uint8_t            *alpha;
+} draw_corner_t;
+
+
+static struct {
+    draw_corner_t  *mask[CONFIG_SGL_DRAW_CORNER_CACHE];
+    uint32_t       stamp;
+} draw_corner_cache;
+
+
+/**
+ * @brief classify a pixel of a corner, the tests are the same as the per pixel code below
+ * @param real_r2 squared distance from the corner center
+ * @param radius radius of the corner
+ * @param radius_in inner radius of the border, -1 if the rect has no border
+ * @return 0: inside, 1: inner edge, 2: border, 3: outer edge, 4: outside
+ */
+static inline int draw_corner_class(int real_r2, int radius, int radius_in)
+{
+    if (real_r2 >= sgl_pow2(radius + 1)) {
+        return 4;
+    }
+
+    if (radius_in < 0) {
+        return real_r2 >= sgl_pow2(radius) ? 3 : 0;
+    }
+
+    if (real_r2 < sgl_pow2(radius_in - 1)) {
+        return 0;
+    }
+
+    if (real_r2 < sgl_pow2(radius_in)) {
+        return 1;
+    }
+
+    return real_r2 > sgl_pow2(radius) ? 3 : 2;
+}
+
+
+/**
+ * @brief build the coverage mask of a corner
+ * @param radius radius of the corner
+ * @param radius_in inner radius of the border, -1 if the rect has no border
+ * @return the mask, NULL if out of memory
+ * @note the distance grows with dx, so the classes of a row never go back and the row is
+ *       kept as four bounds, only the edge pixels have an alpha
+ */
+static draw_corner_t* draw_corner_build(int16_t radius, int16_t radius_in)
+{
+    draw_corner_t *corner;
+    draw_corner_row_t *row;
+    uint16_t *bound;
+    size_t edges = 0;
+    int cls;
+
+    for (int dy = 0; dy <= radius; dy++) {
+        for (int dx = 0; dx <= radius; dx++) {
+            cls = draw_corner_class(sgl_pow2(dx) + sgl_pow2(dy), radius, radius_in);
+            edges += (cls == 1 || cls == 3);
+        }
+    }
+
+    corner = sgl_malloc(sizeof(draw_corner_t) + (radius + 1) * sizeof(draw_corner_row_t) + edges);
+    if (corner == NULL) {
+        return NULL;
+    }
+
+    corner->radius = radius;
+    corner->radius_in = radius_in;
+    corner->row = (draw_corner_row_t*)(corner + 1);
+    corner->alpha = (uint8_t*)(corner->row + radius + 1);
+    edges = 0;
+
+    for (int dy = 0; dy <= radius; dy++) {
+        row = &corner->row[dy];
+        row->solid = row->inner = row->border = row->outer = radius + 1;
+        row->alpha = (uint16_t)edges;
+        bound = &row->solid;
+
+        for (int dx = 0; dx <= radius; dx++) {
+            int real_r2 = sgl_pow2(dx) + sgl_pow2(dy);
+            cls = draw_corner_class(real_r2, radius, radius_in);
+
+            /* the first pixel of a class ends all classes before it */
+            for (int i = 0; i < cls; i++) {
+                bound[i] = sgl_min(bound[i], dx);
+            }
+
+            if (cls == 1) {
+                corner->alpha[edges++] = sgl_sqrt_error(real_r2);
+            }
+            else if (cls == 3) {
+                corner->alpha[edges++] = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+            }
+        }
+    }
+
+    return corner;
+}
+
+
+/**
+ * @brief get the coverage mask of a corner from the cache, it is built on the first use
+ * @param radius radius of the corner
+ * @param radius_in inner radius of the border, -1 if the rect has no border
+ * @return the mask, NULL if out of memory, then the per pixel code is used
+ */
+static draw_corner_t* draw_corner_get(int16_t radius, int16_t radius_in)
+{
+    int slot = 0;
+
+    draw_corner_cache.stamp ++;
+
+    for (int i = 0; i < CONFIG_SGL_DRAW_CORNER_CACHE; i++) {
+        draw_corner_t *corner = draw_corner_cache.mask[i];
+
+        if (corner == NULL) {
+            slot = i;
+            break;
+        }
+
+        if (corner->radius == radius && corner->radius_in == radius_in) {
+            corner->stamp = draw_corner_cache.stamp;
+            return corner;
+        }
+
+        if (corner->stamp < draw_corner_cache.mask[slot]->stamp) {
+            slot = i;
+        }
+    }
+
+    if (draw_corner_cache.mask[slot] != NULL) {
+        sgl_free(draw_corner_cache.mask[slot]);
+    }
+
+    draw_corner_cache.mask[slot] = draw_corner_build(radius, radius_in);
+    if (draw_corner_cache.mask[slot] == NULL) {
+        SGL_LOG_WARN("draw_corner_get: out of memory, radius %d", radius);
+        return NULL;
+    }
+
+    draw_corner_cache.mask[slot]->stamp = draw_corner_cache.stamp;
+    return draw_corner_cache.mask[slot];
+}
+
+
+/**
+ * @brief draw the pixels of a corner row on one side of the rect, every class is a run
+ * @param buf pointer to the pixel at x1
+ * @param x1 first x of the side
+ * @param x2 last x of the side
+ * @param x0 x of the corner center, where dx is 0
+ * @param left true if dx grows to the left
+ * @param corner coverage mask
+ * @param row coverage of the row
+ * @param color fill color
+ * @param border_color border color, it is the fill color if the rect has no border
+ * @param alpha alpha of rectangle
+ * @return none
+ */
+static void draw_corner_side(sgl_color_t *buf, int x1, int x2, int x0, bool left, draw_corner_t *corner,
+                             draw_corner_row_t *row, sgl_color_t color, sgl_color_t border_color, uint8_t alpha)
+{
+    const uint16_t lo[4] = { 0, row->solid, row->inner, row->border };
+    const uint16_t hi[4] = { row->solid, row->inner, row->border, row->outer };
+    sgl_color_t *blend;
+    sgl_color_t mix;
+    int rx1, rx2, edge;
+
+    for (int cls = 0; cls < 4; cls++) {
+        if (lo[cls] >= hi[cls]) {
+            continue;
+        }
+
+        rx1 = left ? sgl_max(x1, x0 - hi[cls] + 1) : sgl_max(x1, x0 + lo[cls]);
+        rx2 = left ? sgl_min(x2, x0 - lo[cls]) : sgl_min(x2, x0 + hi[cls] - 1);
+        if (rx1 > rx2) {
+            continue;
+        }
+
+        blend = buf + (rx1 - x1);
+        if (cls == 0 || cls == 2) {
+            sgl_color_span(blend, cls ? border_color : color, alpha, rx2 - rx1 + 1);
+            continue;
+        }
+
+        /* the alphas of the inner edge come first, then the ones of the outer edge */
+        edge = row->alpha + (cls == 1 ? -row->solid : row->inner - row->solid - row->border);
+        for (int x = rx1; x <= rx2; x++, blend++) {
+            uint8_t edge_alpha = corner->alpha[edge + (left ? x0 - x : x - x0)];
+            mix = cls == 1 ? sgl_color_mixer(border_color, color, edge_alpha) : sgl_color_mixer(border_color, *blend, edge_alpha);
+            *blend = (alpha == SGL_ALPHA_MAX ? mix : sgl_color_mixer(mix, *blend, alpha));
+        }
+    }
+}
+
+
+/**
+ * @brief fill a round rectangle with alpha, the corners come from the coverage mask
+ * @param surf point to surface
+ * @param clip area to draw, it is inside the surface and the rectangle
+ * @param rect point to rectangle that you want to draw
+ * @param radius radius of round
+ * @param color color of rectangle
+ * @param border_color color of border, it is color if border_width is 0
+ * @param border_width width of border
+ * @param alpha alpha of rectangle
+ * @return false if there is no mask, the caller draws the rect pixel by pixel
+ * @note it draws the same pixels as sgl_draw_fill_rect() and sgl_draw_fill_rect_with_border()
+ */
+static bool draw_rect_masked(sgl_surf_t *surf, sgl_area_t *clip, sgl_area_t *rect, int16_t radius,
+                             sgl_color_t color, sgl_color_t border_color, uint8_t border_width, uint8_t alpha)
+{
+    int radius_in = border_width ? sgl_max(radius - border_width + 1, 0) : -1;
+    draw_corner_t *corner = draw_corner_get(radius, radius_in);
+    sgl_color_t *buf;
+    int cx1 = rect->x1 + radius;
+    int cx2 = rect->x2 - radius;
+    int cy1 = rect->y1 + radius;
+    int cy2 = rect->y2 - radius;
+    int cx1i = rect->x1 + border_width;
+    int cx2i = rect->x2 - border_width;
+    int cyi1 = rect->y1 + border_width;
+    int cyi2 = rect->y2 - border_width;
+    int left_end, right_start, x1, x2;
+
+    if (corner == NULL) {
+        return false;
+    }
+
+    /* the straight part of a corner row, it is (cx1, cx2) without border and [cx1, cx2] with it */
+    if (border_width) {
+        left_end = cx1 > cx2 ? cx1 : cx1 - 1;
+        right_start = sgl_max(cx1, cx2) + 1;
+    }
+    else {
+        left_end = cx1;
+        right_start = sgl_max(cx2, cx1 + 1);
+    }
+
+    buf = sgl_surf_get_buf(surf, clip->x1 - surf->x1, clip->y1 - surf->y1);
+    for (int y = clip->y1; y <= clip->y2; y++, buf += surf->w) {
+        if (y > cy1 && y < cy2) {
+            if (border_width) {
+                draw_rect_border_row(buf, clip->x1, clip->x2, cx1i, cx2i, color, border_color, alpha);
+            }
+            else {
+                sgl_color_span(buf, color, alpha, clip->x2 - clip->x1 + 1);
+            }
+            continue;
+        }
+
+        draw_corner_row_t *row = &corner->row[y > cy1 ? y - cy2 : cy1 - y];
+
+        x2 = sgl_min(clip->x2, left_end);
+        if (clip->x1 <= x2) {
+            draw_corner_side(buf, clip->x1, x2, cx1, true, corner, row, color, border_color, alpha);
+        }
+
+        x1 = sgl_max(clip->x1, left_end + 1);
+        x2 = sgl_min(clip->x2, right_start - 1);
+        if (x1 <= x2) {
+            sgl_color_span(buf + (x1 - clip->x1), (border_width && (y < cyi1 || y > cyi2)) ? border_color : color, alpha, x2 - x1 + 1);
+        }
+
+        x1 = sgl_max(clip->x1, right_start);
+        if (x1 <= clip->x2) {
+            draw_corner_side(buf + (x1 - clip->x1), x1, clip->x2, cx2, false, corner, row, color, border_color, alpha);
+        }
+    }
+
+    return true;
+}
+#endif // !CONFIG_SGL_DRAW_CORNER_CACHE
 
 
 /**
@@ -49,6 +391,7 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
     int cy2 = rect->y2 - radius;
     int cx_tmp = 0;
     int cy_tmp = 0;
+    int span = 0;
 
     if (!sgl_surf_clip(surf, area, &clip)) {
         return;
@@ -62,13 +405,16 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
     int r2 = sgl_pow2(radius);
     int r2_edge = sgl_pow2(radius + 1);
 
+#if (CONFIG_SGL_DRAW_CORNER_CACHE)
+    if (radius > 0 && draw_rect_masked(surf, &clip, rect, radius, color, color, 0, alpha)) {
+        return;
+    }
+#endif
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     if (radius == 0) {
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-            }
+            sgl_color_span(buf, color, alpha, clip.x2 - clip.x1 + 1);
             buf += surf->w;
         }
     }
@@ -76,9 +422,7 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
         for (int y = clip.y1; y <= clip.y2; y++) {
             blend = buf;
             if (y > cy1 && y < cy2) {
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                }
+                sgl_color_span(buf, color, alpha, clip.x2 - clip.x1 + 1);
             }
             else {
                 cy_tmp = y > cy1 ? cy2 : cy1;
@@ -86,7 +430,11 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, in
 
                 for (int x = clip.x1; x <= clip.x2; x++, blend++) {
                     if (x > cx1 && x < cx2) {
-                        *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
+                        /* the straight part between two corners */
+                        span = sgl_min(clip.x2, cx2 - 1) - x + 1;
+                        sgl_color_span(blend, color, alpha, span);
+                        x += span - 1;
+                        blend += span - 1;
                     }
                     else {
                         cx_tmp = x > cx1 ? cx2 : cx1;
@@ -142,6 +490,7 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
     int cyi2 = rect->y2 - border_width;
     int cx_tmp = 0;
     int cy_tmp = 0;
+    int span = 0;
 
     int in_r2_max = sgl_pow2(radius_in - 1);
     int out_r2_max = sgl_pow2(radius + 1);
@@ -156,17 +505,20 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
         return;
     }
 
+#if (CONFIG_SGL_DRAW_CORNER_CACHE)
+    if (radius > 0 && draw_rect_masked(surf, &clip, rect, radius, color, border_color, border_width, alpha)) {
+        return;
+    }
+#endif
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     if (radius == 0) {
         for (int y = clip.y1; y <= clip.y2; y++) {
-            blend = buf;
-            for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                if (x >= cx1i && x <= cx2i && y >= cyi1 && y <= cyi2) {
-                    *blend = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha);
-                }
-                else {
-                    *blend = alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha);
-                }
+            if (y >= cyi1 && y <= cyi2) {
+                draw_rect_border_row(buf, clip.x1, clip.x2, cx1i, cx2i, color, border_color, alpha);
+            }
+            else {
+                sgl_color_span(buf, border_color, alpha, clip.x2 - clip.x1 + 1);
             }
             buf += surf->w;
         }
@@ -175,14 +527,7 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
         for (int y = clip.y1; y <= clip.y2; y++) {
             blend = buf;
             if (y > cy1 && y < cy2) {
-                for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-                    if (x < cx1i || x > cx2i) {
-                        *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-                    }
-                    else {
-                        *blend = (alpha == SGL_ALPHA_MAX ? color: sgl_color_mixer(color, *blend, alpha));
-                    }
-                }
+                draw_rect_border_row(buf, clip.x1, clip.x2, cx1i, cx2i, color, border_color, alpha);
             }
             else {
                 cy_tmp = y > cy1 ? cy2 : cy1;
@@ -190,12 +535,11 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
 
                 for (int x = clip.x1; x <= clip.x2; x++, blend++) {
                     if (x >= cx1 && x <= cx2) {
-                        if (y < cyi1 || y > cyi2) {
-                            *blend = (alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *blend, alpha));
-                        }
-                        else {
-                            *blend = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *blend, alpha));
-                        }
+                        /* the straight part between two corners */
+                        span = sgl_min(clip.x2, cx2) - x + 1;
+                        sgl_color_span(blend, (y < cyi1 || y > cyi2) ? border_color : color, alpha, span);
+                        x += span - 1;
+                        blend += span - 1;
                     }
                     else {
                         cx_tmp = x > cx1 ? cx2 : cx1;
@@ -41,13 +41,15 @@
  */
 void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t cy, int16_t radius_in, int16_t radius_out, sgl_color_t color, uint8_t alpha)
 {
-    int y2 = 0, real_r2 = 0, edge_alpha = 0;
+    int y2 = 0, real_r2 = 0, edge_alpha = 0, num = 0;
     int in_r2 = sgl_pow2(radius_in);
     int out_r2 = sgl_pow2(radius_out);
     
     int in_r2_max = sgl_pow2(radius_in - 1);
     int out_r2_max = sgl_pow2(radius_out + 1);
     sgl_color_t *buf = NULL, *blend = NULL;
+    sgl_draw_run_t run[SGL_DRAW_BAND_RUNS];
+    sgl_draw_band_t band;
     sgl_area_t clip;
 
     if (unlikely(alpha == SGL_ALPHA_MIN)) {
@@ -58,51 +60,39 @@ void sgl_draw_fill_ring(sgl_surf_t *surf, sgl_area_t *area, int16_t cx, int16_t
         return;
     }
 
+    /* the hole is the inside band, it is not drawn */
+    sgl_draw_band_init(&band, in_r2_max, in_r2, out_r2 + 1, out_r2_max);
+
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
     for (int y = clip.y1; y <= clip.y2; y++) {
-        blend = buf;
         y2 = sgl_pow2(y - cy);
-        
-        for (int x = clip.x1; x <= clip.x2; x++, blend++) {
-            real_r2 = sgl_pow2(x - cx) + y2;
+        num = sgl_draw_band_runs(&band, cx, y2, clip.x1, clip.x2, run);
 
-            if (real_r2 >= out_r2_max) {
-               if (x > cx) break;
-                continue;
-            }
-            if (real_r2 < in_r2_max) {
-                if (x < cx) {
-                    blend += ((cx - x) * 2);
-                    x = cx*2 - x;
-                }
-                continue;
-            }
+        for (int i = 0; i < num; i++) {
+            blend = buf + (run[i].x1 - clip.x1);
 
-            if (alpha == SGL_ALPHA_MAX) {
-                if (real_r2 < in_r2 ) {
-                    *blend = sgl_color_mixer(color, *blend, sgl_sqrt_error(real_r2));
-                }
-                else if (real_r2 > out_r2) {
-                    *blend = sgl_color_mixer(color, *blend, SGL_ALPHA_MAX - sgl_sqrt_error(real_r2));
-                }
-                else {
-                    *blend = color;
-                }
-            }
-            else {
-                if (real_r2 < in_r2 ) {
-                    edge_alpha = sgl_sqrt_error(real_r2);
-                    sgl_color_t color_mix = sgl_color_mixer(color, *blend, edge_alpha);
-                    *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                }
-                else if (real_r2 > out_r2) {
-                    edge_alpha = SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
-                    sgl_color_t color_mix = sgl_color_mixer(color, *blend, edge_alpha);
-                    *blend = sgl_color_mixer(color_mix, *blend, alpha);
-                }
-                else {
-                    *blend = sgl_color_mixer(color, *blend, alpha);
+            switch (run[i].band) {
+            case SGL_DRAW_BAND_BODY:
+                sgl_color_span(blend, color, alpha, run[i].x2 - run[i].x1 + 1);
+                break;
+
+            case SGL_DRAW_BAND_INNER:
+            case SGL_DRAW_BAND_OUTER:
+                for (int x = run[i].x1; x <= run[i].x2; x++, blend++) {
+                    real_r2 = sgl_pow2(x - cx) + y2;
+                    edge_alpha = run[i].band == SGL_DRAW_BAND_INNER ? sgl_sqrt_error(real_r2) : SGL_ALPHA_MAX - sgl_sqrt_error(real_r2);
+
+                    if (alpha == SGL_ALPHA_MAX) {
+                        *blend = sgl_color_mixer(color, *blend, edge_alpha);
+                    }
+                    else {
+                        sgl_color_t color_mix = sgl_color_mixer(color, *blend, edge_alpha);
+                        *blend = sgl_color_mixer(color_mix, *blend, alpha);
+                    }
                 }
+                break;
+
+            default: break;
             }
         }
         buf += surf->w;
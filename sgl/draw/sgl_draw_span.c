@@ -0,0 +1,278 @@
+/* source/draw/sgl_draw_span.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL  
+ * Document reference link: https://sgl-docs.readthedocs.io
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_math.h>
+
+
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+/* red and blue of the low pixel, green of the high pixel, same layout as sgl_color_mixer */
+#define  SGL_SPAN_RGB565_MASK          (0x07E0F81Fu)
+#define  sgl_span_ror16(w)             (((w) >> 16) | ((w) << 16))
+
+
+/**
+ * @brief blend one spread RGB565 word
+ * @param bg spread background, it is masked by SGL_SPAN_RGB565_MASK
+ * @param fgf spread foreground multiplied by factor
+ * @param inv 32 - factor
+ * @return spread result
+ * @note every field has 5 free bits above it, so bg * inv + fg * factor never carries into the
+ *       next field, and the result is exactly bg + (fg - bg) * factor / 32 of sgl_color_mixer
+ */
+static inline uint32_t sgl_span_blend_word(uint32_t bg, uint32_t fgf, uint32_t inv)
+{
+    return ((bg * inv + fgf) >> 5) & SGL_SPAN_RGB565_MASK;
+}
+#endif
+
+
+/**
+ * @brief fill a span of pixels with a solid color
+ * @param dest pointer to the first pixel
+ * @param color color to fill
+ * @param len number of pixels
+ * @return none
+ * @note RGB565 pixels are written in 32-bit words, 8 pixels per loop, so that the compiler can
+ *       use STM with 4 registers on Cortex-M3
+ */
+void sgl_color_span_fill(sgl_color_t *dest, sgl_color_t color, uint32_t len)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    uint32_t pair = (uint32_t)color.full | ((uint32_t)color.full << 16);
+    uint32_t *word;
+
+    if (len && ((uintptr_t)dest & 2)) {
+        *dest++ = color;
+        len --;
+    }
+
+    word = (uint32_t*)dest;
+    for (; len >= 8; len -= 8, word += 4) {
+        word[0] = pair;
+        word[1] = pair;
+        word[2] = pair;
+        word[3] = pair;
+    }
+
+    for (; len >= 2; len -= 2) {
+        *word++ = pair;
+    }
+
+    if (len) {
+        *(sgl_color_t*)word = color;
+    }
+#else
+    while (len--) {
+        *dest++ = color;
+    }
+#endif
+}
+
+
+/**
+ * @brief blend a solid color into a span of pixels
+ * @param dest pointer to the first pixel
+ * @param color foreground color
+ * @param alpha alpha of foreground color
+ * @param len number of pixels
+ * @return none
+ * @note the result is the same as sgl_color_mixer(color, *dest, alpha) for every pixel,
+ *       RGB565 pixels are blended two at a time: the red and blue of one pixel and the green
+ *       of the other one share a 32-bit word
+ */
+void sgl_color_span_blend(sgl_color_t *dest, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+#if (CONFIG_SGL_FBDEV_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    uint32_t factor = ((uint32_t)alpha + 4) >> 3;
+    uint32_t inv = 32 - factor;
+    uint32_t fgf = (((uint32_t)color.full | ((uint32_t)color.full << 16)) & SGL_SPAN_RGB565_MASK) * factor;
+    uint32_t *word, w, a, b;
+
+    if (factor == 0) {
+        return;
+    }
+    else if (factor == 32) {
+        sgl_color_span_fill(dest, color, len);
+        return;
+    }
+
+    if (len && ((uintptr_t)dest & 2)) {
+        a = sgl_span_blend_word(((uint32_t)dest->full | ((uint32_t)dest->full << 16)) & SGL_SPAN_RGB565_MASK, fgf, inv);
+        dest->full = (uint16_t)((a >> 16) | a);
+        dest ++;
+        len --;
+    }
+
+    word = (uint32_t*)dest;
+    for (; len >= 2; len -= 2, word++) {
+        w = *word;
+        a = sgl_span_blend_word(w & SGL_SPAN_RGB565_MASK, fgf, inv);
+        b = sgl_span_blend_word(sgl_span_ror16(w) & SGL_SPAN_RGB565_MASK, fgf, inv);
+        *word = a | sgl_span_ror16(b);
+    }
+
+    if (len) {
+        dest = (sgl_color_t*)word;
+        a = sgl_span_blend_word(((uint32_t)dest->full | ((uint32_t)dest->full << 16)) & SGL_SPAN_RGB565_MASK, fgf, inv);
+        dest->full = (uint16_t)((a >> 16) | a);
+    }
+#else
+    while (len--) {
+        *dest = sgl_color_mixer(color, *dest, alpha);
+        dest ++;
+    }
+#endif
+}
+
+
+/**
+ * @brief floor of n / d
+ * @param n numerator
+ * @param d denominator, it is above 0
+ * @return n / d rounded down
+ */
+static inline int32_t draw_floor_div(int32_t n, int32_t d)
+{
+    int32_t q = n / d;
+    return (n % d != 0 && n < 0) ? q - 1 : q;
+}
+
+
+/**
+ * @brief get the integers x where a * x + b >= 0, they are one half line, all or none of them
+ * @param a factor of x
+ * @param b constant
+ * @param lo first x of the half line
+ * @param hi last x of the half line, it is below lo if no x matches
+ * @return none
+ */
+void sgl_draw_half_line(int32_t a, int32_t b, int32_t *lo, int32_t *hi)
+{
+    if (a > 0) {
+        *lo = -draw_floor_div(b, a);
+        *hi = SGL_DRAW_HALF_LINE_INF;
+    }
+    else if (a < 0) {
+        *lo = -SGL_DRAW_HALF_LINE_INF;
+        *hi = draw_floor_div(b, -a);
+    }
+    else {
+        *lo = b >= 0 ? -SGL_DRAW_HALF_LINE_INF : SGL_DRAW_HALF_LINE_INF;
+        *hi = b >= 0 ? SGL_DRAW_HALF_LINE_INF : -SGL_DRAW_HALF_LINE_INF;
+    }
+}
+
+
+/**
+ * @brief set the limits of the radial bands of a disc or a ring
+ * @param band bands to set
+ * @param inside limit of inside
+ * @param inner limit of inner edge
+ * @param body limit of body
+ * @param outside limit of outer edge
+ * @return none
+ * @note the outside test comes first and the others follow in order, so a limit is cut to the
+ *       outside limit and raised to the limit before it, the bands that can not be reached are empty
+ */
+void sgl_draw_band_init(sgl_draw_band_t *band, int32_t inside, int32_t inner, int32_t body, int32_t outside)
+{
+    band->limit[SGL_DRAW_BAND_INSIDE] = sgl_min(inside, outside);
+    band->limit[SGL_DRAW_BAND_INNER] = sgl_max(band->limit[SGL_DRAW_BAND_INSIDE], sgl_min(inner, outside));
+    band->limit[SGL_DRAW_BAND_BODY] = sgl_max(band->limit[SGL_DRAW_BAND_INNER], sgl_min(body, outside));
+    band->limit[SGL_DRAW_BAND_OUTER] = outside;
+}
+
+
+/**
+ * @brief add a run to a scanline if it is not empty after the clip
+ * @param run point to the next run
+ * @param x1 start x of run
+ * @param x2 end x of run
+ * @param clip_x1 start x of scanline
+ * @param clip_x2 end x of scanline
+ * @param band band of run
+ * @return 1 if the run is added, otherwise 0
+ */
+static inline int draw_band_add_run(sgl_draw_run_t *run, int x1, int x2, int clip_x1, int clip_x2, uint8_t band)
+{
+    x1 = sgl_max(x1, clip_x1);
+    x2 = sgl_min(x2, clip_x2);
+
+    if (x1 > x2) {
+        return 0;
+    }
+
+    run->x1 = x1;
+    run->x2 = x2;
+    run->band = band;
+    return 1;
+}
+
+
+/**
+ * @brief cut a scanline of a disc or a ring into runs of the same band, from left to right
+ * @param band bands of the disc or ring
+ * @param cx x coordinate of the center
+ * @param y2 squared distance of the scanline from the center
+ * @param x1 start x of scanline
+ * @param x2 end x of scanline
+ * @param run runs of the scanline, at most SGL_DRAW_BAND_RUNS
+ * @return number of runs, the outside pixels are in no run
+ */
+int sgl_draw_band_runs(const sgl_draw_band_t *band, int16_t cx, int32_t y2, int16_t x1, int16_t x2, sgl_draw_run_t *run)
+{
+    /* half[i] is the largest dx with dx * dx + y2 < limit[i], -1 if the band misses the scanline */
+    int half[4];
+    int num = 0;
+
+    for (int i = 0; i < 4; i++) {
+        half[i] = band->limit[i] > y2 ? sgl_sqrt((uint32_t)(band->limit[i] - y2 - 1)) : -1;
+    }
+
+    if (half[SGL_DRAW_BAND_OUTER] < 0) {
+        return 0;
+    }
+
+    /* the center column goes to the left run of a band if no band before it reaches the scanline */
+    for (int i = SGL_DRAW_BAND_OUTER; i > SGL_DRAW_BAND_INSIDE; i--) {
+        if (half[i] > half[i - 1]) {
+            num += draw_band_add_run(&run[num], cx - half[i], half[i - 1] < 0 ? cx : cx - half[i - 1] - 1, x1, x2, i);
+        }
+    }
+
+    if (half[SGL_DRAW_BAND_INSIDE] >= 0) {
+        num += draw_band_add_run(&run[num], cx - half[SGL_DRAW_BAND_INSIDE], cx + half[SGL_DRAW_BAND_INSIDE], x1, x2, SGL_DRAW_BAND_INSIDE);
+    }
+
+    for (int i = SGL_DRAW_BAND_INNER; i <= SGL_DRAW_BAND_OUTER; i++) {
+        if (half[i] > half[i - 1]) {
+            num += draw_band_add_run(&run[num], cx + sgl_max(half[i - 1], 0) + 1, cx + half[i], x1, x2, i);
+        }
+    }
+
+    return num;
+}
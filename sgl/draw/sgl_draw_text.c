@@ -26,6 +26,8 @@
 #include <sgl_log.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
+#include <sgl_mm.h>
+#include <string.h>
 
 
 #if (CONFIG_SGL_FONT_COMPRESSED)
@@ -180,6 +182,364 @@ static inline void font_rle_init(const uint8_t * in, uint8_t bpp)
 #endif // (!CONFIG_SGL_FONT_COMPRESSED)
 
 
+#if (CONFIG_SGL_GLYPH_CACHE_SIZE > 0)
+/* a glyph row is stored as runs, the top 2 bits of a run header is the kind of run and the
+ * low 6 bits is the length - 1, a partial run is followed by the 4-bit coverage of its pixels,
+ * two pixels per byte and the high nibble first, the coverage is the index of sgl_opa4_table
+ */
+#define  SGL_GLYPH_RUN_CLEAR                    (0)
+#define  SGL_GLYPH_RUN_OPAQUE                   (1)
+#define  SGL_GLYPH_RUN_PARTIAL                  (2)
+#define  SGL_GLYPH_RUN_LEN_MAX                  (64)
+#define  SGL_GLYPH_LINE_MAX                     (128)
+#define  SGL_GLYPH_HASH_NUM                     (16)
+
+
+/**
+ * @brief decoded glyph in cache
+ * @node: node of LRU list, the front is the most recently used
+ * @hash_next: next glyph of the same hash bucket
+ * @font: font of glyph
+ * @ch_index: index of glyph in font table
+ * @size: bytes of this glyph in heap
+ * @frame: the last frame that draws this glyph
+ * @row: offset of runs of each row, the runs start after the last row offset
+ */
+typedef struct sgl_glyph {
+    sgl_list_node_t     node;
+    struct sgl_glyph    *hash_next;
+    const sgl_font_t    *font;
+    uint32_t            ch_index;
+    uint32_t            size;
+    uint32_t            frame;
+    uint16_t            row[];
+} sgl_glyph_t;
+
+
+static struct {
+    sgl_list_node_t     lru;
+    sgl_glyph_t         *hash[SGL_GLYPH_HASH_NUM];
+    uint32_t            used;
+} glyph_cache = {
+    .lru = { .prev = &glyph_cache.lru, .next = &glyph_cache.lru },
+};
+
+
+/**
+ * @brief get hash bucket of a glyph
+ * @param font font of glyph
+ * @param ch_index index of glyph in font table
+ * @return index of hash bucket
+ */
+static inline uint32_t glyph_hash(const sgl_font_t *font, uint32_t ch_index)
+{
+    return (ch_index ^ ((uintptr_t)font >> 4)) & (SGL_GLYPH_HASH_NUM - 1);
+}
+
+
+/**
+ * @brief get the kind of run that a pixel belongs to
+ * @param cov coverage of pixel
+ * @return kind of run
+ */
+static inline uint8_t glyph_run_kind(uint8_t cov)
+{
+    return cov == 0 ? SGL_GLYPH_RUN_CLEAR : (cov == 0xF ? SGL_GLYPH_RUN_OPAQUE : SGL_GLYPH_RUN_PARTIAL);
+}
+
+
+/**
+ * @brief decode a row of glyph into 4-bit coverage
+ * @param font font of glyph
+ * @param dot bitmap of glyph
+ * @param rel_y row of glyph, the rows of compressed font must be decoded in order
+ * @param w width of glyph
+ * @param out coverage of row
+ * @return none
+ */
+static void glyph_decode_row(const sgl_font_t *font, const uint8_t *dot, uint32_t rel_y, uint16_t w, uint8_t *out)
+{
+#if (CONFIG_SGL_FONT_COMPRESSED)
+    if (font->compress) {
+        decompress_line(out, w);
+
+        /* sgl_opa2_table[i] is sgl_opa4_table[i * 5] */
+        for (uint16_t x = 0; font->bpp != 4 && x < w; x++) {
+            out[x] = font->bpp == 2 ? out[x] * 5 : (out[x] ? 0xF : 0);
+        }
+        return;
+    }
+#endif
+
+    for (uint32_t x = 0, pixel_index = rel_y * w; x < w; x++, pixel_index++) {
+        if (font->bpp == 4) {
+            out[x] = (pixel_index & 1) ? (dot[pixel_index >> 1] & 0x0F) : (dot[pixel_index >> 1] >> 4);
+        }
+        else if (font->bpp == 2) {
+            out[x] = ((dot[pixel_index >> 2] >> ((3 - (pixel_index & 0x3)) * 2)) & 0x03) * 5;
+        }
+        else {
+            out[x] = ((dot[pixel_index >> 3] >> (7 - (pixel_index & 0x7))) & 0x01) ? 0xF : 0;
+        }
+    }
+}
+
+
+/**
+ * @brief encode a row of coverage into runs
+ * @param cov coverage of row
+ * @param w width of row
+ * @param out runs of row, NULL to get the size only
+ * @return bytes of runs
+ */
+static uint32_t glyph_encode_row(const uint8_t *cov, uint16_t w, uint8_t *out)
+{
+    uint32_t size = 0;
+    uint16_t x = 0, len;
+    uint8_t kind;
+
+    while (x < w) {
+        kind = glyph_run_kind(cov[x]);
+        for (len = 1; x + len < w && len < SGL_GLYPH_RUN_LEN_MAX && glyph_run_kind(cov[x + len]) == kind; len++);
+
+        if (out != NULL) {
+            out[size] = (kind << 6) | (len - 1);
+            for (uint16_t i = 0; kind == SGL_GLYPH_RUN_PARTIAL && i < len; i += 2) {
+                out[size + 1 + i / 2] = (cov[x + i] << 4) | (i + 1 < len ? cov[x + i + 1] : 0);
+            }
+        }
+
+        size += 1 + (kind == SGL_GLYPH_RUN_PARTIAL ? (len + 1) / 2 : 0);
+        x += len;
+    }
+
+    return size;
+}
+
+
+/**
+ * @brief get the least recently used glyph
+ * @param none
+ * @return the least recently used glyph, NULL if the cache is empty
+ */
+static inline sgl_glyph_t* glyph_cache_lru(void)
+{
+    return sgl_list_is_empty(&glyph_cache.lru) ? NULL : sgl_container_of(glyph_cache.lru.prev, sgl_glyph_t, node);
+}
+
+
+/**
+ * @brief check if a new glyph of size bytes can be put into cache
+ * @param size bytes of the new glyph
+ * @return true if there is enough room after evicting the glyphs that are not used in current frame
+ * @note if the glyphs of one frame do not fit the cache, the glyphs that are already in cache are
+ *       kept and the others are drawn without cache, so that LRU never evicts every glyph of a frame
+ *       just before it is drawn again in the next frame
+ */
+static bool glyph_cache_has_room(uint32_t size)
+{
+    sgl_glyph_t *glyph;
+    uint32_t used = glyph_cache.used;
+
+    if (used + size <= CONFIG_SGL_GLYPH_CACHE_SIZE) {
+        return true;
+    }
+
+    sgl_list_for_each_entry_reverse(glyph, &glyph_cache.lru, sgl_glyph_t, node) {
+        if (glyph->frame == sgl_fbdev_get_frame()) {
+            return false;
+        }
+
+        used -= glyph->size;
+        if (used + size <= CONFIG_SGL_GLYPH_CACHE_SIZE) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief remove the least recently used glyph from cache
+ * @param none
+ * @return false if the cache is empty
+ */
+static bool glyph_cache_evict(void)
+{
+    sgl_glyph_t *glyph = glyph_cache_lru(), **pos;
+
+    if (glyph == NULL) {
+        return false;
+    }
+
+    for (pos = &glyph_cache.hash[glyph_hash(glyph->font, glyph->ch_index)]; *pos != glyph; pos = &(*pos)->hash_next);
+
+    *pos = glyph->hash_next;
+    sgl_list_del_node(&glyph->node);
+    glyph_cache.used -= glyph->size;
+    sgl_free(glyph);
+    return true;
+}
+
+
+/**
+ * @brief decode a glyph and put it into cache
+ * @param font font of glyph
+ * @param ch_index index of glyph in font table
+ * @return glyph in cache, NULL if the glyph can not be cached
+ */
+static sgl_glyph_t* glyph_cache_add(const sgl_font_t *font, uint32_t ch_index)
+{
+    const uint8_t *dot = &font->bitmap[font->table[ch_index].bitmap_index];
+    const uint16_t font_w = font->table[ch_index].box_w;
+    const uint16_t font_h = font->table[ch_index].box_h;
+    uint8_t line_buf[SGL_GLYPH_LINE_MAX];
+    uint32_t runs = 0, size;
+    uint8_t *out;
+    sgl_glyph_t *glyph;
+
+    /* the smallest glyph has its header and row offsets only */
+    if (font_w > SGL_GLYPH_LINE_MAX || !glyph_cache_has_room(sizeof(sgl_glyph_t) + font_h * sizeof(uint16_t))) {
+        return NULL;
+    }
+
+#if (CONFIG_SGL_FONT_COMPRESSED)
+    font_rle_init(dot, font->bpp);
+#endif
+    for (uint32_t y = 0; y < font_h; y++) {
+        glyph_decode_row(font, dot, y, font_w, line_buf);
+        runs += glyph_encode_row(line_buf, font_w, NULL);
+    }
+
+    size = sizeof(sgl_glyph_t) + font_h * sizeof(uint16_t) + runs;
+    if (runs > UINT16_MAX || !glyph_cache_has_room(size)) {
+        return NULL;
+    }
+
+    while (glyph_cache.used + size > CONFIG_SGL_GLYPH_CACHE_SIZE) {
+        glyph_cache_evict();
+    }
+
+    /* the cache gives the memory back to the heap rather than fail the glyph */
+    while ((glyph = sgl_malloc(size)) == NULL) {
+        if (!glyph_cache_evict()) {
+            return NULL;
+        }
+    }
+
+    glyph->font = font;
+    glyph->ch_index = ch_index;
+    glyph->size = size;
+    glyph->frame = sgl_fbdev_get_frame();
+    out = (uint8_t*)&glyph->row[font_h];
+    runs = 0;
+
+#if (CONFIG_SGL_FONT_COMPRESSED)
+    font_rle_init(dot, font->bpp);
+#endif
+    for (uint32_t y = 0; y < font_h; y++) {
+        glyph_decode_row(font, dot, y, font_w, line_buf);
+        glyph->row[y] = runs;
+        runs += glyph_encode_row(line_buf, font_w, &out[runs]);
+    }
+
+    glyph->hash_next = glyph_cache.hash[glyph_hash(font, ch_index)];
+    glyph_cache.hash[glyph_hash(font, ch_index)] = glyph;
+    sgl_list_add_node_at_front(&glyph_cache.lru, &glyph->node);
+    glyph_cache.used += size;
+
+    return glyph;
+}
+
+
+/**
+ * @brief get a decoded glyph from cache, decode it if it is not in cache
+ * @param font font of glyph
+ * @param ch_index index of glyph in font table
+ * @return glyph in cache, NULL if the glyph can not be cached
+ */
+static sgl_glyph_t* glyph_cache_get(const sgl_font_t *font, uint32_t ch_index)
+{
+    sgl_glyph_t *glyph = glyph_cache.hash[glyph_hash(font, ch_index)];
+
+    for (; glyph != NULL; glyph = glyph->hash_next) {
+        if (glyph->font == font && glyph->ch_index == ch_index) {
+            sgl_list_del_node(&glyph->node);
+            sgl_list_add_node_at_front(&glyph_cache.lru, &glyph->node);
+            glyph->frame = sgl_fbdev_get_frame();
+            return glyph;
+        }
+    }
+
+    return glyph_cache_add(font, ch_index);
+}
+
+
+/**
+ * @brief draw a cached glyph, opaque runs are filled without blending
+ * @param buf pointer to the pixel at (clip.x1, clip.y1)
+ * @param stride stride of surface
+ * @param glyph glyph in cache
+ * @param text_rect rectangle of glyph
+ * @param clip clipped rectangle of glyph
+ * @param color color of glyph
+ * @param alpha alpha of glyph
+ * @return none
+ */
+static void glyph_cache_draw(sgl_color_t *buf, int16_t stride, sgl_glyph_t *glyph, sgl_area_t *text_rect, sgl_area_t *clip, sgl_color_t color, uint8_t alpha)
+{
+    const uint16_t font_h = glyph->font->table[glyph->ch_index].box_h;
+    const uint8_t *runs = (const uint8_t*)&glyph->row[font_h];
+    const uint8_t *run, *cov;
+    sgl_color_t color_mix, *blend;
+    int16_t x, x1, x2, len, i;
+    uint8_t kind, alpha_dot;
+
+    for (int y = clip->y1; y <= clip->y2; y++) {
+        run = &runs[glyph->row[y - text_rect->y1]];
+
+        for (x = text_rect->x1; x <= clip->x2; x += len) {
+            kind = run[0] >> 6;
+            len = (run[0] & 0x3F) + 1;
+            cov = &run[1];
+            run += 1 + (kind == SGL_GLYPH_RUN_PARTIAL ? (len + 1) / 2 : 0);
+
+            x1 = sgl_max(x, clip->x1);
+            x2 = sgl_min(x + len - 1, clip->x2);
+            if (kind == SGL_GLYPH_RUN_CLEAR || x1 > x2) {
+                continue;
+            }
+
+            blend = buf + (x1 - clip->x1);
+            if (kind == SGL_GLYPH_RUN_OPAQUE) {
+                sgl_color_span(blend, color, alpha, x2 - x1 + 1);
+                continue;
+            }
+
+            for (i = x1 - x; x1 <= x2; x1++, i++, blend++) {
+                alpha_dot = sgl_opa4_table[(i & 1) ? (cov[i >> 1] & 0x0F) : (cov[i >> 1] >> 4)];
+                color_mix = sgl_color_mixer(color, *blend, alpha_dot);
+                *blend = alpha == SGL_ALPHA_MAX ? color_mix : sgl_color_mixer(color_mix, *blend, alpha);
+            }
+        }
+        buf += stride;
+    }
+}
+
+
+/**
+ * @brief free all glyphs in cache
+ * @param none
+ * @return none
+ */
+void sgl_draw_glyph_cache_flush(void)
+{
+    while (glyph_cache_evict());
+}
+#endif // (CONFIG_SGL_GLYPH_CACHE_SIZE > 0)
+
+
 /**
  * @brief Draw a character on the surface with alpha blending
  * @param surf Pointer to the surface where the character will be drawn
@@ -222,6 +582,14 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
     }
 
     buf = sgl_surf_get_buf(surf, clip.x1 - surf->x1, clip.y1 - surf->y1);
+#if (CONFIG_SGL_GLYPH_CACHE_SIZE > 0)
+    sgl_glyph_t *glyph = glyph_cache_get(font, ch_index);
+    if (glyph != NULL) {
+        glyph_cache_draw(buf, surf->w, glyph, &text_rect, &clip, color, alpha);
+        return;
+    }
+#endif
+
 #if (CONFIG_SGL_FONT_COMPRESSED)
     if (font->compress == 0) {
 #endif // (!CONFIG_SGL_FONT_COMPRESSED == 0)
@@ -355,3 +723,249 @@ void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, in
         x_off += ch_width;
     }
 }
+
+
+/**
+ * @brief get the hash of text bytes
+ * @param text text string
+ * @param len [out] number of bytes
+ * @return FNV-1a hash of text
+ */
+static uint32_t text_layout_hash(const char *text, uint32_t *len)
+{
+    uint32_t hash = 2166136261u;
+    const char *p = text;
+
+    for (; *p; p++) {
+        hash = (hash ^ (uint8_t)*p) * 16777619u;
+    }
+
+    *len = p - text;
+    return hash;
+}
+
+
+/**
+ * @brief shape text into layout, it does nothing if the text and font are not changed
+ * @param layout pointer to text layout
+ * @param text text string
+ * @param font font of text
+ * @return none
+ * @note if the glyph buffer can not be allocated, the layout falls back to the text string
+ */
+void sgl_text_layout_update(sgl_text_layout_t *layout, const char *text, const sgl_font_t *font)
+{
+    SGL_ASSERT(layout != NULL && text != NULL && font != NULL);
+    uint32_t len, unicode = 0, n, count = 0, hash;
+    uint32_t frame = sgl_fbdev_get_frame();
+    uint16_t ch_index;
+    int32_t width = 0;
+
+    /* an object is drawn once per slice, but its text is checked only once per frame */
+    if (layout->frame == frame && layout->text == text && layout->font == font) {
+        return;
+    }
+
+    layout->frame = frame;
+    hash = text_layout_hash(text, &len);
+    if (layout->text == text && layout->font == font && layout->hash == hash && (layout->glyph != NULL || len == 0)) {
+        return;
+    }
+
+    layout->text = text;
+    layout->font = font;
+    layout->hash = hash;
+    layout->count = 0;
+    layout->wrap_w = -1;
+
+    /* a character has one byte at least, so the length of text is enough for its glyphs */
+    if (len > layout->capacity) {
+        sgl_free(layout->glyph);
+        layout->capacity = 0;
+        layout->glyph = len <= UINT16_MAX ? sgl_malloc(((len + 7) & ~7u) * sizeof(uint16_t)) : NULL;
+        if (layout->glyph == NULL) {
+            SGL_LOG_WARN("sgl_text_layout_update: malloc failed, draw text without layout");
+            return;
+        }
+        layout->capacity = (len + 7) & ~7u;
+    }
+
+    while (*text) {
+        n = sgl_utf8_to_unicode(text, &unicode);
+        text += n ? n : 1;
+        ch_index = sgl_search_unicode_ch_index(font, unicode);
+
+        layout->glyph[count++] = (unicode == '\n') ? SGL_TEXT_LAYOUT_NEWLINE : ch_index;
+        width += (font->table[ch_index].adv_w >> 4);
+    }
+
+    layout->count = count;
+    layout->text_w = width;
+}
+
+
+/**
+ * @brief free the glyph buffer of layout
+ * @param layout pointer to text layout
+ * @return none
+ * @note call it when the text object is destroyed
+ */
+void sgl_text_layout_free(sgl_text_layout_t *layout)
+{
+    SGL_ASSERT(layout != NULL);
+    sgl_free(layout->glyph);
+    memset(layout, 0, sizeof(sgl_text_layout_t));
+}
+
+
+/**
+ * @brief get the height of layout text, which is in a rect area
+ * @param layout pointer to text layout
+ * @param width width of the rect area
+ * @param line_space peer line space
+ * @return height of text, same as sgl_font_get_string_height()
+ */
+int32_t sgl_text_layout_get_height(sgl_text_layout_t *layout, int16_t width, uint8_t line_space)
+{
+    const sgl_font_t *font = layout->font;
+    int16_t offset_x = 0, ch_width, lines = 1;
+
+    if (layout->glyph == NULL) {
+        return sgl_font_get_string_height(width, layout->text, font, line_space);
+    }
+
+    if (layout->wrap_w == width && layout->wrap_margin == line_space) {
+        return layout->wrap_h;
+    }
+
+    for (uint32_t i = 0; i < layout->count; i++) {
+        if (layout->glyph[i] == SGL_TEXT_LAYOUT_NEWLINE) {
+            lines ++;
+            offset_x = 0;
+            continue;
+        }
+
+        ch_width = (font->table[layout->glyph[i]].adv_w >> 4);
+        if ((offset_x + ch_width) >= width) {
+            offset_x = 0;
+            lines ++;
+        }
+
+        offset_x += ch_width;
+    }
+
+    layout->wrap_w = width;
+    layout->wrap_margin = line_space;
+    layout->wrap_h = lines * (font->font_height + line_space);
+    return layout->wrap_h;
+}
+
+
+/**
+ * @brief get the position of layout text in the area
+ * @param layout pointer to text layout
+ * @param area point to area
+ * @param offset text offset
+ * @param type alignment type
+ * @return position of text, same as sgl_get_text_pos()
+ */
+sgl_pos_t sgl_text_layout_get_pos(sgl_text_layout_t *layout, sgl_area_t *area, int16_t offset, sgl_align_type_t type)
+{
+    sgl_pos_t ret;
+    sgl_size_t parent_size = {
+        .w = area->x2 - area->x1 + 1,
+        .h = area->y2 - area->y1 + 1,
+    };
+
+    if (layout->glyph == NULL) {
+        return sgl_get_text_pos(area, layout->font, layout->text, offset, type);
+    }
+
+    sgl_size_t text_size = {
+        .w = layout->text_w + offset,
+        .h = sgl_font_get_height(layout->font),
+    };
+
+    ret = sgl_get_align_pos(&parent_size, &text_size, type);
+    ret.x += area->x1;
+    ret.y += area->y1;
+
+    return ret;
+}
+
+
+/**
+ * @brief Draw a layout text on the surface with alpha blending
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the string
+ * @param y Y coordinate of the top-left corner of the string
+ * @param layout Pointer to the text layout
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @return none
+ */
+void sgl_draw_text_layout(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha)
+{
+    const sgl_font_t *font = layout->font;
+    uint32_t ch_index;
+
+    if (layout->glyph == NULL) {
+        sgl_draw_string(surf, area, x, y, layout->text, color, alpha, font);
+        return;
+    }
+
+    for (uint32_t i = 0; i < layout->count; i++) {
+        ch_index = layout->glyph[i];
+        if (ch_index == SGL_TEXT_LAYOUT_NEWLINE) {
+            ch_index = sgl_search_unicode_ch_index(font, '\n');
+        }
+
+        sgl_draw_character(surf, area, x, y, ch_index, color, alpha, font);
+        x += (font->table[ch_index].adv_w >> 4);
+    }
+}
+
+
+/**
+ * @brief Draw a layout text on the surface with alpha blending and multiple lines
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the string
+ * @param y Y coordinate of the top-left corner of the string
+ * @param layout Pointer to the text layout
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ */
+void sgl_draw_text_layout_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha, uint8_t line_margin)
+{
+    const sgl_font_t *font = layout->font;
+    int16_t ch_index, ch_width;
+    int16_t x_off = x;
+
+    if (layout->glyph == NULL) {
+        sgl_draw_string_mult_line(surf, area, x, y, layout->text, color, alpha, font, line_margin);
+        return;
+    }
+
+    for (uint32_t i = 0; i < layout->count; i++) {
+        if (layout->glyph[i] == SGL_TEXT_LAYOUT_NEWLINE) {
+            x_off = x;
+            y += (font->font_height + line_margin);
+            continue;
+        }
+
+        ch_index = layout->glyph[i];
+        ch_width = (font->table[ch_index].adv_w >> 4);
+
+        if ((x_off + ch_width) > area->x2) {
+            x_off = x;
+            y += (font->font_height + line_margin);
+        }
+
+        sgl_draw_character(surf, area, x_off, y, ch_index, color, alpha, font);
+        x_off += ch_width;
+    }
+}
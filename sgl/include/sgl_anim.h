@@ -58,11 +58,14 @@ typedef int32_t (*sgl_anim_path_algo_t)(uint32_t elaps, uint32_t duration, int32
  * @data:      Pointer to user-defined private data associated with this animation.
  *             Not used internally by the animation engine; intended for application use.
  * 
- * @next:      Pointer to the next animation in a singly-linked list.
- *             Used internally by the animation scheduler to chain active animations.
+ * @prev:      Pointer to the previous animation in a doubly-linked list.
  * 
- * @act_delay: Delay time (in ms) before the animation starts after being added to the system.
- *             The animation will not progress until this delay has elapsed.
+ * @next:      Pointer to the next animation in a doubly-linked list.
+ *             Used internally by the animation scheduler to chain running or delayed animations.
+ * 
+ * @act_delay: Delay time (in ms) before the animation starts after sgl_anim_start().
+ *             The animation waits in the delayed list, ordered by start time, until this delay
+ *             has elapsed, so waiting animations cost nothing in sgl_anim_task().
  * 
  * @act_duration: Total duration (in ms) of the animation from start_value to end_value.
  * 
@@ -70,6 +73,11 @@ typedef int32_t (*sgl_anim_path_algo_t)(uint32_t elaps, uint32_t duration, int32
  * 
  * @end_value: The target value at the end of the animation.
  * 
+ * @start_time: Tick (in ms) when the current play of the animation starts, internal use.
+ * 
+ * @last_value: The value that is passed to path_cb last time, path_cb is only called when
+ *              the interpolated value changes, internal use.
+ * 
  * @path_cb: Optional custom callback function to compute intermediate animation values.
  *           If set, it overrides the built-in path algorithm (`path_algo`).
  *
@@ -89,32 +97,56 @@ typedef int32_t (*sgl_anim_path_algo_t)(uint32_t elaps, uint32_t duration, int32
  *            Set to 1 when the animation ends naturally or is stopped.
  *
  * @auto_free: If set to 1, the animation object will be automatically freed after completion.
- *             Useful for fire-and-forget animations; ensure memory was allocated dynamically.
+ *             Useful for fire-and-forget animations; ensure it is got from sgl_anim_create().
+ *
+ * @delayed: Flag indicating whether the animation is in the delayed list, internal use.
+ *
+ * @value_valid: Flag indicating whether last_value is valid, internal use.
+ *
+ * @restarted: Flag indicating whether the animation was started again by a callback of
+ *             sgl_anim_task(), internal use.
  */
 typedef struct sgl_anim {
     void                  *data;
+    struct sgl_anim       *prev;
     struct sgl_anim       *next;
     uint32_t              act_delay;
     uint32_t              act_duration;
     int32_t               start_value;
     int32_t               end_value;
+    uint32_t              start_time;
+    int32_t               last_value;
     sgl_anim_path_cb_t    path_cb;
     sgl_anim_path_algo_t  path_algo;
     void                  (*finish_cb)(struct sgl_anim *anim);
     uint32_t              repeat_cnt : 30;
     uint32_t              finished : 1;
     uint32_t              auto_free : 1;
+    uint8_t               delayed : 1;
+    uint8_t               value_valid : 1;
+    uint8_t               restarted : 1;
 } sgl_anim_t;
 
 
 /**
  * @brief animation context, it will be used to store status of animation
- * @anim_list_head: animation list head
- * @anim_list_tail: animation list tail
+ * @anim_list_head: running animation list head
+ * @anim_list_tail: running animation list tail
+ * @delay_list_head: delayed animation list head, the list is ordered by start time
+ * @iter: next animation of the running list walk in sgl_anim_task(), it is moved forward if
+ *        the animation is removed by a callback
+ * @free_list: free animation objects of the pool, only for CONFIG_SGL_ANIM_POOL_SIZE > 0
+ * @pool_used: number of animation objects of the pool that have been handed out at least once
  */
 typedef struct sgl_anim_ctx {
     sgl_anim_t *anim_list_head;
     sgl_anim_t *anim_list_tail;
+    sgl_anim_t *delay_list_head;
+    sgl_anim_t *iter;
+#if (CONFIG_SGL_ANIM_POOL_SIZE)
+    sgl_anim_t *free_list;
+    uint16_t   pool_used;
+#endif
 } sgl_anim_ctx_t;
 
 
@@ -140,16 +172,18 @@ void sgl_anim_init(sgl_anim_t *anim);
 /**
  * @brief dynamic alloc animation object with initialization
  * @param  none
- * @return animation object
+ * @return animation object, NULL if no memory
+ * @note   if CONFIG_SGL_ANIM_POOL_SIZE is not 0, the object is got from the static pool
 */
 sgl_anim_t* sgl_anim_create(void);
 
 
 /**
- * @brief start animation
+ * @brief start animation, it is started again if it is running
  * @param  anim animation object
- * @para  repeat_cnt repeat count of animation
+ * @para  repeat_cnt repeat count of animation, 0 means stop it
  * @return none
+ * @note   the animation starts after the active delay
 */
 void sgl_anim_start(sgl_anim_t *anim, uint32_t repeat_cnt);
 
@@ -296,6 +330,15 @@ static inline void sgl_anim_set_auto_free(sgl_anim_t *anim)
 void sgl_anim_task(void);
 
 
+/**
+ * @brief  get the time until sgl_anim_task() has work to do
+ * @param  now  current tick milliseconds
+ * @return 0 if an animation is running, the time until the first delayed animation starts,
+ *         or SGL_WAIT_FOREVER if there is no animation
+ */
+uint32_t sgl_anim_get_wait(uint32_t now);
+
+
 /**
  * Linear animation path calculation function
  * 
@@ -59,9 +59,52 @@ extern "C" {
  * CONFIG_SGL_EVENT_QUEUE_SIZE:
  *      the size of event queue, default: 32
  * 
+ * CONFIG_SGL_EVENT_INPUT_QUEUE_SIZE:
+ *      the size of event queue of the input device, it can be pushed in interrupt and the MOTION events
+ *      are merged, so it can be small, it must be power of 2, default: 8
+ * 
  * CONFIG_SGL_EVENT_CLICK_INTERVAL:
  *      The click interval, default: 10
  * 
+ * CONFIG_SGL_EVENT_HIT_GRID_CELL:
+ *      The cell size in pixels of the grid that finds the clicked object, every cell keeps the objects
+ *      that cover it and the grid is rebuilt only after objects are added, removed, moved or resized.
+ *      0 means no grid, the object tree is walked for every click, default: 0
+ * 
+ * CONFIG_SGL_DIRTY_AREA_FLUSH_COST:
+ *      The cost of one flush in pixels, it includes the window setting of the panel and the object
+ *      tree walk of one slice. Two dirty areas are merged only if the merged area costs less than
+ *      the two separate flushes, default: 128
+ * 
+ * CONFIG_SGL_DRAW_SCRATCH_SIZE:
+ *      The bytes of the scratch arena for the temporary buffers of draw code, it is reset after every
+ *      frame, the buffers are taken from heap when it is full, 0 means no scratch arena, default: 0
+ * 
+ * CONFIG_SGL_DRAW_BATCH:
+ *      The most dirty areas that are drawn together when they all fit in the draw buffer, every area
+ *      gets its own part of the buffer, the object tree is walked once for them and they are flushed
+ *      one after the other, 0 or 1 means that every dirty area is drawn on its own, default: 0
+ * 
+ * CONFIG_SGL_DRAW_LIST_SIZE:
+ *      The most objects in the display list of a dirty area, a dirty area that is drawn in many slices
+ *      walks the object tree once into the list and the slices draw from it, an area with more objects
+ *      walks the tree for every slice, 0 means no display list, default: 0
+ * 
+ * CONFIG_SGL_DRAW_CORNER_CACHE:
+ *      The most anti-aliased corner masks of rounded rects that are kept in heap, a mask holds the
+ *      coverage of a radius and border width, so the corners are drawn from a table instead of a
+ *      square root per pixel, 0 means that the corners are computed pixel by pixel, default: 0
+ * 
+ * CONFIG_SGL_FRAME_PACING:
+ *      If you want frames in step with the tearing effect (TE) signal of the panel, please define this
+ *      macro to 1 and call sgl_fbdev_te_signal() in the TE interrupt, a frame starts only after a TE
+ *      pulse, slow frames are coalesced and the frame time statistics are kept, see
+ *      sgl_frame_get_stats(), without TE pulses the frames follow the tick as before, default: 0
+ * 
+ * CONFIG_SGL_FRAME_PACING_SKIP_MAX:
+ *      The most TE periods that one frame may take when the frames are slower than the panel refresh,
+ *      default: 4
+ * 
  * CONFIG_SGL_OBJ_SLOT_DYNAMIC
  *      If the object slot is dynamic, the object slot size will be dynamic allocated, otherwise, the object 
  *      slot size will be static allocated that you should define CONFIG_SGL_OBJ_NUM_MAX macro
@@ -75,24 +118,66 @@ extern "C" {
  * CONFIG_SGL_ANIMATION:
  *      If you want to use animation, please define this macro to 1
  * 
+ * CONFIG_SGL_ANIM_POOL_SIZE:
+ *      The number of animation objects in a static pool, sgl_anim_create() takes them from the pool
+ *      instead of heap and returns NULL if the pool is empty, 0 means heap is used, default: 0
+ * 
  * CONFIG_SGL_DEBUG:
  *      If you want to use debug, please define this macro to 1
  * 
  * CONFIG_SGL_USE_OBJ_ID:
  *      If you want to use obj id, please define this macro to 1, at mostly, the CONFIG_SGL_USE_OBJ_ID should be 0
  * 
+ * CONFIG_SGL_OBJ_COMPACT:
+ *      If you want smaller objects, please define this macro to 1, the tree links are 16-bit handles
+ *      and the construct function is an 8-bit class index, event data and name are kept in a side
+ *      table, the objects must be in the sgl heap and the heap must not be bigger than 256KB, so it
+ *      can not be used with the other heap algorithm, default: 0
+ * 
+ * CONFIG_SGL_OBJ_CLASS_NUM:
+ *      The number of object types in compact object mode, the first one is NULL, default: 32
+ * 
+ * CONFIG_SGL_OBJ_SIDE_NUM:
+ *      The number of objects that can have event data or name in compact object mode without
+ *      allocating from the heap, the entries of more objects are allocated from it, default: 8
+ * 
  * CONFIG_SGL_HEAP_ALGO:
- *      The heap algorithm, default: lwmem
+ *      The heap algorithm, a bare name: tlsf, lwmem, slab, bump or other, default: lwmem
  * 
  * CONFIG_SGL_HEAP_MEMORY_SIZE:
  *      The heap memory size, default: 10240
  * 
+ * CONFIG_SGL_HEAP_TRACE:
+ *      If you want to know who holds the heap and how fragmented it is, please define this macro to 1,
+ *      every block costs 8 more bytes, see sgl_mm_trace_dump(), default: 0
+ * 
+ * CONFIG_SGL_PAGE_REGION:
+ *      If you want to create pages with their own memory region, please define this macro to 1,
+ *      the widgets of such a page are cut from the region and deleting the page frees it at once,
+ *      see sgl_page_create_with_region(), default: 0
+ * 
+ * CONFIG_SGL_SLAB_ARENA_SIZE:
+ *      The bytes of the heap that the slab heap algorithm cuts into pages for the small objects, at most
+ *      half of the heap is used, default: 4096
+ * 
+ * CONFIG_SGL_SLAB_PAGE_SIZE:
+ *      The page size of the slab heap algorithm, the objects bigger than half a page are allocated by
+ *      lwmem, it must be a multiple of 16, default: 512
+ * 
  * CONFIG_SGL_FONT_COMPRESSED:
  *      If you want to use font compressed, please define this macro to 1
  * 
  * CONFIG_SGL_FONT_SMALL_TABLE:
  *      If you want to use font small table, please define this macro to 1
  * 
+ * CONFIG_SGL_GLYPH_CACHE_SIZE:
+ *      The max bytes of sgl heap that the glyph cache can use, the decoded glyphs are kept as runs of
+ *      coverage and the least recently used ones are freed first, 0 means no glyph cache, default: 0
+ * 
+ * CONFIG_SGL_FONT_LOOKUP_CACHE:
+ *      The number of entries of the direct mapped cache from unicode to index of font table, it must
+ *      be a power of 2, it is used by the fonts without index, 0 means no lookup cache, default: 0
+ * 
  * CONFIG_SGL_LABEL_ROTATION:
  *      If you want to use label rotation, please define this macro to 1
  * 
@@ -132,14 +217,50 @@ extern "C" {
 #define CONFIG_SGL_EVENT_QUEUE_SIZE                                (16)
 #endif
 
+#ifndef CONFIG_SGL_EVENT_INPUT_QUEUE_SIZE
+#define CONFIG_SGL_EVENT_INPUT_QUEUE_SIZE                          (8)
+#endif
+
 #ifndef CONFIG_SGL_EVENT_CLICK_INTERVAL
 #define CONFIG_SGL_EVENT_CLICK_INTERVAL                            (10)
 #endif
 
+#ifndef CONFIG_SGL_EVENT_HIT_GRID_CELL
+#define CONFIG_SGL_EVENT_HIT_GRID_CELL                             (0)
+#endif
+
 #ifndef CONFIG_SGL_DIRTY_AREA_NUM_MAX
 #define CONFIG_SGL_DIRTY_AREA_NUM_MAX                              (16)
 #endif
 
+#ifndef CONFIG_SGL_DIRTY_AREA_FLUSH_COST
+#define CONFIG_SGL_DIRTY_AREA_FLUSH_COST                           (128)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_SCRATCH_SIZE
+#define CONFIG_SGL_DRAW_SCRATCH_SIZE                               (0)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_BATCH
+#define CONFIG_SGL_DRAW_BATCH                                      (0)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_LIST_SIZE
+#define CONFIG_SGL_DRAW_LIST_SIZE                                  (0)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_CORNER_CACHE
+#define CONFIG_SGL_DRAW_CORNER_CACHE                               (0)
+#endif
+
+#ifndef CONFIG_SGL_FRAME_PACING
+#define CONFIG_SGL_FRAME_PACING                                    (0)
+#endif
+
+#ifndef CONFIG_SGL_FRAME_PACING_SKIP_MAX
+#define CONFIG_SGL_FRAME_PACING_SKIP_MAX                           (4)
+#endif
+
 #ifndef CONFIG_SGL_PIXMAP_BILINEAR_INTERP
 #define CONFIG_SGL_PIXMAP_BILINEAR_INTERP                          (0)
 #endif
@@ -148,6 +269,10 @@ extern "C" {
 #define CONFIG_SGL_ANIMATION                                       (0)
 #endif
 
+#ifndef CONFIG_SGL_ANIM_POOL_SIZE
+#define CONFIG_SGL_ANIM_POOL_SIZE                                  (0)
+#endif
+
 #ifndef CONFIG_SGL_DEBUG
 #   define CONFIG_SGL_DEBUG                                        (0)
 #elif (CONFIG_SGL_DEBUG == 1)
@@ -163,8 +288,39 @@ extern "C" {
 #define CONFIG_SGL_OBJ_USE_NAME                                    (0)
 #endif
 
+#ifndef CONFIG_SGL_OBJ_COMPACT
+#define CONFIG_SGL_OBJ_COMPACT                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_CLASS_NUM
+#define CONFIG_SGL_OBJ_CLASS_NUM                                   (32)
+#endif
+
+#ifndef CONFIG_SGL_OBJ_SIDE_NUM
+#define CONFIG_SGL_OBJ_SIDE_NUM                                    (8)
+#endif
+
+#if (CONFIG_SGL_OBJ_COMPACT && (CONFIG_SGL_OBJ_CLASS_NUM > 256))
+#error "CONFIG_SGL_OBJ_CLASS_NUM must not be bigger than 256 in compact object mode"
+#endif
+
 #ifndef CONFIG_SGL_HEAP_ALGO
-#define CONFIG_SGL_HEAP_ALGO                                       (lwmem)
+#define CONFIG_SGL_HEAP_ALGO                                       lwmem
+#endif
+
+/* CONFIG_SGL_HEAP_ALGO is a bare name, it is pasted to one of these numbers to be compared */
+#define SGL_HEAP_ALGO_ID_tlsf                                      (1)
+#define SGL_HEAP_ALGO_ID_lwmem                                     (2)
+#define SGL_HEAP_ALGO_ID_slab                                      (3)
+#define SGL_HEAP_ALGO_ID_bump                                      (4)
+#define SGL_HEAP_ALGO_ID_other                                     (5)
+#define SGL_HEAP_ALGO_ID_CAT(algo)                                 SGL_HEAP_ALGO_ID_##algo
+#define SGL_HEAP_ALGO_ID(algo)                                     SGL_HEAP_ALGO_ID_CAT(algo)
+
+#if (CONFIG_SGL_OBJ_COMPACT)
+#if (SGL_HEAP_ALGO_ID(CONFIG_SGL_HEAP_ALGO) == SGL_HEAP_ALGO_ID_other)
+#error "CONFIG_SGL_OBJ_COMPACT can not be used with the other heap algorithm, the objects must be in sgl_obj_heap"
+#endif
 #endif
 
 #ifndef CONFIG_SGL_HEAP_MEMORY_SIZE
@@ -174,6 +330,26 @@ extern "C" {
 #   endif
 #endif
 
+#if (CONFIG_SGL_OBJ_COMPACT && (CONFIG_SGL_HEAP_MEMORY_SIZE > 262140))
+#error "CONFIG_SGL_HEAP_MEMORY_SIZE must not be bigger than 262140 in compact object mode"
+#endif
+
+#ifndef CONFIG_SGL_HEAP_TRACE
+#define CONFIG_SGL_HEAP_TRACE                                      (0)
+#endif
+
+#ifndef CONFIG_SGL_PAGE_REGION
+#define CONFIG_SGL_PAGE_REGION                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_SLAB_ARENA_SIZE
+#define CONFIG_SGL_SLAB_ARENA_SIZE                                 (4096)
+#endif
+
+#ifndef CONFIG_SGL_SLAB_PAGE_SIZE
+#define CONFIG_SGL_SLAB_PAGE_SIZE                                  (512)
+#endif
+
 #ifndef CONFIG_SGL_FONT_COMPRESSED
 #define CONFIG_SGL_FONT_COMPRESSED                                 (0)
 #endif
@@ -182,6 +358,14 @@ extern "C" {
 #define CONFIG_SGL_FONT_SMALL_TABLE                                (0)
 #endif
 
+#ifndef CONFIG_SGL_GLYPH_CACHE_SIZE
+#define CONFIG_SGL_GLYPH_CACHE_SIZE                                (0)
+#endif
+
+#ifndef CONFIG_SGL_FONT_LOOKUP_CACHE
+#define CONFIG_SGL_FONT_LOOKUP_CACHE                               (0)
+#endif
+
 #ifndef CONFIG_SGL_LABEL_ROTATION
 #define CONFIG_SGL_LABEL_ROTATION                                  (0)
 #endif
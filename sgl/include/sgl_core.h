@@ -324,6 +324,30 @@ typedef struct sgl_font_unicode {
 } sgl_font_unicode_t;
 
 
+/* unicode block of font index is 64 characters */
+#define  SGL_FONT_INDEX_BLOCK_BITS                  (6)
+#define  SGL_FONT_INDEX_BLOCK_SIZE                  (1 << SGL_FONT_INDEX_BLOCK_BITS)
+#define  SGL_FONT_INDEX_NONE                        (0xFFFF)
+
+
+/**
+ * @brief Two level page table from unicode to the index of font table, it is emitted with the
+ *        font tables, so that a character is found in O(1) whatever the unicode parts look like
+ * @block: glyph block of each unicode block (unicode >> SGL_FONT_INDEX_BLOCK_BITS) from first_block,
+ *         SGL_FONT_INDEX_NONE if the unicode block has no character
+ * @glyph: index of font table for each unicode of the glyph blocks, SGL_FONT_INDEX_BLOCK_SIZE
+ *         characters per glyph block, SGL_FONT_INDEX_NONE if the character is not in the font
+ * @first_block: first unicode block of the font
+ * @block_num: number of unicode blocks from first_block
+ */
+typedef struct sgl_font_index {
+    const uint16_t *block;
+    const uint16_t *glyph;
+    const uint16_t first_block;
+    const uint16_t block_num;
+} sgl_font_index_t;
+
+
 /**
 * @brief A structure used to describe information about a font, Defining a font set requires
 *        the use of this structure to describe relevant information
@@ -337,6 +361,7 @@ typedef struct sgl_font_unicode {
 * @base_line: base line of font
 * @bpp: The anti aliasing level of the font, only support 2, 4
 * @compress: compress flag, 0: no compress, 1: compress
+* @index: optional unicode index of font, NULL if the font has no index, then unicode parts are searched
 */
 typedef struct sgl_font {
     const uint8_t  *bitmap;
@@ -348,6 +373,7 @@ typedef struct sgl_font {
     const int16_t   base_line;
     const uint8_t   bpp;
     const uint8_t   compress;
+    const sgl_font_index_t *index;
 } sgl_font_t;
 
 
@@ -380,19 +406,43 @@ typedef struct sgl_font {
  * @evt_leave: (1 bit) Set to 1 if the object should receive "pointer leave" events.
  * @pressed: (1 bit) Tracks whether the object is currently being pressed.
  * @page: (1 bit) Reserved for page/view switching logic (e.g., in tabbed interfaces).
- * @radius: (12 bits) Corner radius in pixels for rounded rectangle rendering (max 4095).
+ * @radius: (11 bits) Corner radius in pixels for rounded rectangle rendering (max 2046,
+ *          SGL_RADIUS_INVALID is not set).
+ * @subtree: (1 bit) Set to 1 when the object or one of its children is dirty, destroyed or
+ *           needs init, so the dirty area pass goes into it. See sgl_obj_set_subtree().
  * @name: [Optional] Null-terminated string identifier for debugging or lookup.
  *        Only present if CONFIG_SGL_OBJ_USE_NAME is defined.
+ *
+ * If CONFIG_SGL_OBJ_COMPACT is 1, the tree links are 16-bit handles, the construct_fn is the
+ * index @cls of a shared class table, and event_data and name are kept in a side table, the
+ * @side bits tell if the object has an entry there. Use sgl_obj_from_link(), sgl_obj_to_link(),
+ * sgl_obj_get_construct_fn() and sgl_obj_set_construct_fn() to reach them in both layouts.
  */
+#if (CONFIG_SGL_OBJ_COMPACT)
+typedef uint16_t            sgl_obj_link_t;
+#else
+typedef struct sgl_obj*     sgl_obj_link_t;
+#endif
+
+typedef void (*sgl_construct_fn_t)(sgl_surf_t *surf, struct sgl_obj *obj, sgl_event_t *event);
+
 typedef struct sgl_obj {
     sgl_area_t      area;
     sgl_area_t      coords;
     void            (*event_fn)(sgl_event_t *e);
+#if (CONFIG_SGL_OBJ_COMPACT)
+    sgl_obj_link_t  parent;
+    sgl_obj_link_t  child;
+    sgl_obj_link_t  sibling;
+    uint8_t         cls;
+    uint8_t         side;
+#else
     void            *event_data;
     void            (*construct_fn)(sgl_surf_t *surf, struct sgl_obj *obj, sgl_event_t *event);
-    struct sgl_obj  *parent;
-    struct sgl_obj  *child;
-    struct sgl_obj  *sibling;
+    sgl_obj_link_t  parent;
+    sgl_obj_link_t  child;
+    sgl_obj_link_t  sibling;
+#endif
     uint8_t         destroyed : 1;
     uint8_t         dirty : 1;
     uint8_t         hide : 1;
@@ -405,13 +455,117 @@ typedef struct sgl_obj {
     uint16_t        focus : 1;
     uint16_t        pressed : 1;
     uint16_t        page : 1;
-    uint16_t        radius : 12;
-#if CONFIG_SGL_OBJ_USE_NAME
+    uint16_t        radius : 11;
+    uint16_t        subtree : 1;
+#if (CONFIG_SGL_OBJ_USE_NAME && !CONFIG_SGL_OBJ_COMPACT)
     const char      *name;
 #endif
 } sgl_obj_t;
 
 
+#if (CONFIG_SGL_OBJ_COMPACT)
+/* the objects are in the heap, a handle is the word offset of the object in it, 0 is NULL,
+ * the first words of the heap are never allocated, so no object has the handle 0 */
+extern uint32_t sgl_obj_heap[];
+
+/* bits of sgl_obj_t.side */
+#define  SGL_OBJ_SIDE_DATA                  (1 << 0)
+#define  SGL_OBJ_SIDE_NAME                  (1 << 1)
+
+extern sgl_construct_fn_t sgl_obj_class[CONFIG_SGL_OBJ_CLASS_NUM];
+#endif
+
+
+/**
+ * @brief get the object of a tree link
+ * @param link parent, child or sibling field of an object
+ * @return point to object, NULL if the link is empty
+ */
+static inline struct sgl_obj* sgl_obj_from_link(sgl_obj_link_t link)
+{
+#if (CONFIG_SGL_OBJ_COMPACT)
+    return link ? (struct sgl_obj*)(sgl_obj_heap + link) : NULL;
+#else
+    return link;
+#endif
+}
+
+
+/**
+ * @brief get the tree link of an object
+ * @param obj point to object, it can be NULL
+ * @return link that can be stored in the parent, child or sibling field
+ */
+static inline sgl_obj_link_t sgl_obj_to_link(const struct sgl_obj *obj)
+{
+#if (CONFIG_SGL_OBJ_COMPACT)
+    return obj ? (sgl_obj_link_t)((const uint32_t*)obj - sgl_obj_heap) : 0;
+#else
+    return (sgl_obj_link_t)obj;
+#endif
+}
+
+
+/**
+ * @brief get the construct function of an object
+ * @param obj point to object
+ * @return construct function, NULL if the object has none
+ */
+static inline sgl_construct_fn_t sgl_obj_get_construct_fn(const struct sgl_obj *obj)
+{
+#if (CONFIG_SGL_OBJ_COMPACT)
+    return sgl_obj_class[obj->cls];
+#else
+    return obj->construct_fn;
+#endif
+}
+
+
+#if (CONFIG_SGL_OBJ_COMPACT)
+/**
+ * @brief set the construct function of an object, its class is registered at the first time
+ * @param obj point to object
+ * @param fn construct function
+ * @return none
+ */
+void sgl_obj_set_construct_fn(struct sgl_obj *obj, sgl_construct_fn_t fn);
+
+
+/**
+ * @brief get the event data of an object from the side table
+ * @param obj point to object
+ * @return event data, NULL if it is not set
+ */
+void* sgl_obj_get_event_data(struct sgl_obj *obj);
+
+
+/**
+ * @brief set the event data of an object in the side table
+ * @param obj point to object
+ * @param data event data
+ * @return none
+ */
+void sgl_obj_set_event_data(struct sgl_obj *obj, void *data);
+#else
+static inline void sgl_obj_set_construct_fn(struct sgl_obj *obj, sgl_construct_fn_t fn)
+{
+    obj->construct_fn = fn;
+}
+
+
+static inline void* sgl_obj_get_event_data(struct sgl_obj *obj)
+{
+    return obj->event_data;
+}
+
+
+static inline void sgl_obj_set_event_data(struct sgl_obj *obj, void *data)
+{
+    obj->event_data = data;
+}
+#endif
+
+
 /**
  * @brief Represents a page object in the SGL graphics system.
  *
@@ -426,12 +580,16 @@ typedef struct sgl_obj {
  * - alpha    : Alpha value for the background color (0-255).
  * - pixmap   : Optional pointer to a background pixmap. If non-NULL, it typically overrides 'color'
  *              as the background content during rendering (behavior depends on flush/render logic).
+ * - region   : Memory region of the page, NULL if the page uses the heap, see sgl_page_create_with_region().
  */
 typedef struct sgl_page {
     sgl_obj_t          obj;
     sgl_color_t        color;
     uint8_t            alpha;
     const sgl_pixmap_t *pixmap;
+#if (CONFIG_SGL_PAGE_REGION)
+    struct sgl_mm_region *region;
+#endif
 } sgl_page_t;
 
 
@@ -457,9 +615,15 @@ typedef struct sgl_fbinfo {
  * @fbinfo: framebuffer information, that specify the memory address of the framebuffer and resolution
  * @surf: Drawing surface associated with this page; defines the target buffer or area for rendering.
  * @dirty_num: dirty area number
- * @fb_swap: framebuffer swap flag
- * @fb_status: framebuffer status flag
+ * @fb_swap: framebuffer swap flag, index of the buffer that is drawing
+ * @fb_flush: index of the buffer that is flushing
+ * @fb_ready: framebuffer status flag, fb_ready[n] is set if buffer n is not flushing,
+ *            one byte per buffer so that the DMA interrupt never races with the drawing task
  * @dirty: dirty area pool
+ * @raw_pixels: pixels of all dirty areas pushed in current frame, before planning
+ * @saved_pixels: pixels saved by the dirty area planner in the last frame
+ * @frame: number of frames that have been drawn
+ * @draw_passes: number of passes over the object tree to draw, one for every slice, batch or display list
  * @page: current page
  */
 typedef struct sgl_fbdev {
@@ -467,12 +631,71 @@ typedef struct sgl_fbdev {
     sgl_surf_t        surf;
     uint16_t          dirty_num;
     volatile uint8_t  fb_swap;
-    volatile uint8_t  fb_status;
+    volatile uint8_t  fb_flush;
+    volatile uint8_t  fb_ready[SGL_DRAW_BUFFER_MAX];
     sgl_area_t        dirty[SGL_DIRTY_AREA_NUM_MAX];
+    int32_t           raw_pixels;
+    int32_t           saved_pixels;
+    uint32_t          frame;
+    uint32_t          draw_passes;
     sgl_obj_t         *active;
 } sgl_fbdev_t;
 
 
+#if (CONFIG_SGL_FRAME_PACING)
+/**
+ * @brief frame time statistics, see sgl_frame_get_stats()
+ * @frames: number of frames that had dirty areas
+ * @te_frames: number of them that were started by a TE pulse
+ * @coalesced: frame periods that were merged into the next frame while an animation was running,
+ *             because the frame before was too slow or the pacing interval is more than one period
+ * @last_ms: time of the last frame, from its start to its last flush
+ * @avg_ms: average frame time
+ * @max_ms: longest frame time
+ * @te_period_ms: measured period of the TE pulses, 0 if there is no TE signal
+ * @interval: TE periods between two frames, it grows when the frames are slower than the panel
+ */
+typedef struct sgl_frame_stats {
+    uint32_t  frames;
+    uint32_t  te_frames;
+    uint32_t  coalesced;
+    uint16_t  last_ms;
+    uint16_t  avg_ms;
+    uint16_t  max_ms;
+    uint16_t  te_period_ms;
+    uint8_t   interval;
+} sgl_frame_stats_t;
+
+
+/**
+ * @brief frame pacing state
+ * @te_count: number of TE pulses, it is written in the TE interrupt
+ * @te_tick: tick of the last TE pulse
+ * @te_period: measured period of the TE pulses in 1/256 ms
+ * @frame_te: te_count when the last frame started
+ * @frame_tick: tick when the last frame started
+ * @display_tick: the tick at which the current frame is expected to be on the panel, animations
+ *                are sampled at it, it never goes back
+ * @render_avg: average frame time in 1/16 ms
+ * @interval: TE periods between two frames
+ * @busy: an animation was running at the end of the last frame
+ * @stats: frame time statistics
+ */
+typedef struct sgl_pacing {
+    volatile uint32_t  te_count;
+    volatile uint32_t  te_tick;
+    volatile uint32_t  te_period;
+    uint32_t           frame_te;
+    uint32_t           frame_tick;
+    uint32_t           display_tick;
+    uint16_t           render_avg;
+    uint8_t            interval;
+    uint8_t            busy;
+    sgl_frame_stats_t  stats;
+} sgl_pacing_t;
+#endif // !CONFIG_SGL_FRAME_PACING
+
+
 /**
  * @brief sgl log print device struct
  * @logdev: log print callback function pointer
@@ -482,6 +705,7 @@ typedef struct sgl_fbdev {
  * @font: system default font
  * @rotation: buffer only for rotation
  * @angle: angle value only for rotation
+ * @pacing: frame pacing state, only for CONFIG_SGL_FRAME_PACING
  */
 typedef struct sgl_system {
     void               (*logdev)(const char *str);
@@ -495,6 +719,9 @@ typedef struct sgl_system {
     sgl_color_t        *rotation;
     uint16_t            angle;
 #endif
+#if (CONFIG_SGL_FRAME_PACING)
+    sgl_pacing_t        pacing;
+#endif
 } sgl_system_t;
 
 
@@ -503,7 +730,7 @@ typedef struct sgl_system {
  * @param _child: pointer of child object
  * @param parent: pointer of parent object
  */
-#define  sgl_obj_for_each_child(_child, parent)             for (_child = parent->child; _child != NULL; _child = _child->sibling)
+#define  sgl_obj_for_each_child(_child, parent)             for (_child = sgl_obj_from_link(parent->child); _child != NULL; _child = sgl_obj_from_link(_child->sibling))
 
 
 /**
@@ -511,8 +738,8 @@ typedef struct sgl_system {
  * @param _child: pointer of child object
  * @param parent: pointer of parent object
  */
-#define sgl_obj_for_each_child_safe(_child, n, parent)      for (_child = parent->child, n = (_child ? _child->sibling : NULL); _child != NULL; \
-                                                                 _child = n, n = (_child ? _child->sibling : NULL))
+#define sgl_obj_for_each_child_safe(_child, n, parent)      for (_child = sgl_obj_from_link(parent->child), n = (_child ? sgl_obj_from_link(_child->sibling) : NULL); \
+                                                                 _child != NULL; _child = n, n = (_child ? sgl_obj_from_link(_child->sibling) : NULL))
 
 /**
  * @brief The macro define the rotation of the framebuffer device
@@ -585,16 +812,12 @@ int sgl_fbdev_register(sgl_fbinfo_t *fbinfo);
  * @brief set framebuffer device flush ready
  * @param none
  * @return none
- * @note this function must be called in DMA callback function after framebuffer device flush
+ * @note this function must be called in DMA callback function after framebuffer device flush,
+ *       it can also be called in flush_area directly if the transfer is synchronous
  */
 static inline void sgl_fbdev_flush_ready(void)
 {
-    sgl_system.fbdev.fb_status |= (1 << sgl_system.fbdev.fb_swap);
-
-    /* change to next framebuffer */
-    if (sgl_system.fbdev.fbinfo.buffer[1] != NULL) {
-        sgl_system.fbdev.surf.buffer = (sgl_color_t *)sgl_system.fbdev.fbinfo.buffer[sgl_system.fbdev.fb_swap ^= 1];
-    }
+    sgl_system.fbdev.fb_ready[sgl_system.fbdev.fb_flush] = 1;
 }
 
 
@@ -605,7 +828,19 @@ static inline void sgl_fbdev_flush_ready(void)
  */
 static inline bool sgl_fbdev_flush_wait_ready(sgl_fbdev_t *fbdev)
 {
-    return (fbdev->fb_status & (1 << sgl_system.fbdev.fb_swap)) == 0;
+    return fbdev->fb_ready[fbdev->fb_swap] == 0;
+}
+
+
+/**
+ * @brief check if the other buffer is still flushing, only for double buffer
+ * @param fbdev point to the framebuffer device
+ * @return bool true if need to wait the flush, false if the panel is idle
+ * @note only one flush is in flight, so the next flush must wait the previous one
+ */
+static inline bool sgl_fbdev_flush_wait_idle(sgl_fbdev_t *fbdev)
+{
+    return fbdev->fb_ready[fbdev->fb_swap ^ 1] == 0;
 }
 
 
@@ -657,16 +892,11 @@ static inline void* sgl_fbdev_buffer_address(void)
 
 
 /**
- * @brief framebuffer device flush function
- * @param area [in] area of flush, that is x1, y1, x2, y2: area of flush
- *                  area contains the coordinates of the area to be flushed
- *                  - x1: x coordinate of the top left corner of the area
- *                  - y1: y coordinate of the top left corner of the area
- *                  - x2: x coordinate of the bottom right corner of the area
- *                  - y2: y coordinate of the bottom right corner of the area
+ * @brief framebuffer device transfer function, it rotates the pixels if need and calls flush_area
+ * @param area [in] area of flush
  * @param src [in] source color
  */
-static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
+static inline void sgl_fbdev_flush_transfer(sgl_area_t *area, sgl_color_t *src)
 {
 #if CONFIG_SGL_COLOR16_SWAP
     uint16_t w = area->x2 - area->x1 + 1;
@@ -721,6 +951,52 @@ static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
 }
 
 
+/**
+ * @brief framebuffer device flush function
+ * @param area [in] area of flush, that is x1, y1, x2, y2: area of flush
+ *                  area contains the coordinates of the area to be flushed
+ *                  - x1: x coordinate of the top left corner of the area
+ *                  - y1: y coordinate of the top left corner of the area
+ *                  - x2: x coordinate of the bottom right corner of the area
+ *                  - y2: y coordinate of the bottom right corner of the area
+ * @param src [in] source color
+ * @note with double buffer, flush_area may return before the transfer is finished, the next
+ *       slice is drawn into the other buffer while this one is transferred
+ */
+static inline void sgl_fbdev_flush_area(sgl_area_t *area, sgl_color_t *src)
+{
+    sgl_fbdev_t *fbdev = &sgl_system.fbdev;
+
+    if (fbdev->fbinfo.buffer[1] == NULL) {
+        fbdev->fb_flush = fbdev->fb_swap;
+        sgl_fbdev_flush_transfer(area, src);
+        return;
+    }
+
+    /* wait the previous flush, the panel and the rotation buffer are shared */
+    while (sgl_fbdev_flush_wait_idle(fbdev));
+
+    fbdev->fb_flush = fbdev->fb_swap;
+    sgl_fbdev_flush_transfer(area, src);
+
+    /* change to next framebuffer */
+    fbdev->fb_swap ^= 1;
+    fbdev->surf.buffer = (sgl_color_t *)fbdev->fbinfo.buffer[fbdev->fb_swap];
+}
+
+
+/**
+ * @brief wait all flushes of framebuffer device are finished
+ * @param none
+ * @return none
+ * @note call it before touching the panel in other way, e.g. entering low power mode
+ */
+static inline void sgl_fbdev_flush_sync(void)
+{
+    while (!sgl_system.fbdev.fb_ready[0] || !sgl_system.fbdev.fb_ready[1]);
+}
+
+
 #if (CONFIG_SGL_FBDEV_RUNTIME_ROTATION)
 /**
  * @brief set framebuffer device rotation angle
@@ -777,6 +1053,17 @@ static inline uint32_t sgl_tick_get(void)
 }
 
 
+/**
+ * @brief get the number of frames that have been drawn
+ * @param none
+ * @return frame number, it is increased when a frame with dirty areas starts drawing
+ */
+static inline uint32_t sgl_fbdev_get_frame(void)
+{
+    return sgl_system.fbdev.frame;
+}
+
+
 /**
  * @brief get last tick milliseconds
  * @param none
@@ -823,6 +1110,75 @@ static inline void sgl_tick_reset(void)
 }
 
 
+#if (CONFIG_SGL_FRAME_PACING)
+/**
+ * @brief signal a tearing effect (TE) pulse of the panel
+ * @param none
+ * @return none
+ * @note call it in the interrupt of the TE pin, the panel has just started to scan a new refresh,
+ *       so a frame that starts now and is sent faster than the scan does not tear
+ */
+static inline void sgl_fbdev_te_signal(void)
+{
+    sgl_pacing_t *pacing = &sgl_system.pacing;
+    uint32_t tick = sgl_tick_get();
+    int32_t period = (int32_t)((tick - pacing->te_tick) << 8);
+
+    if (pacing->te_count == 1) {
+        pacing->te_period = period;
+    }
+    else if (pacing->te_count > 1) {
+        pacing->te_period += (period - (int32_t)pacing->te_period) / 8;
+    }
+
+    pacing->te_tick = tick;
+    pacing->te_count ++;
+}
+
+
+/**
+ * @brief check if a frame should start now
+ * @param none
+ * @return true if the next frame is due
+ * @note with TE pulses, a frame is due when the pacing interval of TE pulses has passed since the
+ *       last frame, otherwise when SGL_SYSTEM_TICK_MS has passed
+ */
+bool sgl_frame_is_due(void);
+
+
+/**
+ * @brief get frame time statistics
+ * @param none
+ * @return frame time statistics
+ */
+sgl_frame_stats_t sgl_frame_get_stats(void);
+
+
+/**
+ * @brief reset frame time statistics
+ * @param none
+ * @return none
+ */
+void sgl_frame_stats_reset(void);
+#endif // !CONFIG_SGL_FRAME_PACING
+
+
+/**
+ * @brief get the tick that animations are sampled at
+ * @param none
+ * @return tick milliseconds, with frame pacing it is the tick at which the frame is expected to be
+ *         on the panel, so a slow frame shows the animation where it should be when it is seen
+ */
+static inline uint32_t sgl_frame_get_display_tick(void)
+{
+#if (CONFIG_SGL_FRAME_PACING)
+    return sgl_system.pacing.display_tick;
+#else
+    return sgl_tick_get();
+#endif
+}
+
+
 /**
 * @brief converts the color value of an integer into a color structure
 * @param: color value
@@ -893,8 +1249,8 @@ static inline void sgl_obj_node_init(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
 
-    obj->sibling = NULL;
-    obj->child = NULL;
+    obj->sibling = sgl_obj_to_link(NULL);
+    obj->child = sgl_obj_to_link(NULL);
 }
 
 
@@ -922,7 +1278,7 @@ void sgl_obj_remove(sgl_obj_t *obj);
  */
 static inline bool sgl_obj_has_child(sgl_obj_t *obj) {
     SGL_ASSERT(obj != NULL);
-    return (bool)obj->child;
+    return obj->child != sgl_obj_to_link(NULL);
 }
 
 
@@ -934,7 +1290,7 @@ static inline bool sgl_obj_has_child(sgl_obj_t *obj) {
 static inline sgl_obj_t* sgl_obj_get_child(sgl_obj_t* obj)
 {
     SGL_ASSERT(obj != NULL);
-    return obj->child;
+    return sgl_obj_from_link(obj->child);
 }
 
 
@@ -945,7 +1301,7 @@ static inline sgl_obj_t* sgl_obj_get_child(sgl_obj_t* obj)
  */
 static inline bool sgl_obj_has_sibling(sgl_obj_t *obj) {
     SGL_ASSERT(obj != NULL);
-    return (bool)obj->sibling;
+    return obj->sibling != sgl_obj_to_link(NULL);
 }
 
 
@@ -957,7 +1313,7 @@ static inline bool sgl_obj_has_sibling(sgl_obj_t *obj) {
 static inline sgl_obj_t* sgl_obj_get_sibling(sgl_obj_t* obj)
 {
     SGL_ASSERT(obj != NULL);
-    return obj->sibling;
+    return sgl_obj_from_link(obj->sibling);
 }
 
 
@@ -982,17 +1338,42 @@ static inline size_t sgl_obj_get_child_count(sgl_obj_t *obj)
 
 /**
  * @brief merge an area into global dirty area
- * 
- * This function calculates how much rectangle 'a' would need to grow in each direction (left, right, top, bottom)
- * to fully enclose both 'a' and 'b'. The result is the sum of the expansions along all four sides.
- * Note: This is not the increase in area, th is a lightweight heuristic for merge cost in bounding-box algorithms.
- * 
+ *
+ * The area is only collected here and areas that are inside another one are dropped, the final
+ * layout is decided by the dirty area planner once per frame. If there is no free slot, the two
+ * areas that are the cheapest to merge are merged to make room for the new one.
+ *
  * @param area [in] Pointer to the area
  * @return none
  */
 void sgl_dirty_area_push(sgl_area_t *area);
 
 
+/**
+ * @brief get pixels saved by the dirty area planner in the last frame
+ * @param none
+ * @return saved pixels, it is negative if the planner merged areas to save flushes
+ * @note the base is the sum of all dirty areas pushed in the frame
+ */
+static inline int32_t sgl_dirty_area_get_saved(void)
+{
+    return sgl_system.fbdev.saved_pixels;
+}
+
+
+/**
+ * @brief get the passes over the object tree to draw, since the framebuffer device is registered
+ * @param none
+ * @return number of passes, one for every slice, or for every batch of small dirty areas when
+ *         CONFIG_SGL_DRAW_BATCH is more than 1, or for every dirty area of many slices when
+ *         CONFIG_SGL_DRAW_LIST_SIZE is set
+ */
+static inline uint32_t sgl_draw_get_passes(void)
+{
+    return sgl_system.fbdev.draw_passes;
+}
+
+
 /**
  * @brief set system font
  * @param font pointer to font
@@ -1016,6 +1397,22 @@ static inline const sgl_font_t* sgl_get_system_font(void)
 }
 
 
+/**
+ * @brief mark the object and its parents up to the page, the dirty area pass goes into them
+ * @param obj point to object
+ * @return none
+ * @note it stops at the first object that is marked already, so marking many objects of the same
+ *       subtree costs little, and a page without the mark is skipped at once
+ */
+static inline void sgl_obj_set_subtree(sgl_obj_t *obj)
+{
+    while (obj != NULL && !obj->subtree) {
+        obj->subtree = 1;
+        obj = sgl_obj_from_link(obj->parent);
+    }
+}
+
+
 /**
  * @brief  Set the object to be destroyed
  * @param  obj: the object to set
@@ -1027,6 +1424,7 @@ static inline void sgl_obj_set_destroyed(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->destroyed = 1;
+    sgl_obj_set_subtree(obj);
 }
 
 
@@ -1052,6 +1450,7 @@ static inline void sgl_obj_set_dirty(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->dirty = 1;
+    sgl_obj_set_subtree(obj);
 }
 
 
@@ -1097,6 +1496,7 @@ static inline void sgl_obj_needinit(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->needinit = 1;
+    sgl_obj_set_subtree(obj);
 }
 
 
@@ -1147,6 +1547,11 @@ static inline void sgl_obj_set_visible(sgl_obj_t *obj)
     SGL_ASSERT(obj != NULL);
     obj->hide = 0;
     sgl_dirty_area_push(&obj->area);
+
+    /* the marks under a hidden object are kept, its parents need them again */
+    if (obj->subtree) {
+        sgl_obj_set_subtree(sgl_obj_from_link(obj->parent));
+    }
 }
 
 
@@ -1402,7 +1807,7 @@ static inline sgl_pos_t sgl_obj_get_abs_pos(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos(sgl_obj_t *obj, int16_t x, int16_t y)
 {
-    sgl_obj_set_abs_pos(obj, obj->parent->coords.x1 + x, obj->parent->coords.y1 + y);
+    sgl_obj_set_abs_pos(obj, sgl_obj_from_link(obj->parent)->coords.x1 + x, sgl_obj_from_link(obj->parent)->coords.y1 + y);
 }
 
 
@@ -1417,8 +1822,8 @@ static inline sgl_pos_t sgl_obj_get_pos(sgl_obj_t *obj)
     SGL_ASSERT(obj != NULL);
 
     sgl_pos_t pos;
-    pos.x = obj->coords.x1 - obj->parent->coords.x1;
-    pos.y = obj->coords.y1 - obj->parent->coords.y1;
+    pos.x = obj->coords.x1 - sgl_obj_from_link(obj->parent)->coords.x1;
+    pos.y = obj->coords.y1 - sgl_obj_from_link(obj->parent)->coords.y1;
     return pos;
 }
 
@@ -1432,7 +1837,7 @@ static inline sgl_pos_t sgl_obj_get_pos(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos_x(sgl_obj_t *obj, int16_t x)
 {
-    sgl_obj_set_abs_pos(obj, obj->parent->coords.x1 + x, obj->coords.y1);
+    sgl_obj_set_abs_pos(obj, sgl_obj_from_link(obj->parent)->coords.x1 + x, obj->coords.y1);
 }
 
 
@@ -1443,7 +1848,7 @@ static inline void sgl_obj_set_pos_x(sgl_obj_t *obj, int16_t x)
  */
 static inline size_t sgl_obj_get_pos_x(sgl_obj_t *obj)
 {
-    return (obj->coords.x1 - obj->parent->coords.x1);
+    return (obj->coords.x1 - sgl_obj_from_link(obj->parent)->coords.x1);
 }
 
 
@@ -1456,7 +1861,7 @@ static inline size_t sgl_obj_get_pos_x(sgl_obj_t *obj)
  */
 static inline void sgl_obj_set_pos_y(sgl_obj_t *obj, int16_t y)
 {
-    sgl_obj_set_abs_pos(obj, obj->coords.x1, obj->parent->coords.y1 + y);
+    sgl_obj_set_abs_pos(obj, obj->coords.x1, sgl_obj_from_link(obj->parent)->coords.y1 + y);
 }
 
 
@@ -1467,7 +1872,7 @@ static inline void sgl_obj_set_pos_y(sgl_obj_t *obj, int16_t y)
  */
 static inline int16_t sgl_obj_get_pos_y(sgl_obj_t *obj)
 {
-    return obj->coords.y1 - obj->parent->coords.y1;
+    return obj->coords.y1 - sgl_obj_from_link(obj->parent)->coords.y1;
 }
 
 
@@ -1520,6 +1925,7 @@ static inline void sgl_obj_set_size(sgl_obj_t *obj, int16_t width, int16_t heigh
     obj->coords.x2 = obj->coords.x1 + width - 1;
     obj->coords.y2 = obj->coords.y1 + height - 1;
     sgl_obj_set_dirty(obj);
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -1548,6 +1954,7 @@ static inline void sgl_obj_set_width(sgl_obj_t *obj, int16_t width)
 {
     SGL_ASSERT(obj != NULL);
     obj->coords.x2 = obj->coords.x1 + width - 1;
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -1573,6 +1980,7 @@ static inline void sgl_obj_set_height(sgl_obj_t *obj, int16_t height)
 {
     SGL_ASSERT(obj != NULL);
     obj->coords.y2 = obj->coords.y1 + height - 1;
+    sgl_event_hit_grid_invalidate();
 }
 
 
@@ -1643,7 +2051,7 @@ static inline void sgl_obj_set_event_cb(sgl_obj_t *obj, void (*event_fn)(sgl_eve
 {
     SGL_ASSERT(obj != NULL);
     obj->event_fn = event_fn;
-    obj->event_data = data;
+    sgl_obj_set_event_data(obj, data);
     obj->clickable = 1;
 }
 
@@ -1717,10 +2125,17 @@ void sgl_task_handle_sync(void);
  */
 static inline void sgl_task_handle(void)
 {
+#if (CONFIG_SGL_FRAME_PACING)
+    /* If the TE pulse or the system tick time has not been reached, skip directly. */
+    if (!sgl_frame_is_due()) {
+        return;
+    }
+#else
     /* If the system tick time has not been reached, skip directly. */
     if ((sgl_tick_get() - sgl_last_tick_get()) < SGL_SYSTEM_TICK_MS) {
         return;
     }
+#endif
 
     sgl_tick_sync();
     /* If the system tick time has been reached, execute the task. */
@@ -1728,6 +2143,74 @@ static inline void sgl_task_handle(void)
 }
 
 
+/**
+ * @brief get the time until sgl task has work to do, the main loop may sleep for it
+ * @param none
+ * @return milliseconds to wait, 0 means that sgl_task_handle() runs a frame now,
+ *         SGL_WAIT_FOREVER means that nothing is pending until the next input
+ * @note the main loop may sleep until the time is over or an input interrupt comes, it must add
+ *       the time that it slept with sgl_tick_inc(), see host/bench/tickless_sim.c
+ */
+uint32_t sgl_task_get_wait(void);
+
+
+/**
+ * @brief run sgl task at once, without waiting for the tick period
+ * @param none
+ * @return none
+ * @note call it when an input wakes up the main loop, so the input is drawn at once instead of
+ *       at the next tick period, the frame period starts again from now. With frame pacing it
+ *       does not wait for the TE pulse either, the latency of the input goes first
+ */
+static inline void sgl_task_handle_now(void)
+{
+    sgl_tick_sync();
+    sgl_task_handle_sync();
+}
+
+
+/**
+ * @brief  scratch arena monitor info
+ * @total_size: size of the scratch arena
+ * @peak_size: high water mark of the scratch arena in one frame
+ * @fallback: number of buffers that were taken from heap because the arena was full
+ */
+typedef struct sgl_scratch_monitor {
+    size_t    total_size;
+    size_t    peak_size;
+    uint32_t  fallback;
+} sgl_scratch_monitor_t;
+
+
+/**
+ * @brief get a temporary buffer for draw code, it is valid until the end of current frame
+ * @param size size of buffer
+ * @return pointer to buffer, NULL if the arena is full and the heap is out of memory
+ * @note the buffer is taken from the scratch arena, that is reset after every frame, so it
+ *       costs no heap time and leaves no hole in heap. If the arena is full, the buffer is
+ *       taken from heap, so always give it back with sgl_scratch_free()
+ */
+void* sgl_scratch_alloc(size_t size);
+
+
+/**
+ * @brief give back a buffer of sgl_scratch_alloc()
+ * @param p pointer to buffer
+ * @return none
+ * @note the arena space of the last buffer is reused at once, so a buffer that is taken and
+ *       given back in every slice does not fill the arena
+ */
+void sgl_scratch_free(void *p);
+
+
+/**
+ * @brief get scratch arena monitor info
+ * @param none
+ * @return scratch arena monitor info
+ */
+sgl_scratch_monitor_t sgl_scratch_get_monitor(void);
+
+
 /**
  * @brief Create an object
  * @param parent parent object
@@ -1812,6 +2295,49 @@ static inline sgl_color_t sgl_color_mixer(sgl_color_t fg_color, sgl_color_t bg_c
 }
 
 
+/**
+ * @brief fill a span of pixels with a solid color
+ * @param dest pointer to the first pixel
+ * @param color color to fill
+ * @param len number of pixels
+ * @return none
+ * @note RGB565 pixels are written in 32-bit words, see sgl/draw/sgl_draw_span.c
+ */
+void sgl_color_span_fill(sgl_color_t *dest, sgl_color_t color, uint32_t len);
+
+
+/**
+ * @brief blend a solid color into a span of pixels
+ * @param dest pointer to the first pixel
+ * @param color foreground color
+ * @param alpha alpha of foreground color
+ * @param len number of pixels
+ * @return none
+ * @note the result is the same as sgl_color_mixer(color, *dest, alpha) for every pixel,
+ *       RGB565 pixels are blended two at a time
+ */
+void sgl_color_span_blend(sgl_color_t *dest, sgl_color_t color, uint8_t alpha, uint32_t len);
+
+
+/**
+ * @brief fill or blend a span of pixels with a solid color
+ * @param dest pointer to the first pixel
+ * @param color color of span
+ * @param alpha alpha of span, SGL_ALPHA_MAX means fill
+ * @param len number of pixels
+ * @return none
+ */
+static inline void sgl_color_span(sgl_color_t *dest, sgl_color_t color, uint8_t alpha, uint32_t len)
+{
+    if (alpha == SGL_ALPHA_MAX) {
+        sgl_color_span_fill(dest, color, len);
+    }
+    else {
+        sgl_color_span_blend(dest, color, alpha, len);
+    }
+}
+
+
 /**
  * @brief Fills a block of memory with a solid color.
  *
@@ -1824,7 +2350,7 @@ static inline sgl_color_t sgl_color_mixer(sgl_color_t fg_color, sgl_color_t bg_c
  */
 static inline void sgl_color_set(sgl_color_t *dest, sgl_color_t color, uint32_t len)
 {
-    while (len--) {*dest++ = color; }
+    sgl_color_span_fill(dest, color, len);
 }
 
 
@@ -1998,11 +2524,24 @@ int sgl_obj_init(sgl_obj_t *obj, sgl_obj_t *parent);
 uint32_t sgl_utf8_to_unicode(const char *utf8_str, uint32_t *p_unicode_buffer);
 
 
+/**
+ * @brief Search for the index of a Unicode character in the unicode parts of font
+ * @param font Pointer to the font structure containing character data
+ * @param unicode Unicode of the character to be searched
+ * @return Index of the character in the font table, -1 if the character is not in the font
+ * @note it walks the unicode parts and ignores font index and lookup cache, it is the slow path
+ *       of sgl_search_unicode_ch_index()
+ */
+int32_t sgl_font_search_unicode(const sgl_font_t *font, uint32_t unicode);
+
+
 /**
  * @brief Search for the index of a Unicode character in the font table
  * @param font Pointer to the font structure containing character data
  * @param unicode Unicode of the character to be searched
- * @return Index of the character in the font table
+ * @return Index of the character in the font table, 0 if the character is not in the font
+ * @note the font index is used if the font has one, otherwise the unicode parts are searched
+ *       and the result is kept in lookup cache, see CONFIG_SGL_FONT_LOOKUP_CACHE
  */
 uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode);
 
@@ -2099,6 +2638,37 @@ void sgl_page_set_pixmap(sgl_obj_t* obj, const sgl_pixmap_t *pixmap);
 void sgl_page_set_alpha(sgl_obj_t* obj, uint8_t alpha);
 
 
+#if (CONFIG_SGL_PAGE_REGION)
+/**
+ * @brief create a page with its own memory region
+ * @param size size of the region, the page itself is also cut from it
+ * @return point to the page, NULL if the heap has no block of the size
+ * @note the widgets that are created between sgl_page_region_enter() and sgl_page_region_leave()
+ *       are cut from the region, with their option lists and texts. When the region is full they
+ *       go to the heap. Deleting the page frees the region with one sgl_free(), deleting a single
+ *       widget of the page does not give its memory back before the page is deleted.
+ */
+sgl_obj_t* sgl_page_create_with_region(size_t size);
+
+
+/**
+ * @brief make the region of a page active, the allocations go to it until sgl_page_region_leave()
+ * @param obj point to the page
+ * @return none
+ * @note do not create anything that lives longer than the page while the region is active
+ */
+void sgl_page_region_enter(sgl_obj_t *obj);
+
+
+/**
+ * @brief leave the active page region, the allocations go to the heap again
+ * @param none
+ * @return none
+ */
+void sgl_page_region_leave(void);
+#endif
+
+
 /**
  * @brief get parent of an object
  * @param obj the object
@@ -2107,7 +2677,7 @@ void sgl_page_set_alpha(sgl_obj_t* obj, uint8_t alpha);
 static inline sgl_obj_t* sgl_obj_get_parent(sgl_obj_t* obj)
 {
     SGL_ASSERT(obj != NULL);
-    return obj->parent;
+    return sgl_obj_from_link(obj->parent);
 }
 
 
@@ -2140,6 +2710,17 @@ int sgl_snprintf(char *buf, size_t size, const char *fmt, ...);
  * @param name The name to set.
  * @return None.
  */
+#if (CONFIG_SGL_OBJ_COMPACT)
+void sgl_obj_set_name(sgl_obj_t *obj, const char *name);
+
+
+/**
+ * @brief get object name
+ * @param obj The object
+ * @return name of the object, NULL if it is not set
+ */
+const char* sgl_obj_get_name(sgl_obj_t *obj);
+#else
 static inline void sgl_obj_set_name(sgl_obj_t *obj, const char *name)
 {
     SGL_ASSERT(obj != NULL);
@@ -2147,6 +2728,13 @@ static inline void sgl_obj_set_name(sgl_obj_t *obj, const char *name)
 }
 
 
+static inline const char* sgl_obj_get_name(sgl_obj_t *obj)
+{
+    return obj->name;
+}
+#endif
+
+
 /**
  * @brief print object name that include this all child
  * @param obj point to object
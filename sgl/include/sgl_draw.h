@@ -39,6 +39,13 @@ extern "C" {
 #define  SGL_ARC_MODE_NORMAL_SMOOTH                         (2)
 #define  SGL_ARC_MODE_RING_SMOOTH                           (3)
 
+#define  SGL_DRAW_BAND_INSIDE                               (0)
+#define  SGL_DRAW_BAND_INNER                                (1)
+#define  SGL_DRAW_BAND_BODY                                 (2)
+#define  SGL_DRAW_BAND_OUTER                                (3)
+#define  SGL_DRAW_BAND_RUNS                                 (7)
+#define  SGL_DRAW_HALF_LINE_INF                             (0x7fffff)
+
 
 /**
  * @brief rect description
@@ -58,6 +65,52 @@ typedef struct sgl_draw_rect {
 } sgl_draw_rect_t;
 
 
+/**
+ * @brief check if a rect description covers all pixels of its rect without blending
+ * @param desc rect description
+ * @return true if the rect is opaque
+ * @note it is used to answer SGL_EVENT_DRAW_OPAQUE
+ */
+static inline bool sgl_draw_rect_is_opaque(sgl_draw_rect_t *desc)
+{
+    return desc->alpha == SGL_ALPHA_MAX && desc->radius == 0;
+}
+
+
+/* glyph index of '\n' in text layout */
+#define  SGL_TEXT_LAYOUT_NEWLINE                            (0xFFFF)
+
+
+/**
+ * @brief shaped text of a text object, it is rebuilt only if the text or font changes
+ * @text: text of layout
+ * @font: font of layout
+ * @glyph: glyph index of each character in font table, SGL_TEXT_LAYOUT_NEWLINE for '\n',
+ *         NULL if the text is not shaped, then the layout is drawn from text directly
+ * @hash: hash of the text bytes, so that a text changed in place is shaped again
+ * @frame: frame that the text is checked last time, the text does not change while a frame is drawn
+ * @count: number of glyphs
+ * @capacity: number of glyphs that glyph buffer can hold
+ * @text_w: width of the text in one line
+ * @wrap_w: width of the last sgl_text_layout_get_height() call, -1 if none
+ * @wrap_h: height of text that is wrapped into wrap_w
+ * @wrap_margin: line space of the last sgl_text_layout_get_height() call
+ */
+typedef struct sgl_text_layout {
+    const char          *text;
+    const sgl_font_t    *font;
+    uint16_t            *glyph;
+    uint32_t            hash;
+    uint32_t            frame;
+    uint16_t            count;
+    uint16_t            capacity;
+    int16_t             text_w;
+    int16_t             wrap_w;
+    int32_t             wrap_h;
+    uint8_t             wrap_margin;
+} sgl_text_layout_t;
+
+
 /**
  * @brief line draw description
  * @x1: x1 coordinate
@@ -79,6 +132,25 @@ typedef struct sgl_draw_line {
 } sgl_draw_line_t;
 
 
+/**
+ * @brief polyline draw description
+ * @color: color
+ * @alpha: alpha
+ * @width: width of line, the lines of width 1 are drawn with two pixels of coverage per step
+ * @closed: the last point is joined to the first one
+ * @dash_on: length of dashes, 0 for a solid line
+ * @dash_off: length of gaps between dashes
+ */
+typedef struct sgl_draw_polyline {
+    sgl_color_t      color;
+    uint8_t          alpha;
+    uint8_t          width;
+    uint8_t          closed;
+    uint16_t         dash_on;
+    uint16_t         dash_off;
+} sgl_draw_polyline_t;
+
+
 /**
  * @brief rectangle description
  * @cx: center x of rectangle
@@ -129,6 +201,29 @@ typedef struct sgl_draw_arc {
 } sgl_draw_arc_t;
 
 
+/**
+ * @brief radial bands of a disc or a ring, a pixel is in the first band whose limit is above its
+ *        squared distance from the center, the pixels above all limits are outside
+ * @limit: squared distance limits of inside, inner edge, body and outer edge, they never go down
+ */
+typedef struct sgl_draw_band {
+    int32_t          limit[4];
+} sgl_draw_band_t;
+
+
+/**
+ * @brief run of a scanline whose pixels are all in one band
+ * @x1: start x of run
+ * @x2: end x of run
+ * @band: band of run, SGL_DRAW_BAND_INSIDE to SGL_DRAW_BAND_OUTER
+ */
+typedef struct sgl_draw_run {
+    int16_t          x1;
+    int16_t          x2;
+    uint8_t          band;
+} sgl_draw_run_t;
+
+
 /**
  * @brief icon description
  * @icon: icon pixmap
@@ -369,6 +464,17 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
 void sgl_draw_character( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, uint32_t ch_index, sgl_color_t color, uint8_t alpha, const sgl_font_t *font);
 
 
+#if (CONFIG_SGL_GLYPH_CACHE_SIZE > 0)
+/**
+ * @brief free all glyphs in glyph cache
+ * @param none
+ * @return none
+ * @note the glyphs are decoded again when they are drawn next time, call it if the heap is needed
+ */
+void sgl_draw_glyph_cache_flush(void);
+#endif
+
+
 /**
  * @brief Draw a string on the surface with alpha blending
  * @param surf Pointer to the surface where the string will be drawn
@@ -400,6 +506,76 @@ void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, c
 void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font, uint8_t line_margin);
 
 
+/**
+ * @brief shape text into layout, it does nothing if the text and font are not changed
+ * @param layout pointer to text layout
+ * @param text text string
+ * @param font font of text
+ * @return none
+ * @note if the glyph buffer can not be allocated, the layout falls back to the text string
+ */
+void sgl_text_layout_update(sgl_text_layout_t *layout, const char *text, const sgl_font_t *font);
+
+
+/**
+ * @brief free the glyph buffer of layout
+ * @param layout pointer to text layout
+ * @return none
+ * @note call it when the text object is destroyed
+ */
+void sgl_text_layout_free(sgl_text_layout_t *layout);
+
+
+/**
+ * @brief get the height of layout text, which is in a rect area
+ * @param layout pointer to text layout
+ * @param width width of the rect area
+ * @param line_space peer line space
+ * @return height of text, same as sgl_font_get_string_height()
+ */
+int32_t sgl_text_layout_get_height(sgl_text_layout_t *layout, int16_t width, uint8_t line_space);
+
+
+/**
+ * @brief get the position of layout text in the area
+ * @param layout pointer to text layout
+ * @param area point to area
+ * @param offset text offset
+ * @param type alignment type
+ * @return position of text, same as sgl_get_text_pos()
+ */
+sgl_pos_t sgl_text_layout_get_pos(sgl_text_layout_t *layout, sgl_area_t *area, int16_t offset, sgl_align_type_t type);
+
+
+/**
+ * @brief Draw a layout text on the surface with alpha blending
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the string
+ * @param y Y coordinate of the top-left corner of the string
+ * @param layout Pointer to the text layout
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @return none
+ */
+void sgl_draw_text_layout(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief Draw a layout text on the surface with alpha blending and multiple lines
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the string
+ * @param y Y coordinate of the top-left corner of the string
+ * @param layout Pointer to the text layout
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ */
+void sgl_draw_text_layout_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sgl_text_layout_t *layout, sgl_color_t color, uint8_t alpha, uint8_t line_margin);
+
+
 /**
  * @brief draw a ring on surface with alpha
  * @param surf: pointer of surface
@@ -455,7 +631,7 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t
  * @param color line color
  * @param alpha alpha of color
  * @return none
- * @note This algorithm is SDF algorithm
+ * @note the pixels are tested by a capsule SDF only near the edges of each scanline
  */
 void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t thickness, sgl_color_t color, uint8_t alpha);
 
@@ -470,6 +646,22 @@ void draw_line_fill_slanted(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int1
 void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_line_t *desc);
 
 
+/**
+ * @brief draw a polyline, the pixels near a joint are blended once
+ * @param surf surface
+ * @param area area that contains the polyline
+ * @param x x coordinate of the origin of points
+ * @param y y coordinate of the origin of points
+ * @param points points of the polyline
+ * @param count number of points
+ * @param desc polyline description
+ * @return none
+ * @note the dashes of a line of width 1 are counted in steps of its longer axis, the others
+ *       along the polyline
+ */
+void sgl_draw_polyline(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_pos_t *points, uint16_t count, const sgl_draw_polyline_t *desc);
+
+
 /**
  * @brief draw an arc with alpha
  * @param surf pointer to surface
@@ -480,6 +672,46 @@ void sgl_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_line_t *desc);
 void sgl_draw_fill_arc(sgl_surf_t *surf, sgl_area_t *area, sgl_draw_arc_t *desc);
 
 
+/**
+ * @brief get the integers x where a * x + b >= 0, they are one half line, all or none of them
+ * @param a factor of x
+ * @param b constant
+ * @param lo first x of the half line, -SGL_DRAW_HALF_LINE_INF if it has no start
+ * @param hi last x of the half line, SGL_DRAW_HALF_LINE_INF if it has no end, it is below lo
+ *        if no x matches
+ * @return none
+ */
+void sgl_draw_half_line(int32_t a, int32_t b, int32_t *lo, int32_t *hi);
+
+
+/**
+ * @brief set the limits of the radial bands of a disc or a ring, a pixel at the squared distance
+ *        r2 is outside if r2 >= outside, else inside if r2 < inside, else inner edge if r2 < inner,
+ *        else body if r2 < body, else outer edge
+ * @param band bands to set
+ * @param inside limit of inside
+ * @param inner limit of inner edge
+ * @param body limit of body
+ * @param outside limit of outer edge
+ * @return none
+ */
+void sgl_draw_band_init(sgl_draw_band_t *band, int32_t inside, int32_t inner, int32_t body, int32_t outside);
+
+
+/**
+ * @brief cut a scanline of a disc or a ring into runs of the same band, from left to right
+ * @param band bands of the disc or ring
+ * @param cx x coordinate of the center
+ * @param y2 squared distance of the scanline from the center
+ * @param x1 start x of scanline
+ * @param x2 end x of scanline
+ * @param run runs of the scanline, at most SGL_DRAW_BAND_RUNS
+ * @return number of runs, the outside pixels are in no run
+ * @note the run bounds come from one square root per band, so the pixels of a run are not tested
+ */
+int sgl_draw_band_runs(const sgl_draw_band_t *band, int16_t cx, int32_t y2, int16_t x1, int16_t x2, sgl_draw_run_t *run);
+
+
 /**
  * @brief calculate a point color by bilinear interpolate
  * @param buffer point to image pixmap start buffer
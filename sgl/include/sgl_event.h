@@ -66,6 +66,8 @@ struct sgl_page;
 #define  SGL_EVENT_FOCUSED              (16)
 #define  SGL_EVENT_UNFOCUSED            (17)
 #define  SGL_EVENT_DESTROYED            (18)
+/* draw query, set *(bool*)evt->param to true if the object covers its area with opaque pixels */
+#define  SGL_EVENT_DRAW_OPAQUE          (19)
 #define  sgl_event_type_t               uint8_t
 
 
@@ -107,16 +109,50 @@ int sgl_event_queue_init(void);
 /**
  * @brief Push an event into the event queue
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note call it in sgl task only, such as the event callback of objects, the input device
+ *       should use sgl_event_send_pos() or sgl_event_pos_input()
  */
 void sgl_event_queue_push(sgl_event_t event);
 
 
+/**
+ * @brief Get the number of events that are dropped because the event queue is full
+ * @param none
+ * @return number of dropped events of both event queue and input event queue
+ */
+uint32_t sgl_event_queue_get_dropped(void);
+
+
+/**
+ * @brief Check if there are events that wait for sgl_event_task()
+ * @param none
+ * @return true if the event queue or the input event queue is not empty
+ */
+bool sgl_event_is_pending(void);
+
+
+/**
+ * @brief Mark the hit-test grid out of date, it is rebuilt when the next click is detected
+ * @param none
+ * @return none
+ * @note sgl calls it when objects are added, removed, reordered, moved or resized, call it
+ *       if you write the coords of an object directly and do not set the object dirty
+ */
+#if (CONFIG_SGL_EVENT_HIT_GRID_CELL)
+void sgl_event_hit_grid_invalidate(void);
+#else
+static inline void sgl_event_hit_grid_invalidate(void) {}
+#endif
+
+
 /**
  * @brief Handle the position event
  * @param pos The position to be handled
  * @param type The type of the event
  * @return none
+ * @note it can be called in interrupt, the input event queue has one producer, so do not
+ *       call it from two contexts at the same time
  */
 void sgl_event_send_pos(sgl_event_pos_t pos, sgl_event_type_t type);
 
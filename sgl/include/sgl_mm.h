@@ -40,12 +40,18 @@ extern "C" {
  * @used_rate: used rate of memory:
  *             |  8 bit  |  8 bit |          
  *             |   int   |   dec  |
+ * @slab_size: size of the slab arena, it is 0 if the heap algorithm is not slab
+ * @slab_used: bytes of the slab objects in use, they are also counted by used_size
+ * @slab_fallback: number of small allocations that did not get a slab object and went to lwmem
  */
 typedef struct sgl_mm_monitor {
     size_t  total_size;
     size_t  free_size;
     size_t  used_size;
     size_t  used_rate;
+    size_t  slab_size;
+    size_t  slab_used;
+    size_t  slab_fallback;
 
 } sgl_mm_monitor_t;
 
@@ -105,6 +111,221 @@ void sgl_free(void *p);
 sgl_mm_monitor_t sgl_mm_get_monitor(void);
 
 
+#if (CONFIG_SGL_HEAP_TRACE)
+
+/* number of bins of the free block histogram, bin i counts the blocks smaller than 16 << i
+ * bytes and the last bin counts all bigger ones
+ */
+#define  SGL_MM_TRACE_HIST_NUM              (8)
+
+
+/**
+ * @brief  heap trace info
+ * @used_size: used size of heap, the same as sgl_mm_monitor_t
+ * @peak_size: high water mark of used_size
+ * @free_size: bytes of all free blocks
+ * @largest_free: size of the largest free block
+ * @free_blocks: number of free blocks
+ * @alloc_count: number of allocations
+ * @free_count: number of frees
+ * @failed_count: number of failed allocations
+ * @hist: free block histogram, see SGL_MM_TRACE_HIST_NUM
+ */
+typedef struct sgl_mm_trace {
+    size_t    used_size;
+    size_t    peak_size;
+    size_t    free_size;
+    size_t    largest_free;
+    uint32_t  free_blocks;
+    uint32_t  alloc_count;
+    uint32_t  free_count;
+    uint32_t  failed_count;
+    uint16_t  hist[SGL_MM_TRACE_HIST_NUM];
+} sgl_mm_trace_t;
+
+
+/**
+ * @brief  heap trace info of an owner, the owner of a block is the source file that allocates it
+ * @name: source file name, the directories are removed
+ * @count: number of blocks in use
+ * @bytes: requested bytes of the blocks in use
+ * @peak: high water mark of bytes
+ */
+typedef struct sgl_mm_trace_owner {
+    const char  *name;
+    uint32_t    count;
+    size_t      bytes;
+    size_t      peak;
+} sgl_mm_trace_owner_t;
+
+
+/**
+ * @brief  walk all free blocks of heap, every heap algorithm provides it
+ * @param  walker  called with the usable size of every free block
+ * @param  user  user data of walker
+ */
+void sgl_mm_walk_free(void (*walker)(size_t size, void *user), void *user);
+
+
+/**
+ * @brief  traced memory alloc, sgl_malloc() is mapped to it
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller
+ * @return point to request memory address
+ */
+void* sgl_mm_trace_malloc(size_t size, const char *owner);
+
+
+/**
+ * @brief  traced memory realloc, sgl_realloc() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller
+ */
+void* sgl_mm_trace_realloc(void *p, size_t size, const char *owner);
+
+
+/**
+ * @brief  traced memory free, sgl_free() is mapped to it
+ * @param  p  the pointer of request size of memory
+ */
+void sgl_mm_trace_free(void *p);
+
+
+/**
+ * @brief  get heap trace info, the free blocks are walked at this time
+ * @param  info  heap trace info
+ */
+void sgl_mm_trace_get(sgl_mm_trace_t *info);
+
+
+/**
+ * @brief  get heap trace info of an owner
+ * @param  index  index of owner, from 0
+ * @param  owner  heap trace info of the owner
+ * @return 0 if success, -1 if there is no owner of the index
+ */
+int sgl_mm_trace_get_owner(int index, sgl_mm_trace_owner_t *owner);
+
+
+/**
+ * @brief  print heap trace info in the compact format, host/tools/mm_decode.c decodes it
+ * @param  print  output function, it is called with one line at a time
+ * @note   the format is a line of "mm:v1" and numbers in hex:
+ *         total, used, peak, free, largest free, free blocks, allocs, frees, failed,
+ *         a line of "mm:h" and the histogram, then a line of "mm:o" for every owner:
+ *         name, count, bytes, peak, and a line of "mm:end"
+ */
+void sgl_mm_trace_dump(void (*print)(const char *str));
+
+#endif // !CONFIG_SGL_HEAP_TRACE
+
+
+#if (CONFIG_SGL_PAGE_REGION)
+
+/**
+ * @brief  memory region, a block of heap that is cut by a bump pointer and freed at once
+ * @next: next region in use
+ * @top: first free byte of the region
+ * @end: end of the region
+ * @last: the last block, only it can be rolled back or grown in place
+ * @fallback: number of allocations that did not fit and went to the heap
+ * @note the memory of the region follows this head
+ */
+typedef struct sgl_mm_region {
+    struct sgl_mm_region *next;
+    uint8_t              *top;
+    uint8_t              *end;
+    void                 *last;
+    uint32_t             fallback;
+} sgl_mm_region_t;
+
+
+/**
+ * @brief  create a memory region from the heap
+ * @param  size  size of the region
+ * @return point to the region, NULL if the heap has no block of the size
+ */
+sgl_mm_region_t* sgl_mm_region_create(size_t size);
+
+
+/**
+ * @brief  delete a memory region, all blocks of the region are freed at once
+ * @param  region  point to the region
+ * @note   the active region is left if it is the region
+ */
+void sgl_mm_region_delete(sgl_mm_region_t *region);
+
+
+/**
+ * @brief  make the region active, sgl_malloc() cuts the blocks from it until it is left
+ * @param  region  point to the region, NULL to leave the active region
+ * @return the region that was active before
+ */
+sgl_mm_region_t* sgl_mm_region_enter(sgl_mm_region_t *region);
+
+
+/**
+ * @brief  make a region that was left with sgl_mm_region_enter(NULL) active again
+ * @param  region  the region that sgl_mm_region_enter() returned, it can be NULL
+ * @note   the region is not entered if it was deleted since, then no region is active
+ */
+void sgl_mm_region_resume(sgl_mm_region_t *region);
+
+
+/**
+ * @brief  memory alloc of the region layer, sgl_malloc() is mapped to it
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller, it is passed to the heap trace
+ * @return point to request memory address
+ */
+void* sgl_mm_region_malloc(size_t size, const char *owner);
+
+
+/**
+ * @brief  memory realloc of the region layer, sgl_realloc() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller, it is passed to the heap trace
+ * @note   a block of a region stays in its region if there is room, otherwise it is moved
+ *         to the heap
+ */
+void* sgl_mm_region_realloc(void *p, size_t size, const char *owner);
+
+
+/**
+ * @brief  memory free of the region layer, sgl_free() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @note   a block of a region is only given back when it is the last one, the others are
+ *         freed with the region
+ */
+void sgl_mm_region_free(void *p);
+
+#endif // !CONFIG_SGL_PAGE_REGION
+
+
+/* sgl_malloc and friends go through the page regions and the heap trace, except in the heap
+ * algorithms themselves
+ */
+#ifndef SGL_MM_BACKEND
+#if (CONFIG_SGL_HEAP_TRACE)
+#define SGL_MM_OWNER                        __FILE__
+#else
+#define SGL_MM_OWNER                        NULL
+#endif
+
+#if (CONFIG_SGL_PAGE_REGION)
+#define sgl_malloc(size)                    sgl_mm_region_malloc((size), SGL_MM_OWNER)
+#define sgl_realloc(p, size)                sgl_mm_region_realloc((p), (size), SGL_MM_OWNER)
+#define sgl_free(p)                         sgl_mm_region_free(p)
+#elif (CONFIG_SGL_HEAP_TRACE)
+#define sgl_malloc(size)                    sgl_mm_trace_malloc((size), SGL_MM_OWNER)
+#define sgl_realloc(p, size)                sgl_mm_trace_realloc((p), (size), SGL_MM_OWNER)
+#define sgl_free(p)                         sgl_mm_trace_free(p)
+#endif
+#endif // !SGL_MM_BACKEND
+
+
 #ifdef __cplusplus
 }
 #endif
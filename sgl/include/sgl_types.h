@@ -72,7 +72,8 @@ extern "C" {
 #define SGL_POS_INVALID                         (0xefff)
 #define SGL_POS_MAX                             (8192)
 #define SGL_POS_MIN                             (-8192)
-#define SGL_RADIUS_INVALID                      (0xFFF)
+#define SGL_RADIUS_INVALID                      (0x7FF)
+#define SGL_WAIT_FOREVER                        (0xFFFFFFFFu)
 
 #define SGL_AREA_MAX                            {.x1 = SGL_POS_MIN, .y1 = SGL_POS_MIN, .x2 = SGL_POS_MAX, .y2 = SGL_POS_MAX}
 #define SGL_AREA_INVALID                        {.x1 = SGL_POS_MAX, .y1 = SGL_POS_MAX, .x2 = SGL_POS_MIN, .y2 = SGL_POS_MIN}
@@ -121,6 +122,7 @@ extern "C" {
 #define  SGL_PIXMAP_FMT_MAX                     (13)
 
 
+/* sgl_barrier() is a compiler memory barrier, it is enough between an interrupt and the main loop of a single core MCU */
 #ifdef __GNUC__            /* gcc compiler   */
 #ifndef likely
 #  define likely(x)                             __builtin_expect(!!(x), 1)
@@ -128,6 +130,7 @@ extern "C" {
 #endif
 #define sgl_weak_fn                             __attribute__((weak))
 #define sgl_section(sec)                        __attribute__((section(#sec)))
+#define sgl_barrier()                           __asm__ volatile("" ::: "memory")
 #elif defined(__clang__)   /* clang compiler */
 #ifndef likely
 #  define likely(x)                             __builtin_expect(!!(x), 1)
@@ -135,6 +138,7 @@ extern "C" {
 #endif
 #define sgl_weak_fn                             __attribute__((weak))
 #define sgl_section(sec)                        __attribute__((section(#sec)))
+#define sgl_barrier()                           __asm__ volatile("" ::: "memory")
 #elif defined(__CC_ARM)    /* RealView compiler (Keil ARMCC) */
 #ifndef likely
 #  define likely(x)                             __builtin_expect(!!(x), 1)
@@ -142,6 +146,7 @@ extern "C" {
 #endif
 #define sgl_weak_fn                             __weak
 #define sgl_section(sec)                        __attribute__((section(#sec)))
+#define sgl_barrier()                           __memory_changed()
 #elif defined(__ICCARM__)  /* IAR compiler    */
 #ifndef likely
 #  define likely(x)                             __iar_builtin_expect(!!(x), 1)
@@ -149,12 +154,14 @@ extern "C" {
 #endif
 #define sgl_weak_fn                             __weak
 #define sgl_section(sec)                        __section(#sec)
+#define sgl_barrier()                           __asm volatile("" ::: "memory")
 #elif defined(_MSC_VER)    /* MSVC compiler   */
 #ifndef likely
 #  define likely(x)                             (x)
 #  define unlikely(x)                           (x)
 #endif
 #define sgl_weak_fn                             __declspec(selectany)
+#define sgl_barrier()                           _ReadWriteBarrier()
 #elif defined(__MINGW32__) /* MinGW compiler  */
 #ifndef likely
 #  define likely(x)                             __builtin_expect(!!(x), 1)
@@ -162,11 +169,13 @@ extern "C" {
 #endif
 #define sgl_weak_fn                             __attribute__((weak))
 #define sgl_section(sec)                        __attribute__((section(#sec)))
+#define sgl_barrier()                           __asm__ volatile("" ::: "memory")
 #else                      /* others compiler */
 #ifndef likely
 #  define likely(x)                             (x)
 #  define unlikely(x)                           (x)
 #endif
+#define sgl_barrier()                           do {} while (0)
 #warning "Weak linkage not supported for this compiler"                    
 #endif
 
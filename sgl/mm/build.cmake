@@ -21,6 +21,12 @@
 # SOFTWARE.
 #
 
+set(SGL_SOURCE
+    ${SGL_SOURCE}
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_mm_trace.c
+    ${CMAKE_CURRENT_LIST_DIR}/sgl_mm_region.c
+)
+
 if(${SGL_HEAP_ALGO} STREQUAL "tlsf")
     set(SGL_SOURCE
         ${SGL_SOURCE}
@@ -37,6 +43,14 @@ if(${SGL_HEAP_ALGO} STREQUAL "lwmem")
     )
 endif()
 
+if(${SGL_HEAP_ALGO} STREQUAL "slab")
+    set(SGL_SOURCE
+        ${SGL_SOURCE}
+        ${CMAKE_CURRENT_LIST_DIR}/lwmem/lwmem.c
+        ${CMAKE_CURRENT_LIST_DIR}/slab/sgl_mm.c
+    )
+endif()
+
 if(${SGL_HEAP_ALGO} STREQUAL "bump")
     set(SGL_SOURCE
         ${SGL_SOURCE}
@@ -26,6 +26,7 @@
  * WARNING: This memory allocator is not support free operation, if you free the memory, the memory will be corrupted.
  */
 
+#define SGL_MM_BACKEND
 #include <stdint.h>
 #include <sgl_mm.h>
 #include <sgl_log.h>
@@ -135,3 +136,18 @@ sgl_mm_monitor_t sgl_mm_get_monitor(void)
 
     return mem;
 }
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+/**
+ * @brief  walk all free blocks of heap, every heap algorithm provides it
+ * @param  walker  called with the usable size of every free block
+ * @param  user  user data of walker
+ */
+void sgl_mm_walk_free(void (*walker)(size_t size, void *user), void *user)
+{
+    if (mem.total_size > bump_mem_offset) {
+        walker(mem.total_size - bump_mem_offset, user);
+    }
+}
+#endif
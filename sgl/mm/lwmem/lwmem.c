@@ -1138,6 +1138,27 @@ lwmem_get_size_ex(lwmem_t* lwobj, void* ptr) {
     return len;
 }
 
+/**
+ * \brief           Walk all free blocks of a LwMEM instance
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       walker: Function called with the usable size of every free block
+ * \param[in]       user: User data passed to walker
+ * \note            This function is added for the heap trace of SGL
+ */
+void
+lwmem_walk_free_ex(lwmem_t* lwobj, void (*walker)(size_t size, void* user), void* user) {
+    lwmem_block_t* block;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (block = lwobj->start_block.next; block != NULL && block != lwobj->end_block; block = block->next) {
+        if (block->size > LWMEM_BLOCK_META_SIZE) {
+            walker(block->size - LWMEM_BLOCK_META_SIZE, user);
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
@@ -1282,6 +1303,17 @@ lwmem_get_size(void* ptr) {
     return lwmem_get_size_ex(NULL, ptr);
 }
 
+/**
+ * \note            This is a wrapper for \ref lwmem_walk_free_ex function.
+ *                      It operates in default LwMEM instance
+ * \param[in]       walker: Function called with the usable size of every free block
+ * \param[in]       user: User data passed to walker
+ */
+void
+lwmem_walk_free(void (*walker)(size_t size, void* user), void* user) {
+    lwmem_walk_free_ex(NULL, walker, user);
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 /* Part of library used ONLY for LWMEM_DEV purposes */
@@ -50,6 +50,7 @@
  */
 
 
+#define SGL_MM_BACKEND
 #include <stdint.h>
 #include <sgl_mm.h>
 #include <sgl_log.h>
@@ -139,3 +140,18 @@ sgl_mm_monitor_t sgl_mm_get_monitor(void)
 
     return mem;
 }
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+/**
+ * @brief  walk all free blocks of heap, every heap algorithm provides it
+ * @param  walker  called with the usable size of every free block
+ * @param  user  user data of walker
+ * @note   the free blocks of the C library are not known, implement it for your own heap
+ */
+sgl_weak_fn void sgl_mm_walk_free(void (*walker)(size_t size, void *user), void *user)
+{
+    SGL_UNUSED(walker);
+    SGL_UNUSED(user);
+}
+#endif
@@ -0,0 +1,291 @@
+/* source/mm/sgl_mm_region.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Memory regions, they are used by the pages that are built and deleted as a whole. If
+ * CONFIG_SGL_PAGE_REGION is 1, sgl_mm.h maps sgl_malloc(), sgl_realloc() and sgl_free() of all
+ * source files to the functions here. While a region is active the blocks are cut from it by a
+ * bump pointer, and when it is full they go to the heap. Freeing a block of a region does
+ * nothing, unless it is the last one, the whole region is given back to the heap with one free.
+ */
+
+#define SGL_MM_BACKEND
+#include <string.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+
+
+#if (CONFIG_SGL_PAGE_REGION)
+
+#define  REGION_ALIGN                       (8)
+#define  REGION_ALIGN_UP(x)                 (((x) + REGION_ALIGN - 1) & ~(uintptr_t)(REGION_ALIGN - 1))
+#define  REGION_ALIGN_DOWN(x)               ((x) & ~(uintptr_t)(REGION_ALIGN - 1))
+
+
+/* the heap under the regions, it is traced if the heap trace is enabled */
+#if (CONFIG_SGL_HEAP_TRACE)
+#define  region_heap_malloc(size, owner)    sgl_mm_trace_malloc((size), (owner))
+#define  region_heap_realloc(p, size, owner) sgl_mm_trace_realloc((p), (size), (owner))
+#define  region_heap_free(p)                sgl_mm_trace_free(p)
+#else
+#define  region_heap_malloc(size, owner)    ((void)(owner), sgl_malloc(size))
+#define  region_heap_realloc(p, size, owner) ((void)(owner), sgl_realloc((p), (size)))
+#define  region_heap_free(p)                sgl_free(p)
+#endif
+
+
+static struct {
+    sgl_mm_region_t  *list;
+    sgl_mm_region_t  *active;
+} region_ctx;
+
+
+/**
+ * @brief  find the region of a block
+ * @param  p  pointer to block
+ * @return the region, NULL if the block is in the heap
+ */
+static sgl_mm_region_t* region_find(const void *p)
+{
+    sgl_mm_region_t *region;
+
+    for (region = region_ctx.list; region != NULL; region = region->next) {
+        if ((const uint8_t*)p > (const uint8_t*)region && (const uint8_t*)p < region->end) {
+            return region;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief  cut a block from a region
+ * @param  region  point to the region
+ * @param  size  request size of memory
+ * @return point to the block, NULL if the region is full
+ */
+static void* region_cut(sgl_mm_region_t *region, size_t size)
+{
+    uint8_t *p = region->top;
+
+    /* top and end are aligned, so the aligned size fits if the size fits */
+    if (size == 0 || size > (size_t)(region->end - p)) {
+        return NULL;
+    }
+
+    region->top = p + REGION_ALIGN_UP(size);
+    region->last = p;
+    return p;
+}
+
+
+/**
+ * @brief  create a memory region from the heap
+ * @param  size  size of the region
+ * @return point to the region, NULL if the heap has no block of the size
+ */
+sgl_mm_region_t* sgl_mm_region_create(size_t size)
+{
+    size_t total = sizeof(sgl_mm_region_t) + REGION_ALIGN + size;
+    sgl_mm_region_t *region = region_heap_malloc(total, __FILE__);
+
+    if (region == NULL) {
+        SGL_LOG_ERROR("sgl_mm_region_create: malloc failed");
+        return NULL;
+    }
+
+    region->top = (uint8_t*)REGION_ALIGN_UP((uintptr_t)(region + 1));
+    region->end = (uint8_t*)REGION_ALIGN_DOWN((uintptr_t)region + total);
+    region->last = NULL;
+    region->fallback = 0;
+
+    region->next = region_ctx.list;
+    region_ctx.list = region;
+
+    return region;
+}
+
+
+/**
+ * @brief  delete a memory region, all blocks of the region are freed at once
+ * @param  region  point to the region
+ * @note   the active region is left if it is the region
+ */
+void sgl_mm_region_delete(sgl_mm_region_t *region)
+{
+    sgl_mm_region_t **link = &region_ctx.list;
+
+    while (*link != NULL && *link != region) {
+        link = &(*link)->next;
+    }
+
+    if (*link == NULL) {
+        SGL_LOG_ERROR("sgl_mm_region_delete: region is not in use");
+        return;
+    }
+
+    *link = region->next;
+    if (region_ctx.active == region) {
+        region_ctx.active = NULL;
+    }
+
+    region_heap_free(region);
+}
+
+
+/**
+ * @brief  make the region active, sgl_malloc() cuts the blocks from it until it is left
+ * @param  region  point to the region, NULL to leave the active region
+ * @return the region that was active before
+ */
+sgl_mm_region_t* sgl_mm_region_enter(sgl_mm_region_t *region)
+{
+    sgl_mm_region_t *prev = region_ctx.active;
+
+    region_ctx.active = region;
+    return prev;
+}
+
+
+/**
+ * @brief  make a region that was left with sgl_mm_region_enter(NULL) active again
+ * @param  region  the region that sgl_mm_region_enter() returned, it can be NULL
+ * @note   the region is not entered if it was deleted since, then no region is active
+ */
+void sgl_mm_region_resume(sgl_mm_region_t *region)
+{
+    sgl_mm_region_t *p = region_ctx.list;
+
+    while (p != NULL && p != region) {
+        p = p->next;
+    }
+
+    region_ctx.active = p;
+}
+
+
+/**
+ * @brief  memory alloc of the region layer, sgl_malloc() is mapped to it
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller, it is passed to the heap trace
+ * @return point to request memory address
+ */
+void* sgl_mm_region_malloc(size_t size, const char *owner)
+{
+    sgl_mm_region_t *region = region_ctx.active;
+    void *p;
+
+    if (region == NULL) {
+        return region_heap_malloc(size, owner);
+    }
+
+    p = region_cut(region, size);
+    if (p == NULL) {
+        region->fallback ++;
+        p = region_heap_malloc(size, owner);
+    }
+
+    return p;
+}
+
+
+/**
+ * @brief  memory realloc of the region layer, sgl_realloc() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller, it is passed to the heap trace
+ * @note   a block of a region stays in its region if there is room, otherwise it is moved
+ *         to the heap
+ */
+void* sgl_mm_region_realloc(void *p, size_t size, const char *owner)
+{
+    sgl_mm_region_t *region;
+    uint8_t *top;
+    void *ret;
+
+    if (p == NULL) {
+        return sgl_mm_region_malloc(size, owner);
+    }
+
+    region = region_find(p);
+    if (region == NULL) {
+        return region_heap_realloc(p, size, owner);
+    }
+
+    if (size == 0) {
+        sgl_mm_region_free(p);
+        return NULL;
+    }
+
+    /* the last block grows or shrinks in place */
+    if (p == region->last && size <= (size_t)(region->end - (uint8_t*)p)) {
+        region->top = (uint8_t*)p + REGION_ALIGN_UP(size);
+        return p;
+    }
+
+    top = region->top;
+    ret = region_cut(region, size);
+    if (ret == NULL) {
+        region->fallback ++;
+        ret = region_heap_malloc(size, owner);
+        if (ret == NULL) {
+            return NULL;
+        }
+    }
+
+    /* the size of the old block is not kept, but it can not reach over the top */
+    memcpy(ret, p, sgl_min(size, (size_t)(top - (uint8_t*)p)));
+    return ret;
+}
+
+
+/**
+ * @brief  memory free of the region layer, sgl_free() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @note   a block of a region is only given back when it is the last one, the others are
+ *         freed with the region
+ */
+void sgl_mm_region_free(void *p)
+{
+    sgl_mm_region_t *region;
+
+    if (p == NULL) {
+        return;
+    }
+
+    region = region_find(p);
+    if (region == NULL) {
+        region_heap_free(p);
+        return;
+    }
+
+    if (p == region->last) {
+        region->top = p;
+        region->last = NULL;
+    }
+}
+
+#endif // !CONFIG_SGL_PAGE_REGION
@@ -0,0 +1,333 @@
+/* source/mm/sgl_mm_trace.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Heap trace, it works over every heap algorithm. If CONFIG_SGL_HEAP_TRACE is 1, sgl_mm.h maps
+ * sgl_malloc(), sgl_realloc() and sgl_free() of all source files to the functions here, they
+ * put a small head in front of every block that keeps the requested size and the owner, that
+ * is the source file which allocates the block, so a widget type, the animations or the glyph
+ * cache of sgl_draw_text.c are counted each on their own.
+ */
+
+#define SGL_MM_BACKEND
+#include <string.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+
+#define  TRACE_OWNER_NUM                    (32)
+#define  TRACE_MAGIC                        (0x6D6D)
+
+
+/**
+ * @brief head of a traced block, it keeps the block 8 bytes aligned
+ * @size: requested size
+ * @owner: index of the owner
+ * @magic: TRACE_MAGIC while the block is in use
+ */
+typedef struct trace_head {
+    uint32_t  size;
+    uint16_t  owner;
+    uint16_t  magic;
+} trace_head_t;
+
+
+static struct {
+    sgl_mm_trace_owner_t  owner[TRACE_OWNER_NUM];
+    int                   owner_num;
+    size_t                peak_size;
+    uint32_t              alloc_count;
+    uint32_t              free_count;
+    uint32_t              failed_count;
+} trace;
+
+
+/**
+ * @brief  get the owner index of a source file, a new owner is added if it is the first time
+ * @param  name  source file name
+ * @return index of the owner, the last owner is "other" and it takes all source files
+ *         that do not get an owner of their own
+ */
+static uint16_t trace_owner_get(const char *name)
+{
+    int i;
+
+    for (i = 0; i < trace.owner_num; i++) {
+        if (trace.owner[i].name == name || strcmp(trace.owner[i].name, name) == 0) {
+            return i;
+        }
+    }
+
+    if (trace.owner_num == TRACE_OWNER_NUM) {
+        return TRACE_OWNER_NUM - 1;
+    }
+
+    trace.owner[i].name = (i == TRACE_OWNER_NUM - 1) ? "other" : name;
+    trace.owner_num ++;
+    return i;
+}
+
+
+/**
+ * @brief  count the blocks of an owner
+ * @param  head  head of block
+ * @param  add  true if the block is allocated, false if it is freed
+ * @return none
+ */
+static void trace_owner_count(trace_head_t *head, bool add)
+{
+    sgl_mm_trace_owner_t *owner = &trace.owner[head->owner];
+    size_t used;
+
+    if (add) {
+        owner->count ++;
+        owner->bytes += head->size;
+        owner->peak = sgl_max(owner->peak, owner->bytes);
+
+        used = sgl_mm_get_monitor().used_size;
+        trace.peak_size = sgl_max(trace.peak_size, used);
+    }
+    else {
+        owner->count --;
+        owner->bytes -= head->size;
+    }
+}
+
+
+/**
+ * @brief  get the head of a traced block
+ * @param  p  pointer to block
+ * @return head of block, NULL if p is not a traced block in use
+ */
+static trace_head_t* trace_head_get(void *p)
+{
+    trace_head_t *head = (trace_head_t*)p - 1;
+
+    if (head->magic != TRACE_MAGIC) {
+        SGL_LOG_ERROR("sgl_mm_trace: block is not in use, double free or overflow");
+        return NULL;
+    }
+
+    return head;
+}
+
+
+/**
+ * @brief  traced memory alloc, sgl_malloc() is mapped to it
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller
+ * @return point to request memory address
+ */
+void* sgl_mm_trace_malloc(size_t size, const char *owner)
+{
+    trace_head_t *head = sgl_malloc(size + sizeof(trace_head_t));
+
+    if (head == NULL) {
+        trace.failed_count ++;
+        return NULL;
+    }
+
+    head->size = (uint32_t)size;
+    head->owner = trace_owner_get(owner);
+    head->magic = TRACE_MAGIC;
+
+    trace.alloc_count ++;
+    trace_owner_count(head, true);
+
+    return head + 1;
+}
+
+
+/**
+ * @brief  traced memory realloc, sgl_realloc() is mapped to it
+ * @param  p  the pointer of request size of memory
+ * @param  size  request size of memory
+ * @param  owner  source file of the caller
+ * @note   the block keeps its first owner
+ */
+void* sgl_mm_trace_realloc(void *p, size_t size, const char *owner)
+{
+    trace_head_t *head;
+
+    if (p == NULL) {
+        return sgl_mm_trace_malloc(size, owner);
+    }
+
+    if (size == 0) {
+        sgl_mm_trace_free(p);
+        return NULL;
+    }
+
+    head = trace_head_get(p);
+    if (head == NULL) {
+        return NULL;
+    }
+
+    trace_owner_count(head, false);
+    head = sgl_realloc(head, size + sizeof(trace_head_t));
+    if (head == NULL) {
+        /* the old block is still in use */
+        trace_owner_count((trace_head_t*)p - 1, true);
+        trace.failed_count ++;
+        return NULL;
+    }
+
+    head->size = (uint32_t)size;
+    trace_owner_count(head, true);
+
+    return head + 1;
+}
+
+
+/**
+ * @brief  traced memory free, sgl_free() is mapped to it
+ * @param  p  the pointer of request size of memory
+ */
+void sgl_mm_trace_free(void *p)
+{
+    trace_head_t *head;
+
+    if (p == NULL) {
+        return;
+    }
+
+    head = trace_head_get(p);
+    if (head == NULL) {
+        return;
+    }
+
+    trace_owner_count(head, false);
+    trace.free_count ++;
+    head->magic = 0;
+    sgl_free(head);
+}
+
+
+static void trace_walk_free(size_t size, void *user)
+{
+    sgl_mm_trace_t *info = (sgl_mm_trace_t*)user;
+    int bin = 0;
+
+    while (bin < SGL_MM_TRACE_HIST_NUM - 1 && size >= ((size_t)16 << bin)) {
+        bin ++;
+    }
+
+    if (info->hist[bin] < UINT16_MAX) {
+        info->hist[bin] ++;
+    }
+
+    info->free_size += size;
+    info->largest_free = sgl_max(info->largest_free, size);
+    info->free_blocks ++;
+}
+
+
+/**
+ * @brief  get heap trace info, the free blocks are walked at this time
+ * @param  info  heap trace info
+ */
+void sgl_mm_trace_get(sgl_mm_trace_t *info)
+{
+    memset(info, 0, sizeof(sgl_mm_trace_t));
+
+    info->used_size = sgl_mm_get_monitor().used_size;
+    info->peak_size = trace.peak_size;
+    info->alloc_count = trace.alloc_count;
+    info->free_count = trace.free_count;
+    info->failed_count = trace.failed_count;
+
+    sgl_mm_walk_free(trace_walk_free, info);
+}
+
+
+/**
+ * @brief  get heap trace info of an owner
+ * @param  index  index of owner, from 0
+ * @param  owner  heap trace info of the owner
+ * @return 0 if success, -1 if there is no owner of the index
+ */
+int sgl_mm_trace_get_owner(int index, sgl_mm_trace_owner_t *owner)
+{
+    const char *name;
+
+    if (index < 0 || index >= trace.owner_num) {
+        return -1;
+    }
+
+    *owner = trace.owner[index];
+
+    /* only the file name, __FILE__ may have the full path */
+    for (name = owner->name; *name; name++) {
+        if (*name == '/' || *name == '\\') {
+            owner->name = name + 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief  print heap trace info in the compact format, host/tools/mm_decode.c decodes it
+ * @param  print  output function, it is called with one line at a time
+ * @note   the format is a line of "mm:v1" and numbers in hex:
+ *         total, used, peak, free, largest free, free blocks, allocs, frees, failed,
+ *         a line of "mm:h" and the histogram, then a line of "mm:o" for every owner:
+ *         name, count, bytes, peak, and a line of "mm:end"
+ */
+void sgl_mm_trace_dump(void (*print)(const char *str))
+{
+    sgl_mm_trace_owner_t owner;
+    sgl_mm_trace_t info;
+    char line[96];
+    int len;
+
+    sgl_mm_trace_get(&info);
+
+    sgl_snprintf(line, sizeof(line), "mm:v1 %x %x %x %x %x %x %x %x %x\n",
+                 (unsigned)sgl_mm_get_monitor().total_size, (unsigned)info.used_size, (unsigned)info.peak_size,
+                 (unsigned)info.free_size, (unsigned)info.largest_free, (unsigned)info.free_blocks,
+                 (unsigned)info.alloc_count, (unsigned)info.free_count, (unsigned)info.failed_count);
+    print(line);
+
+    len = sgl_snprintf(line, sizeof(line), "mm:h");
+    for (int i = 0; i < SGL_MM_TRACE_HIST_NUM; i++) {
+        len += sgl_snprintf(line + len, sizeof(line) - len, " %x", (unsigned)info.hist[i]);
+    }
+    sgl_snprintf(line + len, sizeof(line) - len, "\n");
+    print(line);
+
+    for (int i = 0; sgl_mm_trace_get_owner(i, &owner) == 0; i++) {
+        sgl_snprintf(line, sizeof(line), "mm:o %s %x %x %x\n", owner.name,
+                     (unsigned)owner.count, (unsigned)owner.bytes, (unsigned)owner.peak);
+        print(line);
+    }
+
+    print("mm:end\n");
+}
+
+#endif // !CONFIG_SGL_HEAP_TRACE
@@ -0,0 +1,476 @@
+/* source/mm/slab/sgl_mm.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: https://sgl-docs.readthedocs.io
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Slab heap: the first CONFIG_SGL_SLAB_ARENA_SIZE bytes of the pool are cut into pages of
+ * CONFIG_SGL_SLAB_PAGE_SIZE bytes, the rest of the pool and the added pools are managed by lwmem.
+ *
+ * Every request size up to half a page gets its own size class when it is seen first, the sizes
+ * are rounded to SLAB_ALIGN only, so every widget type has its own class and its own free lists.
+ * A class takes pages from the arena when it needs them and gives a page back as soon as the
+ * last object of the page is freed, then the page can be taken by any other class.
+ *
+ * The page of an object is found by its offset in the arena, so alloc and free are O(1) and
+ * the objects have no header. Big requests, and the ones that do not get a page or a class,
+ * go to lwmem.
+ */
+
+#define SGL_MM_BACKEND
+#include <stdint.h>
+#include <string.h>
+#include <sgl_mm.h>
+#include "../lwmem/lwmem.h"
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+
+
+#define  SLAB_ALIGN                 (sizeof(void*) > 8 ? sizeof(void*) : 8)
+#define  SLAB_PAGE_NUM              (CONFIG_SGL_SLAB_ARENA_SIZE / CONFIG_SGL_SLAB_PAGE_SIZE)
+#define  SLAB_OBJ_SIZE_MAX          (CONFIG_SGL_SLAB_PAGE_SIZE / 2)
+#define  SLAB_CLASS_NUM             (16)
+#define  SLAB_NONE                  (0xFF)
+
+#if (CONFIG_SGL_SLAB_PAGE_SIZE % 16)
+#error "CONFIG_SGL_SLAB_PAGE_SIZE must be a multiple of 16"
+#endif
+
+#if (SLAB_PAGE_NUM >= SLAB_NONE)
+#error "CONFIG_SGL_SLAB_ARENA_SIZE / CONFIG_SGL_SLAB_PAGE_SIZE must be less than 255"
+#endif
+
+#if (SLAB_PAGE_NUM > 0)
+
+/**
+ * @brief slab page descriptor
+ * @free: list of the freed objects of the page
+ * @carve: offset of the first object that has never been used
+ * @used: number of objects in use
+ * @cls: size class of the page, SLAB_NONE if the page is free
+ * @prev: previous page of the list, the partial list of the class or the free page list
+ * @next: next page of the list
+ */
+typedef struct slab_page {
+    void        *free;
+    uint16_t    carve;
+    uint8_t     used;
+    uint8_t     cls;
+    uint8_t     prev;
+    uint8_t     next;
+} slab_page_t;
+
+
+/**
+ * @brief slab size class
+ * @size: object size of the class
+ * @slots: number of objects in a page
+ * @partial: first page that has free objects
+ */
+typedef struct slab_class {
+    uint16_t    size;
+    uint8_t     slots;
+    uint8_t     partial;
+} slab_class_t;
+
+
+static struct {
+    uint8_t         *base;
+    size_t          size;
+    uint8_t         free_page;
+    uint8_t         cls_num;
+    uint8_t         cls_map[SLAB_OBJ_SIZE_MAX / 8 + 1];
+    slab_class_t    cls[SLAB_CLASS_NUM];
+    slab_page_t     page[SLAB_PAGE_NUM];
+} slab;
+
+#endif // !SLAB_PAGE_NUM
+
+
+static sgl_mm_monitor_t mem = {
+    .total_size = 0,
+    .free_size = 0,
+    .used_size = 0,
+};
+
+
+#if (SLAB_PAGE_NUM > 0)
+
+/**
+ * @brief  insert a page at the head of a page list
+ * @param  head  head of the list
+ * @param  pg  index of the page
+ */
+static inline void slab_page_link(uint8_t *head, uint8_t pg)
+{
+    slab.page[pg].prev = SLAB_NONE;
+    slab.page[pg].next = *head;
+    if (*head != SLAB_NONE) {
+        slab.page[*head].prev = pg;
+    }
+    *head = pg;
+}
+
+
+/**
+ * @brief  remove a page from a page list
+ * @param  head  head of the list
+ * @param  pg  index of the page
+ */
+static inline void slab_page_unlink(uint8_t *head, uint8_t pg)
+{
+    slab_page_t *page = &slab.page[pg];
+
+    if (page->prev != SLAB_NONE) {
+        slab.page[page->prev].next = page->next;
+    }
+    else {
+        *head = page->next;
+    }
+
+    if (page->next != SLAB_NONE) {
+        slab.page[page->next].prev = page->prev;
+    }
+}
+
+
+/**
+ * @brief  check if a pointer is an object of the slab arena
+ * @param  p  pointer
+ * @return true if p is in the arena
+ */
+static inline bool slab_owns(void *p)
+{
+    return (uint8_t*)p >= slab.base && (uint8_t*)p < slab.base + slab.size;
+}
+
+
+/**
+ * @brief  get the size class of a request size, a new class is made if it is the first time
+ * @param  size  request size, it is not 0 and not bigger than SLAB_OBJ_SIZE_MAX
+ * @return index of the class, SLAB_NONE if all classes are taken
+ */
+static inline uint8_t slab_class_get(size_t size)
+{
+    size_t align = (size + SLAB_ALIGN - 1) & ~(SLAB_ALIGN - 1);
+    uint8_t *map = &slab.cls_map[align / 8];
+
+    if (*map == SLAB_NONE && slab.cls_num < SLAB_CLASS_NUM) {
+        slab_class_t *cls = &slab.cls[slab.cls_num];
+
+        cls->size = (uint16_t)align;
+        cls->slots = (uint8_t)sgl_min(CONFIG_SGL_SLAB_PAGE_SIZE / align, 255);
+        cls->partial = SLAB_NONE;
+        *map = slab.cls_num ++;
+    }
+
+    return *map;
+}
+
+
+/**
+ * @brief  take an object from the slab arena
+ * @param  size  request size, it is not 0 and not bigger than SLAB_OBJ_SIZE_MAX
+ * @return pointer to the object, NULL if the class has no page and the arena has no free page
+ */
+static void* slab_alloc(size_t size)
+{
+    uint8_t c = slab_class_get(size);
+    slab_class_t *cls;
+    slab_page_t *page;
+    uint8_t pg;
+    void *obj;
+
+    if (c == SLAB_NONE) {
+        return NULL;
+    }
+
+    cls = &slab.cls[c];
+    pg = cls->partial;
+
+    if (pg == SLAB_NONE) {
+        pg = slab.free_page;
+        if (pg == SLAB_NONE) {
+            return NULL;
+        }
+
+        slab_page_unlink(&slab.free_page, pg);
+        page = &slab.page[pg];
+        page->free = NULL;
+        page->carve = 0;
+        page->used = 0;
+        page->cls = c;
+        slab_page_link(&cls->partial, pg);
+    }
+
+    page = &slab.page[pg];
+    if (page->free != NULL) {
+        obj = page->free;
+        page->free = *(void**)obj;
+    }
+    else {
+        obj = slab.base + pg * CONFIG_SGL_SLAB_PAGE_SIZE + page->carve;
+        page->carve += cls->size;
+    }
+
+    /* a full page is on no list, it is linked again when one of its objects is freed */
+    if (++ page->used == cls->slots) {
+        slab_page_unlink(&cls->partial, pg);
+    }
+
+    mem.used_size += cls->size;
+    mem.slab_used += cls->size;
+
+    return obj;
+}
+
+
+/**
+ * @brief  give an object back to its page
+ * @param  p  object of the slab arena
+ * @return none
+ */
+static void slab_free(void *p)
+{
+    uint8_t pg = (uint8_t)(((uint8_t*)p - slab.base) / CONFIG_SGL_SLAB_PAGE_SIZE);
+    slab_page_t *page = &slab.page[pg];
+    slab_class_t *cls = &slab.cls[page->cls];
+    bool full = (page->used == cls->slots);
+
+    *(void**)p = page->free;
+    page->free = p;
+    page->used --;
+
+    mem.used_size -= cls->size;
+    mem.slab_used -= cls->size;
+
+    if (page->used == 0) {
+        if (!full) {
+            slab_page_unlink(&cls->partial, pg);
+        }
+        page->cls = SLAB_NONE;
+        slab_page_link(&slab.free_page, pg);
+    }
+    else if (full) {
+        slab_page_link(&cls->partial, pg);
+    }
+}
+
+
+/**
+ * @brief  get the object size of a slab object
+ * @param  p  object of the slab arena
+ * @return size of its class
+ */
+static inline size_t slab_get_size(void *p)
+{
+    uint8_t pg = (uint8_t)(((uint8_t*)p - slab.base) / CONFIG_SGL_SLAB_PAGE_SIZE);
+
+    return slab.cls[slab.page[pg].cls].size;
+}
+
+#endif // !SLAB_PAGE_NUM
+
+
+/**
+ * @brief  initialize memory pool
+ * @param  mem_start  start address of memory pool
+ * @param  len  length of memory pool
+ * @note   the arena is cut from the head of the pool, it is smaller if the pool is not big enough
+ */
+void sgl_mm_init(void *mem_start, size_t len)
+{
+#if (SLAB_PAGE_NUM > 0)
+    uint8_t *start = (uint8_t*)(((uintptr_t)mem_start + SLAB_ALIGN - 1) & ~(uintptr_t)(SLAB_ALIGN - 1));
+    size_t pages = sgl_min((size_t)SLAB_PAGE_NUM, (len - (start - (uint8_t*)mem_start)) / 2 / CONFIG_SGL_SLAB_PAGE_SIZE);
+
+    memset(slab.cls_map, SLAB_NONE, sizeof(slab.cls_map));
+    slab.cls_num = 0;
+    slab.base = start;
+    slab.size = pages * CONFIG_SGL_SLAB_PAGE_SIZE;
+    slab.free_page = SLAB_NONE;
+
+    for (int i = (int)pages - 1; i >= 0; i--) {
+        slab.page[i].cls = SLAB_NONE;
+        slab_page_link(&slab.free_page, (uint8_t)i);
+    }
+
+    mem.slab_size = slab.size;
+    mem.total_size += slab.size;
+    len -= (start - (uint8_t*)mem_start) + slab.size;
+    mem_start = start + slab.size;
+#endif
+
+    sgl_mm_add_pool(mem_start, len);
+}
+
+
+/**
+ * @brief  add memory pool
+ * @param  mem_start  start address of memory pool
+ * @param  len  length of memory pool
+ * @note   the added pool is only used by lwmem
+ */
+void sgl_mm_add_pool(void *mem_start, size_t len)
+{
+    lwmem_region_t lwmem[] = {
+        {.start_addr = mem_start, .size = len,},
+        { NULL, 0 },
+    };
+
+    lwmem_assignmem(lwmem);
+    mem.total_size += len;
+}
+
+
+/**
+ * @brief  memory alloc, the function is unsafe, you should ensure that
+ *         the requested size is smaller than the free size of memory
+ *
+ * @param  size   request size of memory
+ *
+ * @return point to request memory address
+*/
+void* sgl_malloc(size_t size)
+{
+    void *ret;
+
+#if (SLAB_PAGE_NUM > 0)
+    if (size != 0 && size <= SLAB_OBJ_SIZE_MAX) {
+        ret = slab_alloc(size);
+        if (ret != NULL) {
+            return ret;
+        }
+        mem.slab_fallback ++;
+    }
+#endif
+
+    ret = lwmem_malloc(size);
+    if(ret == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        return NULL;
+    }
+
+    mem.used_size += lwmem_get_size(ret);
+
+    return ret;
+}
+
+
+/**
+ * @brief  memory realloc, the function is unsafe, you should ensure that
+ *         the requested size is smaller than the free size of memory
+ * @param  p      the pointer of request size of memory
+ * @param  size   request size of memory
+ */
+void* sgl_realloc(void *p, size_t size)
+{
+    size_t old;
+    void *ret;
+
+    if (p == NULL) {
+        return sgl_malloc(size);
+    }
+
+#if (SLAB_PAGE_NUM > 0)
+    if (slab_owns(p)) {
+        old = slab_get_size(p);
+        if (size != 0 && size <= old) {
+            return p;
+        }
+
+        ret = sgl_malloc(size);
+        if (ret != NULL) {
+            memcpy(ret, p, old);
+            slab_free(p);
+        }
+        return ret;
+    }
+#endif
+
+    old = lwmem_get_size(p);
+    ret = lwmem_realloc(p, size);
+    if(ret == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        return NULL;
+    }
+
+    mem.used_size += lwmem_get_size(ret) - old;
+
+    return ret;
+}
+
+
+/**
+ * @brief  memory free
+ *
+ * @param  p  the pointer of request size of memory
+ *
+ * @return none
+*/
+void sgl_free(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+#if (SLAB_PAGE_NUM > 0)
+    if (slab_owns(p)) {
+        slab_free(p);
+        return;
+    }
+#endif
+
+    mem.used_size -= lwmem_get_size(p);
+    lwmem_free(p);
+}
+
+
+sgl_mm_monitor_t sgl_mm_get_monitor(void)
+{
+    int integer = (mem.used_size * 100) / mem.total_size;
+    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
+    mem.used_rate = integer << 8 | decimal;
+    mem.free_size = mem.total_size - mem.used_size;
+
+    return mem;
+}
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+/**
+ * @brief  walk all free blocks of heap, every heap algorithm provides it
+ * @param  walker  called with the usable size of every free block
+ * @param  user  user data of walker
+ * @note   a free page of the slab arena is a free block of CONFIG_SGL_SLAB_PAGE_SIZE bytes
+ */
+void sgl_mm_walk_free(void (*walker)(size_t size, void *user), void *user)
+{
+#if (SLAB_PAGE_NUM > 0)
+    for (uint8_t pg = slab.free_page; pg != SLAB_NONE; pg = slab.page[pg].next) {
+        walker(CONFIG_SGL_SLAB_PAGE_SIZE, user);
+    }
+#endif
+
+    lwmem_walk_free(walker, user);
+}
+#endif
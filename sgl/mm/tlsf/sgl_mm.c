@@ -22,6 +22,7 @@
  * SOFTWARE.
  */
 
+#define SGL_MM_BACKEND
 #include "tlsf.h"
 #include <stdint.h>
 #include <sgl_mm.h>
@@ -77,7 +78,7 @@ void* sgl_malloc(size_t size)
         return NULL;
     }
 
-    mem.used_size += size;
+    mem.used_size += tlsf_block_size(ret);
     return ret;
 }
 
@@ -90,13 +91,14 @@ void* sgl_malloc(size_t size)
  */
 void* sgl_realloc(void *p, size_t size)
 {
+    size_t old = p ? tlsf_block_size(p) : 0;
     void *ret = tlsf_realloc(mem_tlsf, p, size);
     if(ret == NULL) {
         SGL_LOG_ERROR("out of memory");
         return NULL;
     }
 
-    mem.used_size += size;
+    mem.used_size += tlsf_block_size(ret) - old;
 
     return ret;
 }
@@ -126,3 +128,36 @@ sgl_mm_monitor_t sgl_mm_get_monitor(void)
 
     return mem;
 }
+
+
+#if (CONFIG_SGL_HEAP_TRACE)
+typedef struct tlsf_walk_ctx {
+    void (*walker)(size_t size, void *user);
+    void *user;
+} tlsf_walk_ctx_t;
+
+
+static void tlsf_walk_free(void *ptr, size_t size, int used, void *user)
+{
+    tlsf_walk_ctx_t *ctx = (tlsf_walk_ctx_t*)user;
+
+    SGL_UNUSED(ptr);
+    if (!used) {
+        ctx->walker(size, ctx->user);
+    }
+}
+
+
+/**
+ * @brief  walk all free blocks of heap, every heap algorithm provides it
+ * @param  walker  called with the usable size of every free block
+ * @param  user  user data of walker
+ * @note   only the first pool is walked
+ */
+void sgl_mm_walk_free(void (*walker)(size_t size, void *user), void *user)
+{
+    tlsf_walk_ctx_t ctx = { .walker = walker, .user = user };
+
+    tlsf_walk_pool(tlsf_get_pool(mem_tlsf), tlsf_walk_free, &ctx);
+}
+#endif
@@ -111,8 +111,8 @@ sgl_obj_t* sgl_2dball_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &ball->obj;
     sgl_obj_init(&ball->obj, parent);
-    obj->construct_fn = sgl_2dball_construct_cb;
-    obj->needinit = 1;
+    sgl_obj_set_construct_fn(obj, sgl_2dball_construct_cb);
+    sgl_obj_needinit(obj);
 
     ball->alpha = SGL_ALPHA_MAX;
     ball->color = SGL_THEME_COLOR;
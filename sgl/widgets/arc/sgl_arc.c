@@ -68,7 +68,7 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
             obj->event_fn(evt);
         }
     }
-    else if(SGL_EVENT_DRAW_INIT) {
+    else if(evt->type == SGL_EVENT_DRAW_INIT) {
         if(arc->desc.radius_out < 0) {
             arc->desc.radius_out = (obj->coords.x2 - obj->coords.x1) / 2;
         }
@@ -98,7 +98,7 @@ sgl_obj_t* sgl_arc_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &arc->obj;
     sgl_obj_init(&arc->obj, parent);
-    obj->needinit = 1;
+    sgl_obj_needinit(obj);
     obj->clickable = 1;
     obj->movable = 1;
 
@@ -113,7 +113,7 @@ sgl_obj_t* sgl_arc_create(sgl_obj_t* parent)
     arc->desc.cx = -1;
     arc->desc.cy = -1;
 
-    obj->construct_fn = sgl_arc_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_arc_construct_cb);
 
     return obj;
 }
@@ -109,7 +109,7 @@ sgl_obj_t* sgl_bar_create(sgl_obj_t* parent)
     sgl_obj_init(&bar->obj, parent);
     sgl_obj_set_clickable(obj);
     sgl_obj_set_movable(obj);
-    obj->construct_fn = sgl_bar_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_bar_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     bar->direct = SGL_DIRECT_HORIZONTAL;
@@ -117,6 +117,9 @@ static void sgl_box_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
             }
         }
     }
+    else if(evt->type == SGL_EVENT_DRAW_OPAQUE) {
+        *(bool*)evt->param = sgl_draw_rect_is_opaque(&box->bg);
+    }
     else if(evt->type == SGL_EVENT_MOVE_UP || evt->type == SGL_EVENT_MOVE_DOWN) {
         // Check if vertical scrolling is enabled
         if((box->scroll_mode & SGL_BOX_SCROLL_VERTICAL_ONLY) || (box->scroll_mode & SGL_BOX_SCROLL_BOTH)) {
@@ -216,7 +219,7 @@ sgl_obj_t* sgl_box_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &box->obj;
     sgl_obj_init(&box->obj, parent);
-    obj->construct_fn = sgl_box_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_box_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     obj->focus = 1;
 
@@ -61,9 +61,10 @@ static void sgl_button_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
         if(button->text) {
             SGL_ASSERT(button->font != NULL);
             fill_area = sgl_obj_get_fill_rect(obj);
-            align_pos = sgl_get_text_pos(&fill_area, button->font, button->text, 0, (sgl_align_type_t)button->align);
+            sgl_text_layout_update(&button->layout, button->text, button->font);
+            align_pos = sgl_text_layout_get_pos(&button->layout, &fill_area, 0, (sgl_align_type_t)button->align);
 
-            sgl_draw_string(surf, &obj->area, align_pos.x, align_pos.y, button->text, button->text_color, button->alpha, button->font);
+            sgl_draw_text_layout(surf, &obj->area, align_pos.x, align_pos.y, &button->layout, button->text_color, button->alpha);
         }
     }
     else if(evt->type == SGL_EVENT_PRESSED) {
@@ -78,6 +79,9 @@ static void sgl_button_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
         }
         sgl_obj_set_dirty(obj);
     }
+    else if(evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&button->layout);
+    }
 }
 
 
@@ -105,7 +109,7 @@ sgl_obj_t* sgl_button_create(sgl_obj_t* parent)
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     sgl_obj_set_radius(obj, SGL_THEME_RADIUS);
 
-    obj->construct_fn = sgl_button_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_button_construct_cb);
 
     button->alpha = SGL_THEME_ALPHA;
     button->color = SGL_THEME_COLOR;
@@ -51,6 +51,7 @@ typedef struct sgl_button {
     sgl_color_t             text_color;
     uint8_t                 alpha;
     uint8_t                 align;
+    sgl_text_layout_t       layout;
 }sgl_button_t;
 
 
@@ -61,7 +61,7 @@ sgl_obj_t* sgl_canvas_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &canvas->obj;
     sgl_obj_init(&canvas->obj, parent);
-    obj->construct_fn = sgl_canvas_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_canvas_construct_cb);
 
     return obj;
 }
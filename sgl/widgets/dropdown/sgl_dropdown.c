@@ -101,7 +101,8 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
         if (option != NULL) {
             pos_x = text_area.x1 + dropdown->body_desc.radius;
             pos_y = obj->coords.y1 + (icon_h - dropdown->font->font_height) / 2;
-            sgl_draw_string(surf, &text_area, pos_x, pos_y, option->text, dropdown->text_color, dropdown->body_desc.alpha, dropdown->font);
+            sgl_text_layout_update(&option->layout, option->text, dropdown->font);
+            sgl_draw_text_layout(surf, &text_area, pos_x, pos_y, &option->layout, dropdown->text_color, dropdown->body_desc.alpha);
         }
 
         if (dropdown->is_open) {
@@ -113,7 +114,8 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
 
             for (int i = 0; option != NULL; i++) {
                 pos_x = text_area.x1 + dropdown->body_desc.radius;
-                sgl_draw_string(surf, &obj->area, pos_x, pos_y, option->text, dropdown->text_color, dropdown->body_desc.alpha, dropdown->font);
+                sgl_text_layout_update(&option->layout, option->text, dropdown->font);
+                sgl_draw_text_layout(surf, &obj->area, pos_x, pos_y, &option->layout, dropdown->text_color, dropdown->body_desc.alpha);
                 option = option->next;
                 pos_y += dropdown->font->font_height;
             }
@@ -147,6 +149,14 @@ static void sgl_dropdown_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     else if (evt->type == SGL_EVENT_DRAW_INIT) {
         dropdown->option_h = obj->coords.y2 - obj->coords.y1;
     }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        while (option != NULL) {
+            dropdown->head = option->next;
+            sgl_text_layout_free(&option->layout);
+            sgl_free(option);
+            option = dropdown->head;
+        }
+    }
 }
 
 
@@ -168,8 +178,8 @@ sgl_obj_t* sgl_dropdown_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &dropdown->obj;
     sgl_obj_init(&dropdown->obj, parent);
-    obj->construct_fn = sgl_dropdown_construct_cb;
-    obj->needinit = 1;
+    sgl_obj_set_construct_fn(obj, sgl_dropdown_construct_cb);
+    sgl_obj_needinit(obj);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     sgl_obj_set_clickable(obj);
@@ -227,6 +237,8 @@ void sgl_dropdown_add_option(sgl_obj_t *obj, const char *text)
         return;
     }
 
+    memset(add, 0, sizeof(sgl_dropdown_option_t));
+
     if (tail == NULL) {
         dropdown->head = add;
     }
@@ -292,6 +304,7 @@ void sgl_dropdown_delete_option_by_text(sgl_obj_t *obj, const char *text)
         prev->next = curr->next;
     }
 
+    sgl_text_layout_free(&curr->layout);
     sgl_free(curr);
     dropdown->option_num--;
     sgl_obj_set_dirty(obj);
@@ -324,6 +337,7 @@ void sgl_dropdown_delete_option_by_index(sgl_obj_t *obj, int index)
         prev->next = curr->next;
     }
 
+    sgl_text_layout_free(&curr->layout);
     sgl_free(curr);
     dropdown->option_num--;
 }
@@ -37,6 +37,7 @@
 typedef struct sgl_dropdown_option {
     struct sgl_dropdown_option *next;
     const char *text;
+    sgl_text_layout_t layout;
 } sgl_dropdown_option_t;
 
 
@@ -141,7 +141,11 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
 
             uint8_t *pixmap_buf = (uint8_t*)pixmap->bitmap.array;
             if(ext_img->read != NULL){
-                pixmap_buf = (uint8_t*)sgl_malloc(pix_byte * (clip.x2 - clip.x1 + 1));
+                pixmap_buf = (uint8_t*)sgl_scratch_alloc(pix_byte * (clip.x2 - clip.x1 + 1));
+                if (pixmap_buf == NULL) {
+                    SGL_LOG_ERROR("sgl_ext_img_construct_cb: alloc row buffer failed");
+                    return;
+                }
             }
 
             for (int y = clip.y1; y <= clip.y2; y++) {
@@ -190,7 +194,7 @@ static void sgl_ext_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
                 buf += surf->w;
             }
             if(ext_img->read != NULL) {
-                sgl_free(pixmap_buf);
+                sgl_scratch_free(pixmap_buf);
             }
         }
         else {
@@ -238,7 +242,7 @@ sgl_obj_t* sgl_ext_img_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &ext_img->obj;
     sgl_obj_init(&ext_img->obj, parent);
-    obj->construct_fn = sgl_ext_img_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_ext_img_construct_cb);
 
     ext_img->alpha = SGL_ALPHA_MAX;
     ext_img->pixmap_idx = 0;
@@ -70,7 +70,7 @@ sgl_obj_t* sgl_icon_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &icon->obj;
     sgl_obj_init(&icon->obj, parent);
-    obj->construct_fn = sgl_icon_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_icon_construct_cb);
 
     icon->alpha = SGL_THEME_ALPHA;
     icon->icon = NULL;
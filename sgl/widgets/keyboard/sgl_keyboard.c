@@ -520,11 +520,11 @@ sgl_obj_t* sgl_keyboard_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &keyboard->obj;
     sgl_obj_init(&keyboard->obj, parent);
-    obj->construct_fn = sgl_keyboard_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_keyboard_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     obj->clickable = 1;
-    obj->needinit  = 1;
+    sgl_obj_needinit(obj);
 
     keyboard->body_desc.alpha = SGL_THEME_ALPHA;
     keyboard->body_desc.color = SGL_THEME_COLOR;
@@ -52,14 +52,15 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             sgl_draw_fill_rect(surf, &obj->area, &obj->coords, obj->radius, label->bg_color, label->alpha);
         }
 
-        align_pos = sgl_get_text_pos(&obj->coords, label->font, label->text, 0, (sgl_align_type_t)label->align);
+        sgl_text_layout_update(&label->layout, label->text, label->font);
+        align_pos = sgl_text_layout_get_pos(&label->layout, &obj->coords, 0, (sgl_align_type_t)label->align);
 
 #if (CONFIG_SGL_LABEL_ROTATION)
         if (label->rota == 0) {
 #endif 
-            sgl_draw_string(surf, &obj->area, align_pos.x + label->transform.offset.offset_x, 
-                                              align_pos.y + label->transform.offset.offset_y, 
-                                              label->text, label->color, label->alpha, label->font);
+            sgl_draw_text_layout(surf, &obj->area, align_pos.x + label->transform.offset.offset_x, 
+                                                   align_pos.y + label->transform.offset.offset_y, 
+                                                   &label->layout, label->color, label->alpha);
 #if (CONFIG_SGL_LABEL_ROTATION)
         }
         else {
@@ -67,7 +68,7 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             const int16_t height = obj->area.y2 - obj->area.y1 + 1;
             const uint32_t buf_size = width * height;
 
-            sgl_color_t *temp_buf = sgl_malloc(buf_size * sizeof(sgl_color_t));
+            sgl_color_t *temp_buf = sgl_scratch_alloc(buf_size * sizeof(sgl_color_t));
             if (temp_buf == NULL) {
                 SGL_LOG_ERROR("sgl_label_construct_cb: malloc rotation temp buffer failed");
                 return;
@@ -88,14 +89,17 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
                 .dirty = NULL
             };
 
-            sgl_draw_string(&temp_surf, &obj->area, align_pos.x, align_pos.y, 
-                                              label->text, label->color, label->alpha, label->font);
+            sgl_draw_text_layout(&temp_surf, &obj->area, align_pos.x, align_pos.y, 
+                                                   &label->layout, label->color, label->alpha);
             sgl_draw_xform_surf(surf, &temp_surf, &obj->area, obj->coords.x1, obj->coords.y1, label->transform.rotation);
 
-            sgl_free(temp_buf);
+            sgl_scratch_free(temp_buf);
         }
 #endif
     }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&label->layout);
+    }
 }
 
 
@@ -117,7 +121,7 @@ sgl_obj_t* sgl_label_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &label->obj;
     sgl_obj_init(&label->obj, parent);
-    obj->construct_fn = sgl_label_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_label_construct_cb);
 
     label->alpha = SGL_ALPHA_MAX;
     label->bg_flag = 0;
@@ -56,6 +56,7 @@ typedef struct sgl_label {
         } offset;
         int16_t rotation;
     } transform;
+    sgl_text_layout_t layout;
 }sgl_label_t;
 
 
@@ -122,9 +122,9 @@ sgl_obj_t* sgl_led_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &led->obj;
     sgl_obj_init(&led->obj, parent);
-    obj->construct_fn = sgl_led_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_led_construct_cb);
 
-    obj->needinit = 1;
+    sgl_obj_needinit(obj);
 
     led->alpha = SGL_ALPHA_MAX;
     led->on_color = SGL_THEME_COLOR;
@@ -54,7 +54,7 @@ static void sgl_line_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             sgl_swap(&desc.y1, &desc.y2);
         }
 
-        sgl_draw_line(surf, &obj->parent->area, &desc);
+        sgl_draw_line(surf, &sgl_obj_from_link(obj->parent)->area, &desc);
     }
 }
 
@@ -77,7 +77,7 @@ sgl_obj_t* sgl_line_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &line->obj;
     sgl_obj_init(&line->obj, parent);
-    obj->construct_fn = sgl_line_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_line_construct_cb);
 
     line->color = SGL_THEME_BG_COLOR;
     line->alpha = SGL_ALPHA_MAX;
@@ -100,10 +100,10 @@ void sgl_line_set_pos(sgl_obj_t *obj, int16_t x1, int16_t y1, int16_t x2, int16_
     int16_t _x1, _y1, _x2, _y2;
 	sgl_line_t *line = sgl_container_of(obj, sgl_line_t, obj);
 
-    _x1 = obj->parent->coords.x1 + x1;
-    _x2 = obj->parent->coords.x1 + x2;
-    _y1 = obj->parent->coords.y1 + y1;
-    _y2 = obj->parent->coords.y1 + y2;
+    _x1 = sgl_obj_from_link(obj->parent)->coords.x1 + x1;
+    _x2 = sgl_obj_from_link(obj->parent)->coords.x1 + x2;
+    _y1 = sgl_obj_from_link(obj->parent)->coords.y1 + y1;
+    _y2 = sgl_obj_from_link(obj->parent)->coords.y1 + y2;
 
 	if (_x1 > _x2) {
 		sgl_swap(&_x1, &_x2);
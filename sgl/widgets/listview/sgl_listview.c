@@ -142,7 +142,7 @@ static void sgl_listview_event_cb(sgl_event_t *event)
 
     if(event->type == SGL_EVENT_RELEASED) {
         //int diff = item_height + listview->coords_offset;
-        child = parent->child;
+        child = sgl_obj_from_link(parent->child);
         if(listview->coords_offset > 0) {
             sgl_obj_for_each_child(child, parent) {
                 child->coords.y1 -= listview->coords_offset;
@@ -185,7 +185,8 @@ static void sgl_listview_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
 
     }
 
-    if(obj->event_fn) {
+    /* the opacity query and the destroy event are not for the user */
+    if(obj->event_fn && evt->type != SGL_EVENT_DRAW_OPAQUE && evt->type != SGL_EVENT_DESTROYED) {
         obj->event_fn(evt);
     }
 }
@@ -209,7 +210,7 @@ sgl_obj_t* sgl_listview_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &listview->obj;
     sgl_obj_init(&listview->obj, parent);
-    obj->construct_fn = sgl_listview_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_listview_construct_cb);
 #if CONFIG_SGL_USE_STYLE_UNIFIED_API
     obj->set_style = sgl_listview_set_style;
     obj->get_style = sgl_listview_get_style;
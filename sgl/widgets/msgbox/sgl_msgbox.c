@@ -122,6 +122,9 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
             msgbox->rbtn_color = tmp_color;
         }
     }
+    else if(evt->type == SGL_EVENT_DRAW_OPAQUE) {
+        *(bool*)evt->param = sgl_draw_rect_is_opaque(&msgbox->body_desc);
+    }
     else if(evt->type == SGL_EVENT_PRESSED) {
         if(evt->pos.y > (obj->coords.y2 - font_height - 2) && evt->pos.x < ((obj->coords.x1 + obj->coords.x2) / 2)) {
             msgbox->status |= SGL_MSGBOX_STATUS_LEFT;
@@ -198,7 +201,7 @@ sgl_obj_t* sgl_msgbox_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &msgbox->obj;
     sgl_obj_init(&msgbox->obj, parent);
-    obj->construct_fn = sgl_msgbox_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_msgbox_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     msgbox->body_desc.alpha = SGL_THEME_ALPHA;
@@ -249,11 +249,11 @@ sgl_obj_t* sgl_numberkbd_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &numberkbd->obj;
     sgl_obj_init(&numberkbd->obj, parent);
-    obj->construct_fn = sgl_numberkbd_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_numberkbd_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     obj->clickable = 1;
-    obj->needinit  = 1;
+    sgl_obj_needinit(obj);
 
     numberkbd->body_desc.alpha = SGL_THEME_ALPHA;
     numberkbd->body_desc.color = SGL_THEME_COLOR;
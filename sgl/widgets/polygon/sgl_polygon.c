@@ -53,10 +53,10 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
 
         // Adjust coordinates relative to parent object
         sgl_area_t polygon_area = {
-            .x1 = min_x + obj->parent->coords.x1,  // Adjust to parent coordinates
-            .x2 = max_x + obj->parent->coords.x1,
-            .y1 = min_y + obj->parent->coords.y1,
-            .y2 = max_y + obj->parent->coords.y1
+            .x1 = min_x + sgl_obj_from_link(obj->parent)->coords.x1,  // Adjust to parent coordinates
+            .x2 = max_x + sgl_obj_from_link(obj->parent)->coords.x1,
+            .y1 = min_y + sgl_obj_from_link(obj->parent)->coords.y1,
+            .y2 = max_y + sgl_obj_from_link(obj->parent)->coords.y1
         };
         
         sgl_area_t clip;
@@ -70,10 +70,10 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
                 // Calculate intersections of scan line with polygon
                 for (uint16_t i = 0; i < polygon->vertex_count; i++) {
                     // Adjust vertex coordinates relative to parent
-                    sgl_pos_t p1 = {polygon->vertices[i].x + obj->parent->coords.x1, 
-                                    polygon->vertices[i].y + obj->parent->coords.y1};
-                    sgl_pos_t p2 = {polygon->vertices[(i + 1) % polygon->vertex_count].x + obj->parent->coords.x1, 
-                                    polygon->vertices[(i + 1) % polygon->vertex_count].y + obj->parent->coords.y1};
+                    sgl_pos_t p1 = {polygon->vertices[i].x + sgl_obj_from_link(obj->parent)->coords.x1, 
+                                    polygon->vertices[i].y + sgl_obj_from_link(obj->parent)->coords.y1};
+                    sgl_pos_t p2 = {polygon->vertices[(i + 1) % polygon->vertex_count].x + sgl_obj_from_link(obj->parent)->coords.x1, 
+                                    polygon->vertices[(i + 1) % polygon->vertex_count].y + sgl_obj_from_link(obj->parent)->coords.y1};
                     
                     // Calculate intersection of scan line with edge
                     if ((p1.y > y) != (p2.y > y)) {
@@ -118,17 +118,17 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         }
     }
     
-    // Draw border
+    // Draw border, the edges are one closed polyline so the corners are blended once
     if (polygon->border_width > 0 && polygon->border_color.full != 0) {
-        for (uint16_t i = 0; i < polygon->vertex_count; i++) {
-            // Adjust vertex coordinates relative to parent
-            sgl_pos_t start = {polygon->vertices[i].x + obj->parent->coords.x1, 
-                               polygon->vertices[i].y + obj->parent->coords.y1};
-            sgl_pos_t end = {polygon->vertices[(i + 1) % polygon->vertex_count].x + obj->parent->coords.x1, 
-                             polygon->vertices[(i + 1) % polygon->vertex_count].y + obj->parent->coords.y1};
+        sgl_draw_polyline_t border = {
+            .color = polygon->border_color,
+            .alpha = polygon->alpha,
+            .width = polygon->border_width,
+            .closed = 1,
+        };
 
-            draw_line_fill_slanted(surf, &obj->area, start.x, start.y, end.x, end.y, polygon->border_width, polygon->border_color, polygon->alpha);
-        }
+        sgl_draw_polyline(surf, &obj->area, sgl_obj_from_link(obj->parent)->coords.x1, sgl_obj_from_link(obj->parent)->coords.y1,
+                          polygon->vertices, polygon->vertex_count, &border);
     }
 
     // Draw text
@@ -136,8 +136,8 @@ static void sgl_polygon_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         // Calculate center point of polygon
         int32_t center_x = 0, center_y = 0;
         for (uint16_t i = 0; i < polygon->vertex_count; i++) {
-            center_x += polygon->vertices[i].x + obj->parent->coords.x1;  // Adjust to parent coordinates
-            center_y += polygon->vertices[i].y + obj->parent->coords.y1;
+            center_x += polygon->vertices[i].x + sgl_obj_from_link(obj->parent)->coords.x1;  // Adjust to parent coordinates
+            center_y += polygon->vertices[i].y + sgl_obj_from_link(obj->parent)->coords.y1;
         }
         center_x /= polygon->vertex_count;
         center_y /= polygon->vertex_count;
@@ -165,7 +165,7 @@ sgl_obj_t* sgl_polygon_create(sgl_obj_t* parent)
     
     sgl_obj_t *obj = &polygon->obj;
     sgl_obj_init(obj, parent);
-    obj->construct_fn = sgl_polygon_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_polygon_construct_cb);
     
     // Set default values
     polygon->vertex_count = 0;
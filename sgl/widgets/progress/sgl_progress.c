@@ -83,7 +83,7 @@ sgl_obj_t* sgl_progress_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &progress->obj;
     sgl_obj_init(&progress->obj, parent);
-    obj->construct_fn = sgl_progress_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_progress_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     progress->body.alpha = SGL_THEME_ALPHA;
@@ -56,6 +56,9 @@ static void sgl_rectangle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
 
         sgl_draw_rect(surf, &obj->area, &obj->coords, &desc);
     }
+    else if(evt->type == SGL_EVENT_DRAW_OPAQUE) {
+        *(bool*)evt->param = sgl_draw_rect_is_opaque(&desc);
+    }
     else if(evt->type == SGL_EVENT_PRESSED) {
         if(sgl_obj_is_flexible(obj)) {
             sgl_obj_size_zoom(obj, 2);
@@ -92,7 +95,7 @@ sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
     sgl_obj_set_unflexible(obj);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
-    obj->construct_fn = sgl_rectangle_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_rectangle_construct_cb);
 
     rect->alpha = SGL_THEME_ALPHA;
     rect->color = SGL_THEME_COLOR;
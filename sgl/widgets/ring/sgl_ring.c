@@ -73,9 +73,9 @@ sgl_obj_t* sgl_ring_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &ring->obj;
     sgl_obj_init(&ring->obj, parent);
-    obj->construct_fn = sgl_ring_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_ring_construct_cb);
 
-    obj->needinit = 1;
+    sgl_obj_needinit(obj);
     ring->radius_in = -1;
     ring->radius_out = -1;
     ring->alpha = SGL_THEME_ALPHA;
@@ -28,159 +28,273 @@
 #include "sgl_scope.h"
 
 
-// Draw a dashed line using Bresenham's algorithm with dash pattern
-static void draw_dashed_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t gap, sgl_color_t color)
+// Draw a dashed grid line, the dash pattern is gap pixels on and gap + 1 pixels off from its start
+static void scope_dashed_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t gap, sgl_color_t color)
 {
-    int16_t dx = sgl_abs(x1 - x0);
-    int16_t dy = sgl_abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
-    int16_t e2;
-    int16_t dash_len = 0;
-
-    sgl_area_t clip_area = {
-        .x1 = surf->x1,
-        .y1 = surf->y1,
-        .x2 = surf->x2,
-        .y2 = surf->y2
+    sgl_pos_t points[2] = { { x1, y1 }, { x2, y2 } };
+    sgl_draw_polyline_t line = {
+        .color = color,
+        .alpha = SGL_ALPHA_MAX,
+        .width = 1,
+        .dash_on = gap,
+        .dash_off = gap + 1,
     };
 
-    sgl_area_selfclip(&clip_area, area);
+    sgl_draw_polyline(surf, area, 0, 0, points, 2, &line);
+}
 
-    while (1) {
-        // Draw dash segment
-        if (dash_len < gap) {
-            // Check if point is within clipping area
-            if (x0 >= clip_area.x1 && x0 <= clip_area.x2 && y0 >= clip_area.y1 && y0 <= clip_area.y2) {
-                sgl_color_t *buf = sgl_surf_get_buf(surf, x0 - surf->x1, y0 - surf->y1);
-                *buf = color;
-            }
-            dash_len++;
-        } else if (dash_len < 2 * gap) {
-            // Skip drawing (gap segment)
-            dash_len++;
-        } else {
-            // Reset dash counter
-            dash_len = 0;
-        }
-        
-        if (x0 == x1 && y0 == y1) break;
-        e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
-        }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+
+// Draw a line segment of waveform, it is used when there is no column buffer
+static void scope_draw_segment(sgl_surf_t *surf, sgl_area_t *area, sgl_pos_t start, sgl_pos_t end, sgl_color_t color, uint8_t width)
+{
+    sgl_pos_t points[2] = { start, end };
+    sgl_draw_polyline_t line = {
+        .color = color,
+        .alpha = SGL_ALPHA_MAX,
+        .width = width,
+    };
+
+    sgl_draw_polyline(surf, area, 0, 0, points, 2, &line);
+}
+
+// Update min/max of one block of data buffer, only the data that has been appended is counted
+static void scope_minmax_block_update(sgl_scope_t *scope, uint32_t block)
+{
+    uint32_t count = sgl_min(scope->display_count, scope->data_len);
+    uint32_t start = block * scope->block_size;
+    uint32_t end = sgl_min(start + scope->block_size, count);
+    int16_t min = INT16_MAX, max = INT16_MIN;
+
+    for (uint32_t i = start; i < end; i++) {
+        min = sgl_min(min, scope->data_buffer[i]);
+        max = sgl_max(max, scope->data_buffer[i]);
+    }
+
+    scope->block_min[block] = min;
+    scope->block_max[block] = max;
+}
+
+
+// Get min/max of data buffer, the buffer is split into blocks so that appending a data only
+// rescans one block, and the result is merged from SGL_SCOPE_MINMAX_BLOCK_NUM blocks
+static bool scope_get_minmax(sgl_scope_t *scope, int16_t *min, int16_t *max)
+{
+    if (scope->display_count == 0 || scope->data_len == 0) {
+        return false;
+    }
+
+    if (!scope->minmax_valid) {
+        scope->block_size = (scope->data_len + SGL_SCOPE_MINMAX_BLOCK_NUM - 1) / SGL_SCOPE_MINMAX_BLOCK_NUM;
+        for (uint32_t i = 0; i < SGL_SCOPE_MINMAX_BLOCK_NUM; i++) {
+            scope_minmax_block_update(scope, i);
         }
+        scope->minmax_valid = 1;
     }
+
+    *min = INT16_MAX;
+    *max = INT16_MIN;
+    for (uint32_t i = 0; i < SGL_SCOPE_MINMAX_BLOCK_NUM; i++) {
+        *min = sgl_min(*min, scope->block_min[i]);
+        *max = sgl_max(*max, scope->block_max[i]);
+    }
+
+    return true;
 }
 
 
-// Custom line drawing function supporting variable line width
-static void custom_draw_line(sgl_surf_t *surf, sgl_area_t *area, sgl_pos_t start, sgl_pos_t end, sgl_color_t color, int16_t width)
+// Get the y coordinate of a value
+static inline int16_t scope_value_y(sgl_scope_t *scope, int16_t value, int16_t display_min, int16_t display_max)
 {
-    int16_t x0 = start.x;
-    int16_t y0 = start.y;
-    int16_t x1 = end.x;
-    int16_t y1 = end.y;
-    
-    // Handle invalid line width (zero or negative)
-    if (width <= 0) return;
-    
-    // For line width = 1, use standard Bresenham algorithm
-    if (width == 1) {
-        int16_t dx = sgl_abs(x1 - x0);
-        int16_t dy = sgl_abs(y1 - y0);
-        int16_t sx = (x0 < x1) ? 1 : -1;
-        int16_t sy = (y0 < y1) ? 1 : -1;
-        int16_t err = dx - dy;
-        int16_t e2;
-        
-        sgl_area_t clip_area = {
-            .x1 = surf->x1,
-            .y1 = surf->y1,
-            .x2 = surf->x2,
-            .y2 = surf->y2
-        };
-        
-        while (1) {
-            // Check if point is within clipping area
-            if (x0 >= clip_area.x1 && x0 <= clip_area.x2 && y0 >= clip_area.y1 && y0 <= clip_area.y2) {
-                sgl_color_t *buf = sgl_surf_get_buf(surf, x0 - surf->x1, y0 - surf->y1);
-                *buf = color;
+    int16_t height = scope->obj.coords.y2 - scope->obj.coords.y1;
+
+    value = sgl_clamp(value, display_min, display_max);
+    return scope->obj.coords.y2 - ((int32_t)(value - display_min) * height) / (display_max - display_min);
+}
+
+
+// Get the x coordinate of a data slot in sweep mode
+static inline int16_t scope_sweep_x(sgl_scope_t *scope, uint32_t index)
+{
+    int16_t width = scope->obj.coords.x2 - scope->obj.coords.x1;
+    return scope->obj.coords.x1 + (int32_t)(index * width / (scope->data_len - 1));
+}
+
+
+static inline int32_t scope_div_round(int32_t n, int32_t d)
+{
+    return n >= 0 ? (n + d / 2) / d : -((-n + d / 2) / d);
+}
+
+
+static inline void scope_column_add(sgl_scope_t *scope, int16_t x, int16_t y)
+{
+    int16_t *span = &scope->column[2 * (x - scope->obj.coords.x1)];
+
+    span[0] = sgl_min(span[0], y);
+    span[1] = sgl_max(span[1], y);
+}
+
+
+// Add a line segment into the column spans, a column covers the line from half a pixel on the
+// left to half a pixel on the right, so the spans of a steep line are connected
+static void scope_column_segment(sgl_scope_t *scope, sgl_pos_t a, sgl_pos_t b)
+{
+    int32_t den, dy, t;
+
+    if (a.x > b.x) {
+        sgl_pos_t tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    if (a.x == b.x) {
+        scope_column_add(scope, a.x, a.y);
+        scope_column_add(scope, a.x, b.y);
+        return;
+    }
+
+    den = 2 * (b.x - a.x);
+    dy = b.y - a.y;
+
+    for (int16_t x = a.x; x <= b.x; x++) {
+        t = 2 * (x - a.x);
+        scope_column_add(scope, x, a.y + scope_div_round(dy * sgl_max(t - 1, 0), den));
+        scope_column_add(scope, x, a.y + scope_div_round(dy * sgl_min(t + 1, den), den));
+    }
+}
+
+
+// Walk all line segments of waveform, they are added into the column spans if there is a
+// column buffer, otherwise they are drawn one by one
+static void scope_waveform_walk(sgl_scope_t *scope, sgl_surf_t *surf, int16_t display_min, int16_t display_max)
+{
+    sgl_obj_t *obj = &scope->obj;
+    int16_t width = obj->coords.x2 - obj->coords.x1;
+    uint32_t newest = (scope->current_index == 0) ? scope->data_len - 1 : scope->current_index - 1;
+    sgl_pos_t start, end;
+
+    if (scope->sweep) {
+        uint32_t count = sgl_min(scope->display_count, scope->data_len);
+
+        if (scope->data_len < 2) {
+            return;
+        }
+
+        // the segment from the newest data to the oldest one is the gap of sweep cursor
+        for (uint32_t i = 0; i + 1 < count; i++) {
+            if (i == newest) {
+                continue;
             }
-            
-            if (x0 == x1 && y0 == y1) break;
-            e2 = 2 * err;
-            if (e2 > -dy) {
-                err -= dy;
-                x0 += sx;
+
+            start.x = scope_sweep_x(scope, i);
+            start.y = scope_value_y(scope, scope->data_buffer[i], display_min, display_max);
+            end.x = scope_sweep_x(scope, i + 1);
+            end.y = scope_value_y(scope, scope->data_buffer[i + 1], display_min, display_max);
+
+            if (scope->column) {
+                scope_column_segment(scope, start, end);
             }
-            if (e2 < dx) {
-                err += dx;
-                y0 += sy;
+            else {
+                scope_draw_segment(surf, &obj->area, start, end, scope->waveform_color, scope->line_width);
             }
         }
         return;
     }
-    
-    // For line width > 1, draw main line plus perpendicular offsets to simulate thickness
-    int16_t dx = sgl_abs(x1 - x0);
-    int16_t dy = sgl_abs(y1 - y0);
-    int16_t sx = (x0 < x1) ? 1 : -1;
-    int16_t sy = (y0 < y1) ? 1 : -1;
-    int16_t err = dx - dy;
-    int16_t e2;
-    
-    sgl_area_t clip_area = {
-        .x1 = surf->x1,
-        .y1 = surf->y1,
-        .x2 = surf->x2,
-        .y2 = surf->y2
-    };
 
-    sgl_area_selfclip(&clip_area, area);
-    
-    // Compute half-width for symmetric thickening
-    int16_t half_width = width / 2;
-    
-    while (1) {
-        // Draw current pixel and its perpendicular neighbors to form line thickness
-        for (int16_t w = -half_width; w <= half_width; w++) {
-            int16_t px, py;
-            
-            // Determine offset direction based on dominant axis
-            if (dx > dy) {  // Dominant X-axis direction
-                px = x0;
-                py = y0 + w;
-            } else {  // Dominant Y-axis direction
-                px = x0 + w;
-                py = y0;
-            }
-            
-            // Check if point is within clipping area
-            if (px >= clip_area.x1 && px <= clip_area.x2 && py >= clip_area.y1 && py <= clip_area.y2) {
-                sgl_color_t *buf = sgl_surf_get_buf(surf, px - surf->x1, py - surf->y1);
-                *buf = color;
-            }
+    // Determine number of points to display
+    uint32_t display_points = scope->max_display_points > 0 ? scope->max_display_points : scope->data_len;
+    if (display_points > scope->data_len) display_points = scope->data_len;
+
+    // Number of actual data points to render
+    uint32_t data_points = scope->display_count < display_points ? scope->display_count : display_points;
+
+    start.x = obj->coords.x2;  // Rightmost X position, it is the most recent data point
+    start.y = scope_value_y(scope, scope->data_buffer[newest], display_min, display_max);
+
+    // Draw waveform from right to left
+    for (uint32_t i = 1; i < data_points; i++) {
+        uint32_t prev_index = (scope->current_index >= i + 1) ? scope->current_index - (i + 1) : scope->data_len - (i + 1 - scope->current_index);
+
+        end.x = obj->coords.x2 - (i * width / (data_points - 1));  // Move leftward
+        end.y = scope_value_y(scope, scope->data_buffer[prev_index], display_min, display_max);
+
+        if (scope->column) {
+            scope_column_segment(scope, start, end);
+        }
+        else {
+            scope_draw_segment(surf, &obj->area, start, end, scope->waveform_color, scope->line_width);
+        }
+
+        start = end;
+    }
+}
+
+
+// Build the column spans of waveform, it is done once per frame and shared by all slices
+static void scope_column_build(sgl_scope_t *scope, int16_t display_min, int16_t display_max)
+{
+    int16_t column_num = scope->obj.coords.x2 - scope->obj.coords.x1 + 1;
+
+    if (scope->column_num != column_num) {
+        sgl_free(scope->column);
+        scope->column_num = 0;
+        scope->column = sgl_malloc(column_num * 2 * sizeof(int16_t));
+        if (scope->column == NULL) {
+            SGL_LOG_WARN("scope_column_build: malloc failed, draw waveform line by line");
+            return;
+        }
+        scope->column_num = column_num;
+    }
+
+    for (int16_t i = 0; i < column_num; i++) {
+        scope->column[2 * i] = INT16_MAX;
+        scope->column[2 * i + 1] = INT16_MIN;
+    }
+
+    scope_waveform_walk(scope, NULL, display_min, display_max);
+    scope->column_frame = sgl_fbdev_get_frame();
+}
+
+
+// Draw the column spans of waveform in the slice, a line wider than 1 pixel is a square brush
+static void scope_column_draw(sgl_scope_t *scope, sgl_surf_t *surf)
+{
+    sgl_obj_t *obj = &scope->obj;
+    int16_t half_width = scope->line_width / 2;
+    int16_t lo, hi, c1, c2;
+    sgl_area_t clip_area;
+    sgl_color_t *buf;
+
+    if (!sgl_surf_clip(surf, &obj->area, &clip_area)) {
+        return;
+    }
+
+    for (int16_t x = clip_area.x1; x <= clip_area.x2; x++) {
+        c1 = sgl_max(x - half_width - obj->coords.x1, 0);
+        c2 = sgl_min(x + half_width - obj->coords.x1, scope->column_num - 1);
+        lo = INT16_MAX;
+        hi = INT16_MIN;
+
+        for (int16_t c = c1; c <= c2; c++) {
+            lo = sgl_min(lo, scope->column[2 * c]);
+            hi = sgl_max(hi, scope->column[2 * c + 1]);
         }
 
-        if (x0 == x1 && y0 == y1) break;
-        e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+        if (lo > hi) {
+            continue;
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+
+        lo = sgl_max(lo - half_width, clip_area.y1);
+        hi = sgl_min(hi + half_width, clip_area.y2);
+        buf = sgl_surf_get_buf(surf, x - surf->x1, lo - surf->y1);
+
+        for (int16_t y = lo; y <= hi; y++, buf += surf->w) {
+            *buf = scope->waveform_color;
         }
     }
 }
 
+
 // Oscilloscope drawing callback function
 static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
@@ -209,21 +323,9 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
         int16_t actual_min = display_min;  // Actual min/max of waveform data (for labels)
         int16_t actual_max = display_max;  // Actual max of waveform data (for labels)
         
-        // If auto-scaling is enabled, recalculate min/max from current buffer data
+        // If auto-scaling is enabled, take min/max of current buffer data
         if (scope->auto_scale) {
-            // Recalculate running_min and running_max based on current data in buffer
-            if (scope->display_count > 0) {
-                display_min = scope->data_buffer[0];
-                display_max = scope->data_buffer[0];
-                
-                // Iterate through all data points in buffer to find min/max
-                uint32_t end_index = (scope->display_count < scope->data_len) ? scope->display_count : scope->data_len;
-                for (uint32_t i = 0; i < end_index; i++) {
-                    int16_t val = scope->data_buffer[i];
-                    if (val < display_min) display_min = val;
-                    if (val > display_max) display_max = val;
-                }
-                
+            if (scope_get_minmax(scope, &display_min, &display_max)) {
                 // Save actual data min/max for label display
                 actual_min = display_min;
                 actual_max = display_max;
@@ -240,6 +342,9 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
             display_min = (display_min > INT16_MIN + margin) ? display_min - margin : INT16_MIN;
             display_max = (display_max < INT16_MAX - margin) ? display_max + margin : INT16_MAX;
         }
+
+        scope->drawn_min = actual_min;
+        scope->drawn_max = actual_max;
         
         // Avoid division by zero if min equals max
         if (display_min == display_max) {
@@ -259,7 +364,7 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
         // Draw horizontal center line (midpoint of display range)
         if (scope->grid_style) {
             // Draw dashed line
-            draw_dashed_line(surf, &obj->area, obj->coords.x1, y_center, obj->coords.x2, y_center, scope->grid_style, scope->grid_color);
+            scope_dashed_line(surf, &obj->area, obj->coords.x1, y_center, obj->coords.x2, y_center, scope->grid_style, scope->grid_color);
         } else {
             // Draw solid line
             sgl_draw_fill_hline(surf, &obj->area, y_center, obj->coords.x1, obj->coords.x2, 1, scope->grid_color, scope->alpha);
@@ -268,7 +373,7 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
         // Draw vertical center line
         if (scope->grid_style) {
             // Draw dashed line
-            draw_dashed_line(surf, &obj->area, x_center, obj->coords.y1, x_center, obj->coords.y2, scope->grid_style, scope->grid_color);
+            scope_dashed_line(surf, &obj->area, x_center, obj->coords.y1, x_center, obj->coords.y2, scope->grid_style, scope->grid_color);
         } else {
             // Draw solid line
             sgl_draw_fill_vline(surf, &obj->area, x_center, obj->coords.y1, obj->coords.y2, 1, scope->grid_color, scope->alpha);
@@ -280,7 +385,7 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
 
             if (scope->grid_style) {
                 // Draw dashed line
-                draw_dashed_line(surf, &obj->area, x_pos, obj->coords.y1, x_pos, obj->coords.y2, scope->grid_style, scope->grid_color);
+                scope_dashed_line(surf, &obj->area, x_pos, obj->coords.y1, x_pos, obj->coords.y2, scope->grid_style, scope->grid_color);
             } else {
                 // Draw solid line
                 sgl_draw_fill_vline(surf, &obj->area, x_pos, obj->coords.y1, obj->coords.y2, 1, scope->grid_color, scope->alpha);
@@ -292,51 +397,24 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
             int16_t y_pos = obj->coords.y1 + (height * i / 10); 
             if (scope->grid_style) {
                 // Draw dashed line
-                draw_dashed_line(surf, &obj->area, obj->coords.x1, y_pos, obj->coords.x2, y_pos, scope->grid_style, scope->grid_color);
+                scope_dashed_line(surf, &obj->area, obj->coords.x1, y_pos, obj->coords.x2, y_pos, scope->grid_style, scope->grid_color);
             } else {
                 // Draw solid line
                 sgl_draw_fill_hline(surf, &obj->area, y_pos, obj->coords.x1, obj->coords.x2, 1, scope->grid_color, scope->alpha);
             }
         }
 
-        // Draw waveform data
-        if (scope->display_count > 1) {
-            sgl_pos_t start, end;
-            
-            // Determine number of points to display
-            uint32_t display_points = scope->max_display_points > 0 ? scope->max_display_points : scope->data_len;
-            if (display_points > scope->data_len) display_points = scope->data_len;
-            
-            // Number of actual data points to render
-            uint32_t data_points = scope->display_count < display_points ? scope->display_count : display_points;
-            
-            // Compute index of the most recent data point (rightmost on screen)
-            uint32_t last_index = (scope->current_index == 0) ? scope->data_len - 1 : scope->current_index - 1;
-            int16_t last_value = scope->data_buffer[last_index];
-            
-            // Clamp value to display range
-            if (last_value < display_min) last_value = display_min;
-            if (last_value > display_max) last_value = display_max;
-            
-            start.x = obj->coords.x2;  // Rightmost X position
-            start.y = obj->coords.y2 - ((int32_t)(last_value - display_min) * height) / (display_max - display_min);
-            
-            // Draw waveform from right to left
-            for (uint32_t i = 1; i < data_points; i++) {
-                //int index = (scope->current_index >= i) ? scope->current_index - i : scope->data_len - (i - scope->current_index);
-                uint32_t prev_index = (scope->current_index >= i + 1) ? scope->current_index - (i + 1) : scope->data_len - (i + 1 - scope->current_index);
-
-                int16_t current_value = scope->data_buffer[prev_index];
-
-                // Clamp value to display range
-                current_value = sgl_clamp(current_value, display_min, display_max);
-
-                end.x = obj->coords.x2 - (i * width / (data_points - 1));  // Move leftward
-                end.y = obj->coords.y2 - ((int32_t)(current_value - display_min) * height) / (display_max - display_min);
-
-                custom_draw_line(surf, &obj->area, start, end, scope->waveform_color, scope->line_width);
+        // Draw waveform data, the column spans are built by the first slice of frame
+        if (scope->display_count > 1 && scope->line_width > 0) {
+            if (scope->column == NULL || scope->column_frame != sgl_fbdev_get_frame()) {
+                scope_column_build(scope, display_min, display_max);
+            }
 
-                start = end;
+            if (scope->column) {
+                scope_column_draw(scope, surf);
+            }
+            else {
+                scope_waveform_walk(scope, surf, display_min, display_max);
             }
         }
 
@@ -370,6 +448,10 @@ static void scope_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *ev
                            label_text, scope->y_label_color, scope->alpha, scope->y_label_font);
         }
     }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_free(scope->column);
+        scope->column = NULL;
+    }
 }
 
 
@@ -385,7 +467,7 @@ sgl_obj_t* sgl_scope_create(sgl_obj_t* parent)
     
     sgl_obj_t *obj = &scope->obj;
     sgl_obj_init(obj, parent);
-    obj->construct_fn = scope_construct_cb;
+    sgl_obj_set_construct_fn(obj, scope_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     
     // Initialize default parameters
@@ -423,9 +505,11 @@ void sgl_scope_append_data(sgl_obj_t* obj, int16_t value)
 {
     sgl_scope_t *scope = (sgl_scope_t*)obj;
 
-    // Simply append the data point to the buffer
-    // Min/max will be recalculated during drawing if auto-scale is enabled
-    scope->data_buffer[scope->current_index] = value;
+    uint32_t index = scope->current_index;
+    int16_t min, max;
+
+    // Append the data point to the buffer, only the min/max block of it is rescanned
+    scope->data_buffer[index] = value;
 
     if (sgl_is_pow2(scope->data_len)) {
         scope->current_index = (scope->current_index + 1) & (scope->data_len - 1);
@@ -438,5 +522,27 @@ void sgl_scope_append_data(sgl_obj_t* obj, int16_t value)
         scope->display_count++;
     }
 
-    sgl_obj_set_dirty(obj);
+    if (scope->minmax_valid) {
+        scope_minmax_block_update(scope, index / scope->block_size);
+    }
+
+    // roll mode scrolls all waveform, and a new range of auto scale changes all waveform too
+    if (!scope->sweep || scope->data_len < 2 || (scope->auto_scale && scope_get_minmax(scope, &min, &max)
+                                                   && (min != scope->drawn_min || max != scope->drawn_max))) {
+        sgl_obj_set_dirty(obj);
+        return;
+    }
+
+    // sweep mode, the segments from the previous data to the next one are changed
+    int16_t half_width = scope->line_width / 2;
+    sgl_area_t dirty = {
+        .x1 = scope_sweep_x(scope, index > 0 ? index - 1 : 0) - half_width,
+        .y1 = obj->coords.y1,
+        .x2 = scope_sweep_x(scope, sgl_min(index + 1, scope->data_len - 1)) + half_width,
+        .y2 = obj->coords.y2,
+    };
+
+    if (sgl_area_selfclip(&dirty, &obj->area)) {
+        sgl_obj_update_area(&dirty);
+    }
 }
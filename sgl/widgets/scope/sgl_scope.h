@@ -38,6 +38,10 @@
 extern "C" {
 #endif
 
+/* number of blocks that keep min/max of data buffer for auto scale */
+#define  SGL_SCOPE_MINMAX_BLOCK_NUM        (16)
+
+
 typedef struct {
     sgl_obj_t obj;
     int16_t  *data_buffer;             // channel data buffer
@@ -52,15 +56,25 @@ typedef struct {
     int16_t running_max;               // max value of runtime
     uint8_t auto_scale : 1;            // whether to automatically scale
     uint8_t show_y_labels : 1;         // whether to show Y axis labels
+    uint8_t sweep : 1;                 // sweep mode, new data is drawn at a moving cursor instead of scrolling
+    uint8_t minmax_valid : 1;          // whether block_min and block_max are valid
     uint8_t border_width;              // outer border width
     uint8_t line_width;                // width of waveform line
-    uint8_t display_count;             // data count that has been displayed
+    uint32_t display_count;            // data count that has been displayed
     uint32_t max_display_points;       // max display points
     uint8_t alpha;                     // aplha of waveform
     uint8_t grid_style;                // grid line style（0-solid line，other: dashed line
     const sgl_font_t *y_label_font;    // font of Y axis labels
     sgl_color_t y_label_color;         // color of Y axis labels
     uint32_t current_index;            // current data index
+    uint16_t block_size;               // data count of a min/max block
+    int16_t  block_min[SGL_SCOPE_MINMAX_BLOCK_NUM]; // min value of each block of data buffer
+    int16_t  block_max[SGL_SCOPE_MINMAX_BLOCK_NUM]; // max value of each block of data buffer
+    int16_t  drawn_min;                // min value of data when the scope is drawn last time
+    int16_t  drawn_max;                // max value of data when the scope is drawn last time
+    int16_t  *column;                  // y span of waveform in each column, it is built once per frame
+    int16_t  column_num;               // number of columns
+    uint32_t column_frame;             // frame that column is built
 } sgl_scope_t;
 
 
@@ -83,6 +97,7 @@ static inline void sgl_scope_set_data_buffer(sgl_obj_t* obj, int16_t *data_buffe
     sgl_scope_t *scope = sgl_container_of(obj, sgl_scope_t, obj);
     scope->data_buffer = data_buffer;
     scope->data_len = data_len;
+    scope->minmax_valid = 0;
 }
 
 /**
@@ -283,6 +298,24 @@ static inline void sgl_scope_set_border_width(sgl_obj_t* obj, uint8_t width)
     sgl_obj_set_dirty(obj);
 }
 
+/**
+ * @brief enable/disable sweep mode
+ * @param obj scope object
+ * @param enable true: sweep mode, false: roll mode
+ * @return none
+ * @note in roll mode the newest data is at the right edge and all waveform scrolls left when
+ *       data is appended, so the whole scope is redrawn. In sweep mode the data buffer is shown
+ *       from left to right and the newest data overwrites the oldest at a moving cursor, only
+ *       the columns around the cursor are redrawn, unless auto scale changes the range.
+ *       max_display_points is not used in sweep mode.
+ */
+static inline void sgl_scope_set_sweep_mode(sgl_obj_t* obj, bool enable)
+{
+    sgl_scope_t *scope = sgl_container_of(obj, sgl_scope_t, obj);
+    scope->sweep = (uint8_t)enable;
+    sgl_obj_set_dirty(obj);
+}
+
 /**
  * @brief set scope grid line
  * @param obj scope object
@@ -117,7 +117,7 @@ sgl_obj_t* sgl_slider_create(sgl_obj_t* parent)
     sgl_obj_init(&slider->obj, parent);
     sgl_obj_set_clickable(obj);
     sgl_obj_set_movable(obj);
-    obj->construct_fn = sgl_slider_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_slider_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
 
     slider->direct = SGL_DIRECT_HORIZONTAL;
@@ -94,7 +94,7 @@ sgl_obj_t* sgl_switch_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &p_switch->obj;
     sgl_obj_init(&p_switch->obj, parent);
-    obj->construct_fn = sgl_switch_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_switch_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     sgl_obj_set_radius(obj, SGL_THEME_RADIUS);
 
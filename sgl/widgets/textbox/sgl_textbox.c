@@ -59,10 +59,11 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         area.y2 = obj->coords.y2 - textbox->bg.radius;
 
         sgl_draw_rect(surf, &obj->area, &obj->coords, &textbox->bg);
-        sgl_draw_string_mult_line(surf, &area, area.x1, 
-                                 area.y1 + textbox->y_offset, 
-                                 textbox->text, textbox->text_color, textbox->bg.alpha, textbox->font, textbox->line_margin
-                                 );
+        sgl_text_layout_update(&textbox->layout, textbox->text, textbox->font);
+        sgl_draw_text_layout_mult_line(surf, &area, area.x1, 
+                                      area.y1 + textbox->y_offset, 
+                                      &textbox->layout, textbox->text_color, textbox->bg.alpha, textbox->line_margin
+                                      );
 
         if(textbox->scroll_enable) {
             area.x1 = obj->coords.x2 - SGL_TEXTBOX_SCROLL_WIDTH - textbox->bg.radius;
@@ -77,7 +78,8 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         }
     }
     else if(evt->type == SGL_EVENT_MOVE_UP) {
-        textbox->text_height = sgl_font_get_string_height(width, textbox->text, textbox->font, textbox->line_margin);
+        sgl_text_layout_update(&textbox->layout, textbox->text, textbox->font);
+        textbox->text_height = sgl_text_layout_get_height(&textbox->layout, width, textbox->line_margin);
         textbox->scroll_enable = 1;
         if((textbox->text_height + textbox->y_offset) > height ) {
            textbox->y_offset -= evt->distance;
@@ -85,7 +87,8 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
         sgl_obj_set_dirty(obj);
     }
     else if(evt->type == SGL_EVENT_MOVE_DOWN) {
-        textbox->text_height = sgl_font_get_string_height(width, textbox->text, textbox->font, textbox->line_margin);
+        sgl_text_layout_update(&textbox->layout, textbox->text, textbox->font);
+        textbox->text_height = sgl_text_layout_get_height(&textbox->layout, width, textbox->line_margin);
         textbox->scroll_enable = 1;
         if(textbox->y_offset < 0) {
             textbox->y_offset += evt->distance;
@@ -106,6 +109,9 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
     else if (evt->type == SGL_EVENT_UNFOCUSED) {
         textbox->bg.border --;
     }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&textbox->layout);
+    }
 }
 
 
@@ -127,7 +133,7 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &textbox->obj;
     sgl_obj_init(&textbox->obj, parent);
-    obj->construct_fn = sgl_textbox_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_textbox_construct_cb);
     sgl_obj_set_border_width(obj, SGL_THEME_BORDER_WIDTH);
     obj->focus = 1;
 
@@ -49,6 +49,7 @@ typedef struct sgl_textbox {
     sgl_draw_rect_t  scroll;
     uint32_t         text_height: 31;
     uint32_t         scroll_enable: 1;
+    sgl_text_layout_t layout;
 }sgl_textbox_t;
 
 
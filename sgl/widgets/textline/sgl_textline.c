@@ -39,8 +39,9 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     SGL_ASSERT(textline->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        sgl_obj_set_height(obj, sgl_font_get_string_height(obj->coords.x2 - obj->coords.x1 + 1, textline->text, textline->font, textline->line_margin) + obj->radius * 2);
-        sgl_area_clip(&obj->parent->area, &obj->coords, &obj->area);
+        sgl_text_layout_update(&textline->layout, textline->text, textline->font);
+        sgl_obj_set_height(obj, sgl_text_layout_get_height(&textline->layout, obj->coords.x2 - obj->coords.x1 + 1, textline->line_margin) + obj->radius * 2);
+        sgl_area_clip(&sgl_obj_from_link(obj->parent)->area, &obj->coords, &obj->area);
 
         text_area.x1 = obj->coords.x1 + obj->radius;
         text_area.x2 = obj->coords.x2 - obj->radius;
@@ -51,7 +52,10 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
             sgl_draw_fill_rect(surf, &obj->area, &obj->coords, obj->radius, textline->bg_color, textline->alpha);
         }
 
-        sgl_draw_string_mult_line(surf, &text_area, obj->coords.x1 + obj->radius, obj->coords.y1 + obj->radius, textline->text, textline->color, textline->alpha, textline->font, textline->line_margin);
+        sgl_draw_text_layout_mult_line(surf, &text_area, obj->coords.x1 + obj->radius, obj->coords.y1 + obj->radius, &textline->layout, textline->color, textline->alpha, textline->line_margin);
+    }
+    else if (evt->type == SGL_EVENT_DESTROYED) {
+        sgl_text_layout_free(&textline->layout);
     }
 }
 
@@ -74,7 +78,7 @@ sgl_obj_t* sgl_textline_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &textline->obj;
     sgl_obj_init(&textline->obj, parent);
-    obj->construct_fn = sgl_textline_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_textline_construct_cb);
 
     textline->alpha = SGL_THEME_ALPHA;
     textline->bg_flag = true;
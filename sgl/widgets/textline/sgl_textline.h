@@ -48,6 +48,7 @@ typedef struct sgl_textline {
     uint8_t          edge_margin : 7;
     uint8_t          bg_flag : 1;
     uint8_t          alpha;
+    sgl_text_layout_t layout;
 } sgl_textline_t;
 
 
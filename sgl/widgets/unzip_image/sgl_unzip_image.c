@@ -226,7 +226,7 @@ sgl_obj_t* sgl_unzip_img_create(sgl_obj_t* parent)
     
     sgl_obj_t *obj = &unzip_img->obj;
     sgl_obj_init(obj, parent);
-    obj->construct_fn = sgl_unzip_img_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_unzip_img_construct_cb);
 
     unzip_img->desc.alpha = 255;
     unzip_img->desc.unzip_img = NULL;
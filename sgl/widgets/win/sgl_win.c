@@ -58,6 +58,9 @@ static void sgl_win_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
         
         sgl_draw_fill_circle(surf, &title_bg, close_cx, close_cy, close_r, win->close_color, win->bg.alpha);
     }
+    else if (evt->type == SGL_EVENT_DRAW_OPAQUE) {
+        *(bool*)evt->param = sgl_draw_rect_is_opaque(&win->bg);
+    }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_CLICKED) {
         if (evt->pos.x >= (close_cx - close_r) && evt->pos.x <= (close_cx + close_r) 
              && evt->pos.y >= (close_cy - close_r) && evt->pos.y <= (close_cy + close_r)) {
@@ -84,7 +87,7 @@ sgl_obj_t* sgl_win_create(sgl_obj_t* parent)
 
     sgl_obj_t *obj = &win->obj;
     sgl_obj_init(&win->obj, parent);
-    obj->construct_fn = sgl_win_construct_cb;
+    sgl_obj_set_construct_fn(obj, sgl_win_construct_cb);
     sgl_obj_set_clickable(obj);
 
     win->bg.alpha = SGL_THEME_ALPHA;
@@ -25,7 +25,8 @@
 #define  PANEL_HEIGHT 240
 
 
-sgl_color_t panel_buffer[PANEL_WIDTH * 10];
+/* two buffers of 5 lines, one is drawing while the other is sent by DMA */
+sgl_color_t panel_buffer[2][PANEL_WIDTH * 5];
 
 
 void USART1_GPIO_Config(void) {  
@@ -161,8 +162,9 @@ int main(void)
         .xres = PANEL_WIDTH,
         .yres = PANEL_HEIGHT,
         .flush_area = demo_panel_flush_area,
-        .buffer[0] = panel_buffer,
-        .buffer_size = SGL_ARRAY_SIZE(panel_buffer),
+        .buffer[0] = panel_buffer[0],
+        .buffer[1] = panel_buffer[1],
+        .buffer_size = SGL_ARRAY_SIZE(panel_buffer[0]),
     };
 
 	  sgl_logdev_register(UART1_SendString);
@@ -206,5 +208,10 @@ int main(void)
             sgl_anim_set_auto_free(anim);
             sgl_anim_start(anim, 1);
         }
+
+        /* sleep until the next interrupt if sgl has nothing to do now */
+        if (sgl_task_get_wait() != 0) {
+            __WFI();
+        }
     }
 }
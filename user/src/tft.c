@@ -3,6 +3,7 @@
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_gpio.h"
 #include "stm32f10x_spi.h"
+#include "stm32f10x_dma.h"
 #include "tft.h"
 #include "sgl.h"
 
@@ -126,6 +127,53 @@ void SPI1_WriteMultByte(uint16_t *TxData, uint64_t len)
 		}
 }
 
+#if (TFT_FLUSH_USE_DMA)
+/**
+ * SPI1_TX 使用 DMA1 通道3，传输完成中断里通知 sgl 缓冲区可用
+ */
+static void tft_dma_init(void)
+{
+    DMA_InitTypeDef dmaDef;
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    DMA_DeInit(DMA1_Channel3);
+
+    dmaDef.DMA_PeripheralBaseAddr = (uint32_t)&SPI1->DR;
+    dmaDef.DMA_MemoryBaseAddr = 0;
+    dmaDef.DMA_DIR = DMA_DIR_PeripheralDST;                        // 内存到外设
+    dmaDef.DMA_BufferSize = 1;
+    dmaDef.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dmaDef.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dmaDef.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord; // SPI1_Init_2 为16位帧
+    dmaDef.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    dmaDef.DMA_Mode = DMA_Mode_Normal;
+    dmaDef.DMA_Priority = DMA_Priority_High;
+    dmaDef.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel3, &dmaDef);
+    DMA_ITConfig(DMA1_Channel3, DMA_IT_TC, ENABLE);
+
+    NVIC_SetPriority(DMA1_Channel3_IRQn, NVIC_EncodePriority(2, 1, 0)); // 比TIM2优先级高
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+    SPI_I2S_DMACmd(SPI1, SPI_I2S_DMAReq_Tx, ENABLE);
+}
+
+
+void DMA1_Channel3_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_TC3) != RESET) {
+        DMA_ClearITPendingBit(DMA1_IT_TC3);
+        DMA_Cmd(DMA1_Channel3, DISABLE);
+
+        // DMA完成时最后一个数据还在移位，等待SPI空闲后才能切换DC
+        while (SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_BSY) == SET);
+
+        sgl_fbdev_flush_ready();
+    }
+}
+#endif
+
+
 static void tft_delay(int delay_ms)
 {
     for(volatile int i = 0; i < delay_ms; i++) {
@@ -298,6 +346,10 @@ void tft_init(void)
     }
 
 	SPI1_Init_2();
+
+#if (TFT_FLUSH_USE_DMA)
+    tft_dma_init();
+#endif
 }
 
 void demo_panel_flush_area(sgl_area_t *area, sgl_color_t *src)
@@ -305,7 +357,15 @@ void demo_panel_flush_area(sgl_area_t *area, sgl_color_t *src)
 		const int len = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
 		tft_set_win(area->x1, area->y1, area->x2, area->y2);
 		GPIO_WriteBit(SPI_DC_PORT, SPI_DC_PIN, 1); // 设置PA0为高电平
+
+#if (TFT_FLUSH_USE_DMA)
+    // 启动DMA后立即返回，sgl在另一个缓冲区绘制下一块，完成后在中断里调用sgl_fbdev_flush_ready
+    DMA1_Channel3->CMAR = (uint32_t)src;
+    DMA1_Channel3->CNDTR = len;
+    DMA_Cmd(DMA1_Channel3, ENABLE);
+#else
 		SPI1_WriteMultByte((uint16_t*)src, len);
 		
 		sgl_fbdev_flush_ready();
+#endif
 }
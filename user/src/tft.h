@@ -1,5 +1,8 @@
 #include "sgl.h"
 
+/* 1: 使用DMA异步刷屏，需要在sgl_fbinfo_t中设置两个缓冲区  0: SPI阻塞刷屏 */
+#define TFT_FLUSH_USE_DMA    1
+
 void SPI1_Init(void);
 void tft_init(void);
 void demo_panel_flush_area(sgl_area_t *area, sgl_color_t *src);